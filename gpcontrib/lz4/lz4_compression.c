@@ -0,0 +1,173 @@
+/*---------------------------------------------------------------------
+ *
+ * lz4_compression.c
+ *	  Interfaces to LZ4 compression functionality.
+ *
+ * Level 1 is the fast LZ4 compressor. Levels 2 to 9 use the LZ4HC
+ * compressor at that level, which compresses more slowly but produces the
+ * same format, so decompression is as fast as for level 1.
+ *
+ * IDENTIFICATION
+ *	    gpcontrib/lz4/lz4_compression.c
+ *
+ *---------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "catalog/pg_compression.h"
+#include "fmgr.h"
+#include "utils/builtins.h"
+
+#include <lz4.h>
+#include <lz4hc.h>
+
+Datum		lz4_constructor(PG_FUNCTION_ARGS);
+Datum		lz4_destructor(PG_FUNCTION_ARGS);
+Datum		lz4_compress(PG_FUNCTION_ARGS);
+Datum		lz4_decompress(PG_FUNCTION_ARGS);
+Datum		lz4_validator(PG_FUNCTION_ARGS);
+
+PG_FUNCTION_INFO_V1(lz4_constructor);
+PG_FUNCTION_INFO_V1(lz4_destructor);
+PG_FUNCTION_INFO_V1(lz4_compress);
+PG_FUNCTION_INFO_V1(lz4_decompress);
+PG_FUNCTION_INFO_V1(lz4_validator);
+
+#ifndef UNIT_TESTING
+PG_MODULE_MAGIC;
+#endif
+
+/* Internal state for lz4 */
+typedef struct lz4_state
+{
+	int			level;			/* Compression level */
+	bool		compress;		/* Compress if true, decompress otherwise */
+
+	void	   *scratch;		/* LZ4 or LZ4HC compression state */
+} lz4_state;
+
+Datum
+lz4_constructor(PG_FUNCTION_ARGS)
+{
+	/* PG_GETARG_POINTER(0) is TupleDesc that is currently unused. */
+
+	StorageAttributes *sa = (StorageAttributes *) PG_GETARG_POINTER(1);
+	CompressionState *cs = palloc0(sizeof(CompressionState));
+	lz4_state  *state = palloc0(sizeof(lz4_state));
+	bool		compress = PG_GETARG_BOOL(2);
+
+	if (!PointerIsValid(sa->comptype))
+		elog(ERROR, "lz4_constructor called with no compression type");
+
+	cs->opaque = (void *) state;
+	cs->desired_sz = NULL;
+
+	if (sa->complevel == 0)
+		sa->complevel = 1;
+
+	state->level = sa->complevel;
+	state->compress = compress;
+
+	if (compress)
+	{
+		if (state->level == 1)
+			state->scratch = palloc(LZ4_sizeofState());
+		else
+			state->scratch = palloc(LZ4_sizeofStateHC());
+	}
+
+	PG_RETURN_POINTER(cs);
+}
+
+Datum
+lz4_destructor(PG_FUNCTION_ARGS)
+{
+	CompressionState *cs = (CompressionState *) PG_GETARG_POINTER(0);
+
+	if (cs != NULL && cs->opaque != NULL)
+	{
+		lz4_state  *state = (lz4_state *) cs->opaque;
+
+		if (state->scratch != NULL)
+			pfree(state->scratch);
+		pfree(state);
+	}
+
+	PG_RETURN_VOID();
+}
+
+/*
+ * lz4 compression implementation
+ *
+ * Note that when compression fails due to algorithm inefficiency,
+ * dst_used is set so src_sz, but the output buffer contents are left unchanged
+ */
+Datum
+lz4_compress(PG_FUNCTION_ARGS)
+{
+	const void *src = PG_GETARG_POINTER(0);
+	int32		src_sz = PG_GETARG_INT32(1);
+	void	   *dst = PG_GETARG_POINTER(2);
+	int32		dst_sz = PG_GETARG_INT32(3);
+	int32	   *dst_used = (int32 *) PG_GETARG_POINTER(4);
+	CompressionState *cs = (CompressionState *) PG_GETARG_POINTER(5);
+	lz4_state  *state = (lz4_state *) cs->opaque;
+	int			dst_length_used;
+
+	Assert(state->compress);
+
+	if (state->level == 1)
+		dst_length_used = LZ4_compress_fast_extState(state->scratch,
+													 src, dst,
+													 src_sz, dst_sz,
+													 1);
+	else
+		dst_length_used = LZ4_compress_HC_extStateHC(state->scratch,
+													 src, dst,
+													 src_sz, dst_sz,
+													 state->level);
+
+	/*
+	 * LZ4 returns 0 when the output does not fit in dst, which is how an
+	 * input that does not compress shows up. The caller can detect this by
+	 * checking dst_used >= src_size.
+	 */
+	if (dst_length_used <= 0)
+		dst_length_used = src_sz;
+
+	*dst_used = (int32) dst_length_used;
+
+	PG_RETURN_VOID();
+}
+
+Datum
+lz4_decompress(PG_FUNCTION_ARGS)
+{
+	const void *src = PG_GETARG_POINTER(0);
+	int32		src_sz = PG_GETARG_INT32(1);
+	void	   *dst = PG_GETARG_POINTER(2);
+	int32		dst_sz = PG_GETARG_INT32(3);
+	int32	   *dst_used = (int32 *) PG_GETARG_POINTER(4);
+	int			dst_length_used;
+
+	if (src_sz <= 0)
+		elog(ERROR, "invalid source buffer size %d", src_sz);
+	if (dst_sz <= 0)
+		elog(ERROR, "invalid destination buffer size %d", dst_sz);
+
+	dst_length_used = LZ4_decompress_safe(src, dst, src_sz, dst_sz);
+
+	if (dst_length_used < 0)
+		elog(ERROR, "lz4 decompression failed: corrupt input");
+
+	*dst_used = (int32) dst_length_used;
+
+	PG_RETURN_VOID();
+}
+
+Datum
+lz4_validator(PG_FUNCTION_ARGS)
+{
+	PG_RETURN_VOID();
+}
@@ -0,0 +1,74 @@
+-- Tests for lz4 compression.
+
+-- Check that callbacks are registered
+SELECT * FROM pg_compression WHERE compname = 'lz4';
+CREATE TABLE lz4test (id int4, t text) WITH (appendonly=true, compresstype=lz4, orientation=column);
+
+-- Check that the reloptions on the table shows compression type
+-- This is order sensitive to base on the order that the options were declared in the DDL of the table.
+SELECT reloptions[2] FROM pg_class WHERE relname = 'lz4test';
+
+INSERT INTO lz4test SELECT g, 'foo' || g FROM generate_series(1, 100000) g;
+INSERT INTO lz4test SELECT g, 'bar' || g FROM generate_series(1, 100000) g;
+
+-- Check that we actually compressed data
+SELECT get_ao_compression_ratio('lz4test') > 1;
+
+-- Check contents, at the beginning of the table and at the end.
+SELECT * FROM lz4test ORDER BY (id, t) LIMIT 5;
+SELECT * FROM lz4test ORDER BY (id, t) DESC LIMIT 5;
+
+
+-- Test different compression levels. Levels above 1 use the high
+-- compression variant of LZ4.
+CREATE TABLE lz4test_1 (id int4, t text) WITH (appendonly=true, compresstype=lz4, compresslevel=1);
+CREATE TABLE lz4test_9 (id int4, t text) WITH (appendonly=true, compresstype=lz4, compresslevel=9);
+
+INSERT INTO lz4test_1 SELECT g, 'foo' || g FROM generate_series(1, 10000) g;
+INSERT INTO lz4test_1 SELECT g, 'bar' || g FROM generate_series(1, 10000) g;
+SELECT * FROM lz4test_1 ORDER BY (id, t) LIMIT 5;
+SELECT * FROM lz4test_1 ORDER BY (id, t) DESC LIMIT 5;
+
+INSERT INTO lz4test_9 SELECT g, 'foo' || g FROM generate_series(1, 10000) g;
+INSERT INTO lz4test_9 SELECT g, 'bar' || g FROM generate_series(1, 10000) g;
+SELECT * FROM lz4test_9 ORDER BY (id, t) LIMIT 5;
+SELECT * FROM lz4test_9 ORDER BY (id, t) DESC LIMIT 5;
+
+
+-- Test the bounds of compresslevel. None of these are allowed.
+CREATE TABLE lz4test_invalid (id int4) WITH (appendonly=true, compresstype=lz4, compresslevel=-1);
+CREATE TABLE lz4test_invalid (id int4) WITH (appendonly=true, compresstype=lz4, compresslevel=0);
+CREATE TABLE lz4test_invalid (id int4) WITH (appendonly=true, compresstype=lz4, compresslevel=10);
+
+-- CREATE TABLE for heap table with compresstype=lz4 should fail
+CREATE TABLE lz4test_heap (id int4, t text) WITH (compresstype=lz4);
+
+-- Spill a hash aggregate to LZ4-compressed workfiles
+SET gp_workfile_compression = on;
+SET gp_workfile_compression_type = lz4;
+SET statement_mem = '2MB';
+SET enable_groupagg = off;
+SELECT count(*), sum(n) FROM (SELECT id, t, count(*) AS n FROM lz4test GROUP BY id, t) s;
+
+-- Spill a hash join too, and check from EXPLAIN ANALYZE that it spilled
+-- and that all of its workfiles were compressed
+CREATE FUNCTION lz4_workfiles_compressed(query text) RETURNS SETOF bool AS $$
+DECLARE
+    line text;
+    m text[];
+BEGIN
+    FOR line IN EXECUTE 'EXPLAIN ANALYZE ' || query LOOP
+        m := regexp_matches(line, 'Work file set: (\d+) files \((\d+) compressed\)');
+        IF m IS NOT NULL THEN
+            RETURN NEXT m[1]::int > 0 AND m[1] = m[2];
+        END IF;
+    END LOOP;
+END;
+$$ LANGUAGE plpgsql;
+SELECT count(*) FROM lz4test a JOIN lz4test b USING (id, t);
+SELECT DISTINCT * FROM lz4_workfiles_compressed('SELECT count(*) FROM lz4test a JOIN lz4test b USING (id, t)') AS all_compressed;
+DROP FUNCTION lz4_workfiles_compressed(text);
+RESET enable_groupagg;
+RESET statement_mem;
+RESET gp_workfile_compression_type;
+RESET gp_workfile_compression;
\ No newline at end of file
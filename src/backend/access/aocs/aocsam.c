@@ -22,6 +22,7 @@
 #include "access/appendonlywriter.h"
 #include "access/heapam.h"
 #include "access/hio.h"
+#include "access/nbtree.h"
 #include "access/xact.h"
 #include "catalog/catalog.h"
 #include "catalog/gp_fastsequence.h"
@@ -37,18 +38,27 @@
 #include "cdb/cdbvars.h"
 #include "fmgr.h"
 #include "miscadmin.h"
+#include "nodes/nodeFuncs.h"
 #include "pgstat.h"
 #include "storage/procarray.h"
 #include "storage/smgr.h"
+#include "utils/array.h"
 #include "utils/datumstream.h"
 #include "utils/faultinjector.h"
 #include "utils/guc.h"
 #include "utils/inval.h"
 #include "utils/lsyscache.h"
+#include "utils/memutils.h"
 #include "utils/relcache.h"
 #include "utils/snapmgr.h"
 #include "utils/syscache.h"
+#include "utils/typcache.h"
 
+/* GUC: evaluate the quals of AOCS scans before reading the other columns */
+bool		gp_aocs_late_materialization = false;
+
+/* GUC: decode the rows of AOCS sequential scans in batches */
+bool		gp_aocs_batch_scan = false;
 
 static AOCSScanDesc aocs_beginscan_internal(Relation relation,
 						AOCSFileSegInfo **seginfo,
@@ -56,6 +66,7 @@ static AOCSScanDesc aocs_beginscan_internal(Relation relation,
 						Snapshot snapshot,
 						Snapshot appendOnlyMetaDataSnapshot,
 						TupleDesc relationTupleDesc, bool *proj);
+static void free_batch(AOCSScanDesc scan);
 
 /*
  * Open the segment file for a specified column associated with the datum
@@ -240,8 +251,11 @@ open_ds_read(Relation rel, DatumStreamRead **ds, TupleDesc relationTupleDesc,
 	pfree(opts);
 }
 
+/*
+ * Destroy the data streams, adding their I/O statistics to ioStats.
+ */
 static void
-close_ds_read(DatumStreamRead **ds, int nvp)
+close_ds_read(DatumStreamRead **ds, int nvp, BufferedReadStats *ioStats)
 {
 	int			i;
 
@@ -249,6 +263,7 @@ close_ds_read(DatumStreamRead **ds, int nvp)
 	{
 		if (ds[i])
 		{
+			BufferedReadAccumStats(ioStats, &ds[i]->ao_read.bufferedRead);
 			destroy_datumstreamread(ds[i]);
 			ds[i] = NULL;
 		}
@@ -271,6 +286,26 @@ close_ds_write(DatumStreamWrite **ds, int nvp)
 }
 
 
+/*
+ * Pass the dictionary scan keys of the projected columns to their data
+ * streams.
+ */
+static void
+set_ds_dictionary_keys(AOCSScanDesc scan)
+{
+	int			i;
+
+	for (i = 0; i < scan->num_proj_atts; i++)
+	{
+		int			attno = scan->proj_atts[i];
+
+		if (scan->num_dict_keys[attno] > 0)
+			datumstreamread_set_dictionary_keys(scan->ds[attno],
+												scan->num_dict_keys[attno],
+												scan->dict_keys[attno]);
+	}
+}
+
 static void
 aocs_initscan(AOCSScanDesc scan)
 {
@@ -279,13 +314,202 @@ aocs_initscan(AOCSScanDesc scan)
 	ItemPointerSet(&scan->cdb_fake_ctid, 0, 0);
 	scan->cur_seg_row = 0;
 
+	if (scan->batch)
+	{
+		scan->batch->nrows = 0;
+		scan->batch->next = 0;
+	}
+
 	open_ds_read(scan->aos_rel, scan->ds, scan->relationTupleDesc,
 				 scan->proj_atts, scan->num_proj_atts,
 				 scan->aos_rel->rd_appendonly->checksum);
 
+	if (scan->dict_keys)
+		set_ds_dictionary_keys(scan);
+
 	pgstat_count_heap_scan(scan->aos_rel);
 }
 
+/*
+ * Free the zone map excluded row ranges of the current segment file, if any.
+ */
+static void
+free_excluded_ranges(AOCSScanDesc scan)
+{
+	if (scan->excluded_ranges)
+		pfree(scan->excluded_ranges);
+	scan->excluded_ranges = NULL;
+	scan->num_excluded_ranges = 0;
+	scan->next_excluded_range = 0;
+}
+
+static int
+compare_excluded_ranges(const void *a, const void *b)
+{
+	const AppendOnlyBlockDirectoryEntry *ra = a;
+	const AppendOnlyBlockDirectoryEntry *rb = b;
+
+	if (ra->range.firstRowNum < rb->range.firstRowNum)
+		return -1;
+	if (ra->range.firstRowNum > rb->range.firstRowNum)
+		return 1;
+	return 0;
+}
+
+/*
+ * Find the row ranges of the given segment file that the zone maps of the
+ * key columns exclude. A row is excluded if the zone map of any of the key
+ * columns excludes it, so the ranges of the columns are united.
+ */
+static void
+load_excluded_ranges(AOCSScanDesc scan, AOCSFileSegInfo *segInfo)
+{
+	AppendOnlyBlockDirectoryEntry *ranges = NULL;
+	int			nranges = 0;
+	MemoryContext oldcxt;
+	int			i;
+	int			j;
+
+	free_excluded_ranges(scan);
+
+	if (scan->num_zonemap_keys == 0 || scan->blockDirectory != NULL)
+		return;
+
+	oldcxt = MemoryContextSwitchTo(GetMemoryChunkContext(scan));
+
+	for (i = 0; i < scan->num_zonemap_keys; i++)
+	{
+		int			attno = scan->zonemap_keys[i].sk_attno - 1;
+		AOCSVPInfoEntry *e;
+		AppendOnlyBlockDirectoryEntry *colRanges;
+		int			ncolRanges;
+
+		/* Each column only once */
+		for (j = 0; j < i; j++)
+		{
+			if (scan->zonemap_keys[j].sk_attno == attno + 1)
+				break;
+		}
+		if (j < i)
+			continue;
+
+		if (attno >= segInfo->vpinfo.nEntry)
+			continue;
+		e = getAOCSVPEntry(segInfo, attno);
+
+		colRanges = AppendOnlyBlockDirectory_GetExcludedRanges(scan->aos_rel,
+															   scan->appendOnlyMetaDataSnapshot,
+															   segInfo->segno,
+															   attno,
+															   e->eof,
+															   scan->num_zonemap_keys,
+															   scan->zonemap_keys,
+															   &ncolRanges);
+		if (ncolRanges == 0)
+			continue;
+
+		if (ranges == NULL)
+		{
+			ranges = colRanges;
+			nranges = ncolRanges;
+		}
+		else
+		{
+			ranges = repalloc(ranges, (nranges + ncolRanges) *
+							  sizeof(AppendOnlyBlockDirectoryEntry));
+			memcpy(&ranges[nranges], colRanges,
+				   ncolRanges * sizeof(AppendOnlyBlockDirectoryEntry));
+			nranges += ncolRanges;
+			pfree(colRanges);
+		}
+	}
+
+	MemoryContextSwitchTo(oldcxt);
+
+	if (nranges == 0)
+		return;
+
+	/* Sort the ranges by row number, and merge the overlapping ones */
+	qsort(ranges, nranges, sizeof(AppendOnlyBlockDirectoryEntry),
+		  compare_excluded_ranges);
+	j = 0;
+	for (i = 1; i < nranges; i++)
+	{
+		if (ranges[i].range.firstRowNum - 1 <= ranges[j].range.lastRowNum)
+		{
+			if (ranges[i].range.lastRowNum > ranges[j].range.lastRowNum)
+				ranges[j].range.lastRowNum = ranges[i].range.lastRowNum;
+		}
+		else
+			ranges[++j] = ranges[i];
+	}
+
+	scan->excluded_ranges = ranges;
+	scan->num_excluded_ranges = j + 1;
+}
+
+/*
+ * Is the given row of the current segment file within one of the row ranges
+ * the zone maps exclude? If so, return the last row of the range in
+ * *lastRowNum.
+ *
+ * The rows are visited in row number order, so the ranges are walked with a
+ * cursor.
+ */
+static bool
+row_excluded_by_zonemap(AOCSScanDesc scan, int64 rowNum, int64 *lastRowNum)
+{
+	while (scan->next_excluded_range < scan->num_excluded_ranges)
+	{
+		AppendOnlyBlockDirectoryEntry *range =
+		&scan->excluded_ranges[scan->next_excluded_range];
+
+		if (rowNum < range->range.firstRowNum)
+			return false;
+		if (rowNum <= range->range.lastRowNum)
+		{
+			*lastRowNum = range->range.lastRowNum;
+			return true;
+		}
+		scan->next_excluded_range++;
+	}
+
+	return false;
+}
+
+/*
+ * Do the dictionary scan keys prove that the current row, which all the
+ * given columns are positioned to, does not satisfy them? If they also prove
+ * it for the rest of the current block of one of the columns, return the
+ * last row of that block in *lastRowNum, otherwise -1.
+ */
+static bool
+row_excluded_by_dictionary(AOCSScanDesc scan, int *read_atts,
+						   int num_read_atts, int64 *lastRowNum)
+{
+	int			i;
+
+	for (i = 0; i < num_read_atts; i++)
+	{
+		DatumStreamRead *ds = scan->ds[read_atts[i]];
+
+		if (datumstreamread_dictionary_excludes_block(ds))
+		{
+			*lastRowNum = ds->blockFirstRowNum + ds->blockRowCount - 1;
+			return true;
+		}
+	}
+
+	*lastRowNum = INT64CONST(-1);
+	for (i = 0; i < num_read_atts; i++)
+	{
+		if (datumstreamread_dictionary_excludes_row(scan->ds[read_atts[i]]))
+			return true;
+	}
+
+	return false;
+}
+
 static int
 open_next_scan_seg(AOCSScanDesc scan)
 {
@@ -362,6 +586,22 @@ open_next_scan_seg(AOCSScanDesc scan)
 												  scan->num_proj_atts,
 												  scan->blockDirectory);
 
+				load_excluded_ranges(scan, curSegInfo);
+
+				/*
+				 * Segment files of older formats are read eagerly: their
+				 * blocks may lack the first row number in the header, and
+				 * then the row numbers are inferred by counting the rows of
+				 * every block, which does not work for the columns that
+				 * late materialization leaves behind. Neither is it used
+				 * while building the block directory, which needs to see
+				 * every block of every column.
+				 */
+				scan->late_materialize =
+					(scan->num_lazy_atts > 0 &&
+					 scan->blockDirectory == NULL &&
+					 curSegInfo->formatversion == AORelationVersion_GetLatest());
+
 				return scan->cur_seg;
 			}
 		}
@@ -539,7 +779,7 @@ aocs_afterscan(AOCSScanDesc scan)
 		}
 	}
 
-	close_ds_read(scan->ds, scan->relationTupleDesc->natts);
+	close_ds_read(scan->ds, scan->relationTupleDesc->natts, &scan->ioStats);
 }
 
 void
@@ -549,6 +789,26 @@ aocs_rescan(AOCSScanDesc scan)
 	aocs_initscan(scan);
 }
 
+/*
+ * Return the I/O statistics of the scan so far, for EXPLAIN ANALYZE.
+ */
+void
+aocs_get_io_stats(AOCSScanDesc scan, BufferedReadStats *stats)
+{
+	int			i;
+
+	*stats = scan->ioStats;
+
+	if (scan->ds == NULL)
+		return;
+
+	for (i = 0; i < scan->relationTupleDesc->natts; i++)
+	{
+		if (scan->ds[i])
+			BufferedReadAccumStats(stats, &scan->ds[i]->ao_read.bufferedRead);
+	}
+}
+
 void
 aocs_endscan(AOCSScanDesc scan)
 {
@@ -557,7 +817,7 @@ aocs_endscan(AOCSScanDesc scan)
 	RelationDecrementReferenceCount(scan->aos_rel);
 
 	close_cur_scan_seg(scan);
-	close_ds_read(scan->ds, scan->relationTupleDesc->natts);
+	close_ds_read(scan->ds, scan->relationTupleDesc->natts, &scan->ioStats);
 
 	pfree(scan->proj_atts);
 	scan->proj_atts = NULL;
@@ -578,11 +838,436 @@ aocs_endscan(AOCSScanDesc scan)
 		scan->seginfo = NULL;
 	}
 
+	free_excluded_ranges(scan);
+	if (scan->zonemap_keys)
+		pfree(scan->zonemap_keys);
+	if (scan->dict_keys)
+	{
+		for (i = 0; i < scan->relationTupleDesc->natts; i++)
+		{
+			if (scan->dict_keys[i])
+				pfree(scan->dict_keys[i]);
+		}
+		pfree(scan->dict_keys);
+		pfree(scan->num_dict_keys);
+	}
+	if (scan->filter_atts)
+		pfree(scan->filter_atts);
+	if (scan->lazy_atts)
+		pfree(scan->lazy_atts);
+	if (scan->batch)
+		free_batch(scan);
+
 	AppendOnlyVisimap_Finish(&scan->visibilityMap, AccessShareLock);
 
 	pfree(scan);
 }
 
+/*
+ * Set the zone map scan keys of the scan, built with
+ * AppendOnlyZoneMap_BuildScanKeys(). The rows that the zone maps of the key
+ * columns prove not to satisfy all of the keys are skipped, without reading
+ * the blocks that only contain such rows. The rows returned are not checked
+ * against the keys; the caller still has to evaluate its quals. Must be
+ * called before the first tuple is fetched.
+ */
+void
+aocs_set_zonemap_keys(AOCSScanDesc scan, int nkeys, ScanKey keys)
+{
+	Assert(scan->excluded_ranges == NULL);
+
+	scan->num_zonemap_keys = nkeys;
+	scan->zonemap_keys = keys;
+}
+
+/*
+ * Is the node a variable-length column of the scan, possibly relabeled to
+ * a binary compatible type? If so, return the column, and the type its
+ * values are compared as in *type.
+ */
+static Var *
+dictionary_qual_var(AOCSScanDesc scan, Node *node, Oid *type)
+{
+	Var		   *var;
+	Form_pg_attribute attr;
+
+	if (node == NULL)
+		return NULL;
+
+	*type = exprType(node);
+	if (IsA(node, RelabelType))
+		node = (Node *) ((RelabelType *) node)->arg;
+
+	if (!IsA(node, Var))
+		return NULL;
+
+	var = (Var *) node;
+	if (var->varlevelsup != 0 || var->varattno <= 0 ||
+		var->varattno > scan->relationTupleDesc->natts)
+		return NULL;
+
+	attr = scan->relationTupleDesc->attrs[var->varattno - 1];
+	if (attr->attisdropped || attr->attlen != -1 ||
+		var->vartype != attr->atttypid)
+		return NULL;
+
+	return var;
+}
+
+/*
+ * Build the dictionary scan key of a qual of the form "column op constant"
+ * (or commuted), or "column op ANY (array constant)", where op is a btree
+ * comparison operator of the default operator family of the type the
+ * column is compared as. Returns false if the qual is of another form.
+ */
+static bool
+build_dictionary_key(AOCSScanDesc scan, Node *qual, int *attno,
+					 DatumStreamDictionaryKey *key)
+{
+	Node	   *leftop;
+	Node	   *rightop;
+	Oid			opno;
+	Oid			inputcollid;
+	bool		isArray;
+	Var		   *var;
+	Const	   *con;
+	Oid			type;
+	Oid			consttype;
+	TypeCacheEntry *typentry;
+	int			strategy;
+	Oid			lefttype;
+	Oid			righttype;
+
+	if (IsA(qual, OpExpr) && list_length(((OpExpr *) qual)->args) == 2)
+	{
+		OpExpr	   *opexpr = (OpExpr *) qual;
+
+		leftop = (Node *) linitial(opexpr->args);
+		rightop = (Node *) lsecond(opexpr->args);
+		opno = opexpr->opno;
+		inputcollid = opexpr->inputcollid;
+		isArray = false;
+
+		if ((var = dictionary_qual_var(scan, leftop, &type)) != NULL &&
+			IsA(rightop, Const))
+			con = (Const *) rightop;
+		else if ((var = dictionary_qual_var(scan, rightop, &type)) != NULL &&
+				 IsA(leftop, Const))
+		{
+			con = (Const *) leftop;
+			opno = get_commutator(opno);
+			if (!OidIsValid(opno))
+				return false;
+		}
+		else
+			return false;
+	}
+	else if (IsA(qual, ScalarArrayOpExpr) &&
+			 ((ScalarArrayOpExpr *) qual)->useOr &&
+			 list_length(((ScalarArrayOpExpr *) qual)->args) == 2)
+	{
+		ScalarArrayOpExpr *saop = (ScalarArrayOpExpr *) qual;
+
+		leftop = (Node *) linitial(saop->args);
+		rightop = (Node *) lsecond(saop->args);
+		opno = saop->opno;
+		inputcollid = saop->inputcollid;
+		isArray = true;
+
+		if ((var = dictionary_qual_var(scan, leftop, &type)) == NULL ||
+			!IsA(rightop, Const))
+			return false;
+		con = (Const *) rightop;
+	}
+	else
+		return false;
+
+	if (con->constisnull)
+		return false;
+
+	consttype = isArray ? get_element_type(con->consttype) : con->consttype;
+	if (consttype != type)
+		return false;
+
+	typentry = lookup_type_cache(type,
+								 TYPECACHE_BTREE_OPFAMILY |
+								 TYPECACHE_CMP_PROC_FINFO);
+	if (!OidIsValid(typentry->btree_opf) ||
+		!OidIsValid(typentry->cmp_proc_finfo.fn_oid) ||
+		!op_in_opfamily(opno, typentry->btree_opf))
+		return false;
+
+	get_op_opfamily_properties(opno, typentry->btree_opf, false,
+							   &strategy, &lefttype, &righttype);
+	if (lefttype != type || righttype != type)
+		return false;
+
+	key->strategy = strategy;
+	fmgr_info_copy(&key->cmpProc, &typentry->cmp_proc_finfo,
+				   CurrentMemoryContext);
+	key->collation = inputcollid;
+
+	if (!isArray)
+	{
+		key->nvalues = 1;
+		key->values = palloc(sizeof(Datum));
+		key->values[0] = con->constvalue;
+	}
+	else
+	{
+		Datum	   *elems;
+		bool	   *nulls;
+		int			nelems;
+		int16		typlen;
+		bool		typbyval;
+		char		typalign;
+		int			i;
+
+		get_typlenbyvalalign(type, &typlen, &typbyval, &typalign);
+		deconstruct_array(DatumGetArrayTypeP(con->constvalue), type,
+						  typlen, typbyval, typalign,
+						  &elems, &nulls, &nelems);
+
+		/* A NULL element never makes the qual true */
+		key->nvalues = 0;
+		key->values = elems;
+		for (i = 0; i < nelems; i++)
+		{
+			if (!nulls[i])
+				key->values[key->nvalues++] = elems[i];
+		}
+		pfree(nulls);
+	}
+
+	*attno = var->varattno - 1;
+	return true;
+}
+
+/*
+ * Set the dictionary scan keys of the scan, built from those of the given
+ * quals that compare a variable-length column with constants; the other
+ * quals are ignored. In the dictionary encoded blocks of the key columns,
+ * see gp_aocs_dictionary_encoding, the keys are evaluated once per distinct
+ * value, and the rows that do not satisfy them are skipped, along with the
+ * blocks in which no value does. The rows returned are not checked against
+ * the keys; the caller still has to evaluate its quals. Must be called
+ * before the first tuple is fetched.
+ */
+void
+aocs_set_dictionary_quals(AOCSScanDesc scan, List *quals)
+{
+	int			nvp = scan->relationTupleDesc->natts;
+	DatumStreamDictionaryKey key;
+	ListCell   *lc;
+	int			attno;
+
+	Assert(scan->cur_seg < 0);
+	Assert(scan->dict_keys == NULL);
+
+	foreach(lc, quals)
+	{
+		if (!build_dictionary_key(scan, (Node *) lfirst(lc), &attno, &key))
+			continue;
+
+		if (scan->dict_keys == NULL)
+		{
+			scan->num_dict_keys = palloc0(nvp * sizeof(int));
+			scan->dict_keys = palloc0(nvp * sizeof(DatumStreamDictionaryKey *));
+		}
+		if (scan->dict_keys[attno] == NULL)
+			scan->dict_keys[attno] =
+				palloc(list_length(quals) * sizeof(DatumStreamDictionaryKey));
+
+		scan->dict_keys[attno][scan->num_dict_keys[attno]++] = key;
+	}
+
+	if (scan->dict_keys)
+		set_ds_dictionary_keys(scan);
+}
+
+/*
+ * Enable late materialization for the scan. 'filter_proj' marks the columns
+ * that the filters need to decide whether a row qualifies. For every row, only
+ * those columns are read before the filters are called; the other projected
+ * columns are read only for the rows they accept, and the blocks of theirs
+ * that hold no accepted row are not read at all. The rows that the filters
+ * reject are not returned.
+ *
+ * 'batch_filter' is only called in batch mode, see aocs_set_batch_mode(),
+ * on every batch before its rows are passed to 'filter'. Either filter may
+ * be NULL. Must be called before the first tuple is fetched.
+ *
+ * Returns false, leaving the scan unchanged, if there is no batch filter and
+ * the row filter needs all the projected columns anyway.
+ */
+bool
+aocs_set_filter(AOCSScanDesc scan, bool *filter_proj,
+				AOCSScanFilter filter, AOCSBatchFilter batch_filter, void *arg)
+{
+	bool		any_filter_att = false;
+	int			i;
+
+	Assert(scan->cur_seg < 0);
+
+	for (i = 0; i < scan->num_proj_atts; i++)
+	{
+		if (filter_proj[scan->proj_atts[i]])
+			any_filter_att = true;
+	}
+
+	scan->filter_atts = palloc(scan->num_proj_atts * sizeof(int));
+	scan->lazy_atts = palloc(scan->num_proj_atts * sizeof(int));
+	scan->num_filter_atts = 0;
+	scan->num_lazy_atts = 0;
+
+	for (i = 0; i < scan->num_proj_atts; i++)
+	{
+		int			attno = scan->proj_atts[i];
+
+		/*
+		 * If the filter needs none of the columns, the first projected
+		 * column is still read for every row, to drive the scan.
+		 */
+		if (filter_proj[attno] || (!any_filter_att && i == 0))
+			scan->filter_atts[scan->num_filter_atts++] = attno;
+		else
+			scan->lazy_atts[scan->num_lazy_atts++] = attno;
+	}
+
+	Assert(batch_filter == NULL || scan->batch != NULL);
+
+	if (scan->num_lazy_atts == 0 && batch_filter == NULL)
+	{
+		pfree(scan->filter_atts);
+		pfree(scan->lazy_atts);
+		scan->filter_atts = NULL;
+		scan->lazy_atts = NULL;
+		scan->num_filter_atts = 0;
+		return false;
+	}
+
+	scan->filter = filter;
+	scan->batch_filter = batch_filter;
+	scan->filter_arg = arg;
+
+	return true;
+}
+
+/*
+ * Put the scan in batch mode. Instead of advancing all the columns for each
+ * row, the scan then decodes up to AOCS_BATCH_SIZE rows of one column after
+ * the other into column vectors, checks their visibility together, and
+ * returns the rows from the vectors. Must be called before the first tuple
+ * is fetched, and before aocs_set_filter().
+ *
+ * Returns false, leaving the scan unchanged, if some segment file is of an
+ * older format, whose values may need to be upgraded one at a time.
+ */
+bool
+aocs_set_batch_mode(AOCSScanDesc scan)
+{
+	AOCSScanBatch *batch;
+	int			nvp = scan->relationTupleDesc->natts;
+	int			i;
+
+	Assert(scan->cur_seg < 0);
+	Assert(scan->blockDirectory == NULL);
+
+	for (i = 0; i < scan->total_seg; i++)
+	{
+		if (scan->seginfo[i]->formatversion != AORelationVersion_GetLatest())
+			return false;
+	}
+
+	batch = palloc0(sizeof(AOCSScanBatch));
+	batch->values = palloc0(nvp * sizeof(Datum *));
+	batch->isnull = palloc0(nvp * sizeof(bool *));
+	for (i = 0; i < scan->num_proj_atts; i++)
+	{
+		int			attno = scan->proj_atts[i];
+
+		batch->values[attno] = palloc(AOCS_BATCH_SIZE * sizeof(Datum));
+		batch->isnull[attno] = palloc(AOCS_BATCH_SIZE * sizeof(bool));
+	}
+	batch->selected = palloc(AOCS_BATCH_SIZE * sizeof(bool));
+
+	scan->batch = batch;
+
+	return true;
+}
+
+static void
+free_batch(AOCSScanDesc scan)
+{
+	AOCSScanBatch *batch = scan->batch;
+	int			i;
+
+	for (i = 0; i < scan->num_proj_atts; i++)
+	{
+		int			attno = scan->proj_atts[i];
+
+		pfree(batch->values[attno]);
+		pfree(batch->isnull[attno]);
+	}
+	pfree(batch->values);
+	pfree(batch->isnull);
+	pfree(batch->selected);
+	pfree(batch);
+
+	scan->batch = NULL;
+}
+
+/*
+ * Read the columns that late materialization left behind, for the given row
+ * of the current segment file that the filter accepted. Their datum streams
+ * may still be positioned at an earlier row; the rows in between are skipped
+ * without being decoded, and the blocks in between without being read.
+ */
+static void
+read_lazy_columns(AOCSScanDesc scan, int64 rowNum, Datum *d, bool *null)
+{
+	int			i;
+
+	for (i = 0; i < scan->num_lazy_atts; i++)
+	{
+		int			attno = scan->lazy_atts[i];
+		DatumStreamRead *ds = scan->ds[attno];
+		int			err;
+
+		if (ds->blockFirstRowNum + ds->blockRowCount - 1 -
+			datumstreamread_rows_left(ds) < rowNum - 1)
+		{
+			err = datumstreamread_skip_rows(ds, rowNum - 1);
+			if (err < 0)
+				elog(ERROR, "unexpected end of column #%d of segment file %d of relation \"%s\" at row " INT64_FORMAT,
+					 attno + 1,
+					 scan->seginfo[scan->cur_seg]->segno,
+					 RelationGetRelationName(scan->aos_rel),
+					 rowNum);
+			scan->late_mat_skipped_blocks += err;
+		}
+
+		err = datumstreamread_advance(ds);
+		Assert(err >= 0);
+		if (err == 0)
+		{
+			err = datumstreamread_block(ds, NULL, attno);
+			if (err < 0)
+				elog(ERROR, "unexpected end of column #%d of segment file %d of relation \"%s\" at row " INT64_FORMAT,
+					 attno + 1,
+					 scan->seginfo[scan->cur_seg]->segno,
+					 RelationGetRelationName(scan->aos_rel),
+					 rowNum);
+
+			err = datumstreamread_advance(ds);
+			Assert(err > 0);
+		}
+		Assert(ds->blockFirstRowNum + datumstreamread_nth(ds) == rowNum);
+
+		datumstreamread_get(ds, &d[attno], &null[attno]);
+	}
+}
+
 /*
  * Upgrades a Datum value from a previous version of the AOCS page format. The
  * DatumStreamRead that is passed must correspond to the column being upgraded.
@@ -657,6 +1342,259 @@ static void upgrade_datum_fetch(AOCSFetchDesc fetch, int attno, Datum values[],
 					   values, isnull, formatversion);
 }
 
+/*
+ * Decode the next batch of rows of the current segment file into the column
+ * vectors of scan->batch, and select the rows that are visible and that the
+ * batch filter accepts. A batch ends where the current block of any of the
+ * columns ends, so that the values of pass-by-reference types that point
+ * into the blocks stay valid until the batch has been returned.
+ *
+ * Returns false at the end of the segment file.
+ */
+static bool
+fill_batch(AOCSScanDesc scan)
+{
+	AOCSScanBatch *batch = scan->batch;
+	AOCSFileSegInfo *curseginfo = scan->seginfo[scan->cur_seg];
+	bool		isSnapshotAny = (scan->snapshot == SnapshotAny);
+	int		   *read_atts;
+	int			num_read_atts;
+	int			nrows;
+	int64		firstRowNum;
+	int64		lastRowNum;
+	int			i;
+	int			k;
+
+	if (scan->late_materialize)
+	{
+		read_atts = scan->filter_atts;
+		num_read_atts = scan->num_filter_atts;
+	}
+	else
+	{
+		read_atts = scan->proj_atts;
+		num_read_atts = scan->num_proj_atts;
+	}
+
+	for (;;)
+	{
+		DatumStreamRead *ds;
+
+		nrows = AOCS_BATCH_SIZE;
+		for (i = 0; i < num_read_atts; i++)
+		{
+			int			attno = read_atts[i];
+
+			ds = scan->ds[attno];
+			while (datumstreamread_rows_left(ds) == 0)
+			{
+				if (datumstreamread_block(ds, NULL, attno) < 0)
+					return false;
+			}
+			nrows = Min(nrows, datumstreamread_rows_left(ds));
+		}
+
+		ds = scan->ds[read_atts[0]];
+		firstRowNum = ds->blockFirstRowNum + ds->blockRowCount -
+			datumstreamread_rows_left(ds);
+
+		/*
+		 * If the zone maps prove that no row up to some later row can
+		 * satisfy the quals, skip ahead on all the columns.
+		 */
+		if (scan->num_excluded_ranges > 0 &&
+			row_excluded_by_zonemap(scan, firstRowNum, &lastRowNum))
+		{
+			scan->zonemap_skipped_rows += lastRowNum - firstRowNum + 1;
+			for (i = 0; i < num_read_atts; i++)
+			{
+				if (datumstreamread_skip_rows(scan->ds[read_atts[i]],
+											  lastRowNum) < 0)
+					return false;
+			}
+			continue;
+		}
+
+		/*
+		 * Likewise if the dictionary scan keys prove that no row of the
+		 * current block of some column qualifies.
+		 */
+		if (scan->dict_keys != NULL)
+		{
+			lastRowNum = INT64CONST(-1);
+			for (i = 0; i < num_read_atts; i++)
+			{
+				ds = scan->ds[read_atts[i]];
+				if (datumstreamread_dictionary_excludes_block(ds))
+				{
+					lastRowNum = ds->blockFirstRowNum + ds->blockRowCount - 1;
+					break;
+				}
+			}
+
+			if (lastRowNum >= 0)
+			{
+				for (i = 0; i < num_read_atts; i++)
+				{
+					if (datumstreamread_skip_rows(scan->ds[read_atts[i]],
+												  lastRowNum) < 0)
+						return false;
+				}
+				continue;
+			}
+		}
+
+		break;
+	}
+
+	for (k = 0; k < nrows; k++)
+		batch->selected[k] = true;
+
+	/*
+	 * Decode the rows, one column at a time, deselecting the rows that the
+	 * dictionary scan keys exclude.
+	 */
+	for (i = 0; i < num_read_atts; i++)
+	{
+		int			attno = read_atts[i];
+		DatumStreamRead *ds = scan->ds[attno];
+		Datum	   *values = batch->values[attno];
+		bool	   *isnull = batch->isnull[attno];
+
+		for (k = 0; k < nrows; k++)
+		{
+			int			err PG_USED_FOR_ASSERTS_ONLY;
+
+			err = datumstreamread_advance(ds);
+			Assert(err > 0);
+			datumstreamread_get(ds, &values[k], &isnull[k]);
+			if (datumstreamread_dictionary_excludes_row(ds))
+				batch->selected[k] = false;
+		}
+		Assert(ds->blockFirstRowNum + datumstreamread_nth(ds) ==
+			   firstRowNum + nrows - 1);
+	}
+
+	/*
+	 * Deselect the rows that are deleted, or that fall into a range that the
+	 * zone maps exclude.
+	 */
+	for (k = 0; k < nrows; k++)
+	{
+		int64		rowNum = firstRowNum + k;
+		AOTupleId	aoTupleId;
+
+		if (!batch->selected[k])
+			continue;
+
+		if (scan->num_excluded_ranges > 0 &&
+			row_excluded_by_zonemap(scan, rowNum, &lastRowNum))
+		{
+			scan->zonemap_skipped_rows++;
+			batch->selected[k] = false;
+			continue;
+		}
+
+		AOTupleIdInit(&aoTupleId, curseginfo->segno, rowNum);
+		batch->selected[k] = (isSnapshotAny ||
+							  AppendOnlyVisimap_IsVisible(&scan->visibilityMap,
+														  &aoTupleId));
+	}
+
+	scan->cur_seg_row += nrows;
+	scan->batch_rows += nrows;
+	batch->nrows = nrows;
+	batch->next = 0;
+	batch->firstRowNum = firstRowNum;
+
+	if (scan->batch_filter)
+		scan->batch_filter(scan->filter_arg, batch);
+
+	return true;
+}
+
+/*
+ * aocs_getnext() of a scan in batch mode.
+ */
+static bool
+aocs_getnext_batch(AOCSScanDesc scan, TupleTableSlot *slot)
+{
+	AOCSScanBatch *batch = scan->batch;
+	int			ncol = slot->tts_tupleDescriptor->natts;
+	Datum	   *d = slot_get_values(slot);
+	bool	   *null = slot_get_isnull(slot);
+	int			i;
+
+	for (;;)
+	{
+		while (batch->next < batch->nrows)
+		{
+			AOCSFileSegInfo *curseginfo = scan->seginfo[scan->cur_seg];
+			int			k = batch->next++;
+			int64		rowNum = batch->firstRowNum + k;
+			int		   *read_atts;
+			int			num_read_atts;
+			AOTupleId	aoTupleId;
+
+			if (!batch->selected[k])
+				continue;
+
+			if (scan->late_materialize)
+			{
+				read_atts = scan->filter_atts;
+				num_read_atts = scan->num_filter_atts;
+			}
+			else
+			{
+				read_atts = scan->proj_atts;
+				num_read_atts = scan->num_proj_atts;
+			}
+
+			for (i = 0; i < num_read_atts; i++)
+			{
+				int			attno = read_atts[i];
+
+				d[attno] = batch->values[attno][k];
+				null[attno] = batch->isnull[attno][k];
+			}
+
+			AOTupleIdInit(&aoTupleId, curseginfo->segno, rowNum);
+			scan->cdb_fake_ctid = *((ItemPointer) &aoTupleId);
+
+			TupSetVirtualTupleNValid(slot, ncol);
+			slot_set_ctid(slot, &(scan->cdb_fake_ctid));
+
+			if (scan->filter && !scan->filter(scan->filter_arg, slot))
+				continue;
+
+			if (scan->late_materialize)
+				read_lazy_columns(scan, rowNum, d, null);
+
+			return true;
+		}
+
+		if (scan->cur_seg >= 0)
+		{
+			if (fill_batch(scan))
+				continue;
+
+			close_cur_scan_seg(scan);
+		}
+
+		/* Open the next segment file */
+		batch->nrows = 0;
+		batch->next = 0;
+		if (open_next_scan_seg(scan) < 0)
+		{
+			/* No more seg, we are at the end */
+			ExecClearTuple(slot);
+			scan->cur_seg = -1;
+			return false;
+		}
+		scan->cur_seg_row = 0;
+	}
+}
+
 bool
 aocs_getnext(AOCSScanDesc scan, ScanDirection direction, TupleTableSlot *slot)
 {
@@ -667,10 +1605,15 @@ aocs_getnext(AOCSScanDesc scan, ScanDirection direction, TupleTableSlot *slot)
 	int64		rowNum = INT64CONST(-1);
 	int			err = 0;
 	int			i;
+	int		   *read_atts;
+	int			num_read_atts;
 	bool		isSnapshotAny = (scan->snapshot == SnapshotAny);
 
 	Assert(ScanDirectionIsForward(direction));
 
+	if (scan->batch)
+		return aocs_getnext_batch(scan, slot);
+
 	ncol = slot->tts_tupleDescriptor->natts;
 	Assert(ncol <= scan->relationTupleDesc->natts);
 
@@ -696,10 +1639,25 @@ ReadNext:
 		Assert(scan->cur_seg >= 0);
 		curseginfo = scan->seginfo[scan->cur_seg];
 
+		/*
+		 * With late materialization, only the columns of the filter are
+		 * read here, the rest once the row has passed the filter.
+		 */
+		if (scan->late_materialize)
+		{
+			read_atts = scan->filter_atts;
+			num_read_atts = scan->num_filter_atts;
+		}
+		else
+		{
+			read_atts = scan->proj_atts;
+			num_read_atts = scan->num_proj_atts;
+		}
+
 		/* Read from cur_seg */
-		for (i = 0; i < scan->num_proj_atts; i++)
+		for (i = 0; i < num_read_atts; i++)
 		{
-			int			attno = scan->proj_atts[i];
+			int			attno = read_atts[i];
 
 			err = datumstreamread_advance(scan->ds[attno]);
 			Assert(err >= 0);
@@ -743,6 +1701,58 @@ ReadNext:
 			}
 		}
 
+		/*
+		 * If the zone maps prove that no row up to some later row can
+		 * satisfy the quals, skip ahead on all the columns.
+		 */
+		if (scan->num_excluded_ranges > 0 && rowNum != INT64CONST(-1))
+		{
+			int64		lastRowNum;
+
+			if (row_excluded_by_zonemap(scan, rowNum, &lastRowNum))
+			{
+				scan->zonemap_skipped_rows += lastRowNum - rowNum + 1;
+				for (i = 0; i < num_read_atts; i++)
+				{
+					err = datumstreamread_skip_rows(scan->ds[read_atts[i]],
+													lastRowNum);
+					if (err < 0)
+					{
+						close_cur_scan_seg(scan);
+						break;
+					}
+				}
+				rowNum = INT64CONST(-1);
+				goto ReadNext;
+			}
+		}
+
+		/*
+		 * Skip the rows that the dictionary scan keys exclude, and the rest
+		 * of a block in which none qualifies, on all the columns.
+		 */
+		if (scan->dict_keys != NULL && rowNum != INT64CONST(-1))
+		{
+			int64		lastRowNum;
+
+			if (row_excluded_by_dictionary(scan, read_atts, num_read_atts,
+										   &lastRowNum))
+			{
+				for (i = 0; lastRowNum > rowNum && i < num_read_atts; i++)
+				{
+					err = datumstreamread_skip_rows(scan->ds[read_atts[i]],
+													lastRowNum);
+					if (err < 0)
+					{
+						close_cur_scan_seg(scan);
+						break;
+					}
+				}
+				rowNum = INT64CONST(-1);
+				goto ReadNext;
+			}
+		}
+
 		scan->cur_seg_row++;
 		if (rowNum == INT64CONST(-1))
 		{
@@ -762,6 +1772,23 @@ ReadNext:
 
 		TupSetVirtualTupleNValid(slot, ncol);
 		slot_set_ctid(slot, &(scan->cdb_fake_ctid));
+
+		/*
+		 * The caller leaves the quals to the filter, so it has to be applied
+		 * also to the segment files that are read eagerly.
+		 */
+		if (scan->filter && !scan->filter(scan->filter_arg, slot))
+		{
+			rowNum = INT64CONST(-1);
+			goto ReadNext;
+		}
+
+		if (scan->late_materialize)
+		{
+			Assert(rowNum != INT64CONST(-1));
+			read_lazy_columns(scan, rowNum, d, null);
+		}
+
 		return true;
 	}
 
@@ -931,6 +1958,13 @@ aocs_insert_init(Relation rel, int segno, bool update_mode)
 											(FileSegInfo *) desc->fsInfo, desc->lastSequence,
 											rel, segno, tupleDesc->natts, true);
 
+	/* Summarize the blocks of the columns that have a zone map */
+	for (int i = 0; i < tupleDesc->natts; i++)
+	{
+		if (AppendOnlyBlockDirectory_HasZoneMap(&desc->blockDirectory, i))
+			desc->ds[i]->zoneMapBuilder = AppendOnlyZoneMapBuilder_Create(rel, i);
+	}
+
 	return desc;
 }
 
@@ -1015,6 +2049,11 @@ aocs_insert_values(AOCSInsertDesc idesc, Datum *d, bool *null, AOTupleId *aoTupl
 			}
 		}
 
+		/* Summarize the datum into the zone map entry of its block */
+		if (idesc->ds[i]->zoneMapBuilder)
+			AppendOnlyZoneMapBuilder_AddValue(idesc->ds[i]->zoneMapBuilder, 0,
+											  datum, null[i]);
+
 		if (toFree1 != NULL)
 			pfree(toFree1);
 	}
@@ -0,0 +1,590 @@
+/*------------------------------------------------------------------------------
+ *
+ * appendonly_zonemap.c
+ *   maintain and consult the per-block min/max summaries (zone maps) of
+ *   append-optimized relations.
+ *
+ * The zone map of a minipage has one entry per minipage entry and tracked
+ * column. An entry records the smallest and the largest non-NULL value of
+ * the column in the blocks covered by the minipage entry, and whether any
+ * of those rows were NULL. Entries are only VALID if every row of the
+ * covered blocks was summarized; anything written without a summary, e.g.
+ * while the block directory is built from existing data, is never skipped.
+ *
+ * Only fixed-length, pass-by-value types with a default btree operator class
+ * are tracked, so the min/max values can be stored as plain Datums.
+ *
+ * Copyright (c) 2020-Present VMware, Inc. or its affiliates
+ *
+ *
+ * IDENTIFICATION
+ *	    src/backend/access/appendonly/appendonly_zonemap.c
+ *
+ *------------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "access/appendonly_zonemap.h"
+#include "access/nbtree.h"
+#include "nodes/primnodes.h"
+#include "utils/lsyscache.h"
+#include "utils/rel.h"
+#include "utils/typcache.h"
+
+bool		gp_appendonly_zone_maps = false;
+
+static bool
+zonemap_column_supported(Form_pg_attribute attr)
+{
+	TypeCacheEntry *typentry;
+
+	if (attr->attisdropped || !attr->attbyval || attr->attlen <= 0)
+		return false;
+
+	typentry = lookup_type_cache(attr->atttypid, TYPECACHE_CMP_PROC);
+
+	return OidIsValid(typentry->cmp_proc);
+}
+
+static inline int32
+zonemap_compare(FmgrInfo *cmpProc, Datum a, Datum b)
+{
+	return DatumGetInt32(FunctionCall2Coll(cmpProc, InvalidOid, a, b));
+}
+
+/*
+ * AppendOnlyZoneMap_GetColumns
+ *
+ * Find the columns of the given column group that are tracked in its zone
+ * map. Row-oriented tables track the first AO_ZONEMAP_MAX_COLUMNS supported
+ * columns in column group 0, column-oriented tables track the column of the
+ * column group if it is supported.
+ *
+ * Returns the number of tracked columns.
+ */
+int
+AppendOnlyZoneMap_GetColumns(Relation aoRel, int columnGroupNo,
+							 AttrNumber *attnums, Oid *atttypids)
+{
+	TupleDesc	tupdesc = RelationGetDescr(aoRel);
+	int			nColumns = 0;
+	int			i;
+
+	if (RelationIsAoCols(aoRel))
+	{
+		Form_pg_attribute attr;
+
+		Assert(columnGroupNo < tupdesc->natts);
+
+		attr = tupdesc->attrs[columnGroupNo];
+		if (zonemap_column_supported(attr))
+		{
+			attnums[0] = columnGroupNo + 1;
+			atttypids[0] = attr->atttypid;
+			nColumns = 1;
+		}
+
+		return nColumns;
+	}
+
+	Assert(columnGroupNo == 0);
+
+	for (i = 0; i < tupdesc->natts && nColumns < AO_ZONEMAP_MAX_COLUMNS; i++)
+	{
+		Form_pg_attribute attr = tupdesc->attrs[i];
+
+		if (!zonemap_column_supported(attr))
+			continue;
+
+		attnums[nColumns] = i + 1;
+		atttypids[nColumns] = attr->atttypid;
+		nColumns++;
+	}
+
+	return nColumns;
+}
+
+/*
+ * AppendOnlyZoneMap_Create
+ *
+ * Allocate an in-memory zone map for up to maxEntries minipage entries of
+ * the given column group. Returns NULL if the column group has no tracked
+ * columns.
+ */
+AppendOnlyZoneMap *
+AppendOnlyZoneMap_Create(Relation aoRel, int columnGroupNo, uint32 maxEntries)
+{
+	AppendOnlyZoneMap *zoneMap;
+	AttrNumber	attnums[AO_ZONEMAP_MAX_COLUMNS];
+	Oid			atttypids[AO_ZONEMAP_MAX_COLUMNS];
+	int			nColumns;
+
+	nColumns = AppendOnlyZoneMap_GetColumns(aoRel, columnGroupNo,
+											attnums, atttypids);
+	if (nColumns == 0)
+		return NULL;
+
+	zoneMap = palloc0(AppendOnlyZoneMap_Size(maxEntries, nColumns));
+	zoneMap->version = AO_ZONEMAP_VERSION;
+	zoneMap->nColumns = nColumns;
+	memcpy(zoneMap->attnums, attnums, nColumns * sizeof(AttrNumber));
+	memcpy(zoneMap->atttypids, atttypids, nColumns * sizeof(Oid));
+
+	return zoneMap;
+}
+
+/*
+ * AppendOnlyZoneMap_SetEntry
+ *
+ * Set the zone map entry of a new minipage entry from the summary of the
+ * block that was just written. A NULL builder means that the block was not
+ * summarized.
+ */
+void
+AppendOnlyZoneMap_SetEntry(AppendOnlyZoneMap *zoneMap, int entryNo,
+						   AppendOnlyZoneMapBuilder *builder)
+{
+	int			columnNo;
+
+	Assert(builder == NULL || builder->nColumns == zoneMap->nColumns);
+
+	for (columnNo = 0; columnNo < zoneMap->nColumns; columnNo++)
+	{
+		AppendOnlyZoneMapEntry *entry =
+		AppendOnlyZoneMap_GetEntry(zoneMap, entryNo, columnNo);
+
+		if (builder != NULL)
+			*entry = builder->current[columnNo];
+		else
+			MemSet(entry, 0, sizeof(AppendOnlyZoneMapEntry));
+	}
+}
+
+/*
+ * AppendOnlyZoneMap_MergeEntry
+ *
+ * Widen an existing zone map entry to also cover the block that was just
+ * written. Used when the block does not get a minipage entry of its own,
+ * see gp_blockdirectory_entry_min_range.
+ */
+void
+AppendOnlyZoneMap_MergeEntry(AppendOnlyZoneMap *zoneMap, int entryNo,
+							 AppendOnlyZoneMapBuilder *builder)
+{
+	int			columnNo;
+
+	Assert(builder == NULL || builder->nColumns == zoneMap->nColumns);
+
+	for (columnNo = 0; columnNo < zoneMap->nColumns; columnNo++)
+	{
+		AppendOnlyZoneMapEntry *entry =
+		AppendOnlyZoneMap_GetEntry(zoneMap, entryNo, columnNo);
+		AppendOnlyZoneMapEntry *current;
+
+		if (builder == NULL || (entry->flags & AOZM_VALID) == 0)
+		{
+			MemSet(entry, 0, sizeof(AppendOnlyZoneMapEntry));
+			continue;
+		}
+
+		current = &builder->current[columnNo];
+		entry->flags |= (current->flags & AOZM_HAS_NULLS);
+
+		if ((current->flags & AOZM_HAS_VALUES) == 0)
+			continue;
+
+		if ((entry->flags & AOZM_HAS_VALUES) == 0)
+		{
+			entry->minValue = current->minValue;
+			entry->maxValue = current->maxValue;
+			entry->flags |= AOZM_HAS_VALUES;
+			continue;
+		}
+
+		if (zonemap_compare(&builder->cmpProcs[columnNo],
+							current->minValue, entry->minValue) < 0)
+			entry->minValue = current->minValue;
+		if (zonemap_compare(&builder->cmpProcs[columnNo],
+							current->maxValue, entry->maxValue) > 0)
+			entry->maxValue = current->maxValue;
+	}
+}
+
+/*
+ * AppendOnlyZoneMap_Load
+ *
+ * Fill the first nEntry entries of an in-memory zone map from the zone map
+ * stored with a minipage. The stored zone map may track different columns,
+ * e.g. if columns were dropped since it was written; entries of columns it
+ * does not track are left not VALID. A NULL stored zone map means that the
+ * minipage was written without zone maps.
+ */
+void
+AppendOnlyZoneMap_Load(AppendOnlyZoneMap *zoneMap, AppendOnlyZoneMap *stored,
+					   uint32 nEntry)
+{
+	int			columnNo;
+	uint32		entryNo;
+
+	for (columnNo = 0; columnNo < zoneMap->nColumns; columnNo++)
+	{
+		int			storedColumnNo = -1;
+		int			i;
+
+		if (stored != NULL && stored->version == AO_ZONEMAP_VERSION)
+		{
+			for (i = 0; i < stored->nColumns; i++)
+			{
+				if (stored->attnums[i] == zoneMap->attnums[columnNo] &&
+					stored->atttypids[i] == zoneMap->atttypids[columnNo])
+				{
+					storedColumnNo = i;
+					break;
+				}
+			}
+		}
+
+		for (entryNo = 0; entryNo < nEntry; entryNo++)
+		{
+			AppendOnlyZoneMapEntry *entry =
+			AppendOnlyZoneMap_GetEntry(zoneMap, entryNo, columnNo);
+
+			if (storedColumnNo >= 0 && entryNo < stored->nEntry)
+				*entry = *AppendOnlyZoneMap_GetEntry(stored, entryNo,
+													 storedColumnNo);
+			else
+				MemSet(entry, 0, sizeof(AppendOnlyZoneMapEntry));
+		}
+	}
+	zoneMap->nEntry = nEntry;
+}
+
+/*
+ * AppendOnlyZoneMap_EntryExcluded
+ *
+ * Can the given zone map entry prove that none of the rows it covers
+ * satisfy all of the zone map scan keys?
+ *
+ * The scan keys are built by AppendOnlyZoneMap_BuildScanKeys: sk_func is the
+ * btree comparison function of the column type, and sk_subtype is the
+ * column type.
+ */
+bool
+AppendOnlyZoneMap_EntryExcluded(AppendOnlyZoneMap *zoneMap, int entryNo,
+								int nkeys, ScanKey keys)
+{
+	int			keyNo;
+
+	for (keyNo = 0; keyNo < nkeys; keyNo++)
+	{
+		ScanKey		key = &keys[keyNo];
+		AppendOnlyZoneMapEntry *entry = NULL;
+		int			columnNo;
+		int32		cmp;
+
+		for (columnNo = 0; columnNo < zoneMap->nColumns; columnNo++)
+		{
+			if (zoneMap->attnums[columnNo] == key->sk_attno &&
+				zoneMap->atttypids[columnNo] == key->sk_subtype)
+			{
+				entry = AppendOnlyZoneMap_GetEntry(zoneMap, entryNo, columnNo);
+				break;
+			}
+		}
+
+		if (entry == NULL || (entry->flags & AOZM_VALID) == 0)
+			continue;
+
+		if (key->sk_flags & SK_SEARCHNULL)
+		{
+			if ((entry->flags & AOZM_HAS_NULLS) == 0)
+				return true;
+			continue;
+		}
+
+		/* All the remaining keys are strict */
+		if ((entry->flags & AOZM_HAS_VALUES) == 0)
+			return true;
+
+		if (key->sk_flags & SK_SEARCHNOTNULL)
+			continue;
+
+		switch (key->sk_strategy)
+		{
+			case BTLessStrategyNumber:
+				cmp = zonemap_compare(&key->sk_func, entry->minValue,
+									  key->sk_argument);
+				if (cmp >= 0)
+					return true;
+				break;
+
+			case BTLessEqualStrategyNumber:
+				cmp = zonemap_compare(&key->sk_func, entry->minValue,
+									  key->sk_argument);
+				if (cmp > 0)
+					return true;
+				break;
+
+			case BTEqualStrategyNumber:
+				cmp = zonemap_compare(&key->sk_func, entry->minValue,
+									  key->sk_argument);
+				if (cmp > 0)
+					return true;
+				cmp = zonemap_compare(&key->sk_func, entry->maxValue,
+									  key->sk_argument);
+				if (cmp < 0)
+					return true;
+				break;
+
+			case BTGreaterEqualStrategyNumber:
+				cmp = zonemap_compare(&key->sk_func, entry->maxValue,
+									  key->sk_argument);
+				if (cmp < 0)
+					return true;
+				break;
+
+			case BTGreaterStrategyNumber:
+				cmp = zonemap_compare(&key->sk_func, entry->maxValue,
+									  key->sk_argument);
+				if (cmp <= 0)
+					return true;
+				break;
+
+			default:
+				elog(ERROR, "unrecognized zone map scan key strategy: %d",
+					 key->sk_strategy);
+		}
+	}
+
+	return false;
+}
+
+/*
+ * AppendOnlyZoneMapBuilder_Create
+ *
+ * Create a builder that summarizes the tracked columns of the given column
+ * group for each block written. Returns NULL if the column group has no
+ * tracked columns.
+ */
+AppendOnlyZoneMapBuilder *
+AppendOnlyZoneMapBuilder_Create(Relation aoRel, int columnGroupNo)
+{
+	AppendOnlyZoneMapBuilder *builder;
+	AttrNumber	attnums[AO_ZONEMAP_MAX_COLUMNS];
+	Oid			atttypids[AO_ZONEMAP_MAX_COLUMNS];
+	int			nColumns;
+	int			columnNo;
+
+	nColumns = AppendOnlyZoneMap_GetColumns(aoRel, columnGroupNo,
+											attnums, atttypids);
+	if (nColumns == 0)
+		return NULL;
+
+	builder = palloc0(sizeof(AppendOnlyZoneMapBuilder));
+	builder->nColumns = nColumns;
+	for (columnNo = 0; columnNo < nColumns; columnNo++)
+	{
+		TypeCacheEntry *typentry;
+
+		builder->attnums[columnNo] = attnums[columnNo];
+		builder->atttypids[columnNo] = atttypids[columnNo];
+
+		typentry = lookup_type_cache(atttypids[columnNo], TYPECACHE_CMP_PROC);
+		fmgr_info(typentry->cmp_proc, &builder->cmpProcs[columnNo]);
+	}
+
+	AppendOnlyZoneMapBuilder_Reset(builder);
+
+	return builder;
+}
+
+/*
+ * AppendOnlyZoneMapBuilder_AddValue
+ *
+ * Add the value of a tracked column of a row to the summary of the current
+ * block.
+ */
+void
+AppendOnlyZoneMapBuilder_AddValue(AppendOnlyZoneMapBuilder *builder,
+								  int columnNo, Datum value, bool isnull)
+{
+	AppendOnlyZoneMapEntry *current = &builder->current[columnNo];
+
+	Assert(columnNo < builder->nColumns);
+
+	if (isnull)
+	{
+		current->flags |= AOZM_HAS_NULLS;
+		return;
+	}
+
+	if ((current->flags & AOZM_HAS_VALUES) == 0)
+	{
+		current->minValue = value;
+		current->maxValue = value;
+		current->flags |= AOZM_HAS_VALUES;
+	}
+	else if (zonemap_compare(&builder->cmpProcs[columnNo],
+							 value, current->minValue) < 0)
+		current->minValue = value;
+	else if (zonemap_compare(&builder->cmpProcs[columnNo],
+							 value, current->maxValue) > 0)
+		current->maxValue = value;
+}
+
+/*
+ * AppendOnlyZoneMapBuilder_Reset
+ *
+ * Start summarizing a new block.
+ */
+void
+AppendOnlyZoneMapBuilder_Reset(AppendOnlyZoneMapBuilder *builder)
+{
+	int			columnNo;
+
+	for (columnNo = 0; columnNo < builder->nColumns; columnNo++)
+	{
+		builder->current[columnNo].minValue = (Datum) 0;
+		builder->current[columnNo].maxValue = (Datum) 0;
+		builder->current[columnNo].flags = AOZM_VALID;
+	}
+}
+
+/*
+ * Is the expression a plain column reference of a column that can be
+ * tracked in a zone map?
+ */
+static bool
+zonemap_qual_var(Relation aoRel, Node *node)
+{
+	Var		   *var;
+	TupleDesc	tupdesc = RelationGetDescr(aoRel);
+
+	if (node == NULL || !IsA(node, Var))
+		return false;
+
+	var = (Var *) node;
+	if (var->varlevelsup != 0 || var->varattno <= 0 ||
+		var->varattno > tupdesc->natts)
+		return false;
+
+	if (var->vartype != tupdesc->attrs[var->varattno - 1]->atttypid)
+		return false;
+
+	return zonemap_column_supported(tupdesc->attrs[var->varattno - 1]);
+}
+
+/*
+ * AppendOnlyZoneMap_BuildScanKeys
+ *
+ * Build the zone map scan keys of a sequential scan from its quals. Only
+ * the quals of the form "column op constant" (or commuted), where op is a
+ * btree comparison operator of the column type's default operator family,
+ * and "column IS [NOT] NULL" are used; the remaining quals are ignored. The
+ * quals are still evaluated for every row that is not skipped.
+ *
+ * Returns NULL and sets *nkeys to 0 if no qual can be used.
+ */
+ScanKey
+AppendOnlyZoneMap_BuildScanKeys(Relation aoRel, List *quals, int *nkeys)
+{
+	ScanKey		keys;
+	ListCell   *lc;
+	int			n = 0;
+
+	*nkeys = 0;
+	if (quals == NIL)
+		return NULL;
+
+	keys = palloc0(list_length(quals) * sizeof(ScanKeyData));
+
+	foreach(lc, quals)
+	{
+		Node	   *qual = (Node *) lfirst(lc);
+
+		if (IsA(qual, OpExpr) && list_length(((OpExpr *) qual)->args) == 2)
+		{
+			OpExpr	   *opexpr = (OpExpr *) qual;
+			Node	   *leftop = (Node *) linitial(opexpr->args);
+			Node	   *rightop = (Node *) lsecond(opexpr->args);
+			Oid			opno = opexpr->opno;
+			Var		   *var;
+			Const	   *con;
+			TypeCacheEntry *typentry;
+			int			strategy;
+			Oid			lefttype;
+			Oid			righttype;
+
+			if (zonemap_qual_var(aoRel, leftop) && IsA(rightop, Const))
+			{
+				var = (Var *) leftop;
+				con = (Const *) rightop;
+			}
+			else if (zonemap_qual_var(aoRel, rightop) && IsA(leftop, Const))
+			{
+				var = (Var *) rightop;
+				con = (Const *) leftop;
+				opno = get_commutator(opno);
+				if (!OidIsValid(opno))
+					continue;
+			}
+			else
+				continue;
+
+			if (con->constisnull || con->consttype != var->vartype)
+				continue;
+
+			typentry = lookup_type_cache(var->vartype,
+										 TYPECACHE_BTREE_OPFAMILY |
+										 TYPECACHE_CMP_PROC_FINFO);
+			if (!OidIsValid(typentry->btree_opf) ||
+				!OidIsValid(typentry->cmp_proc_finfo.fn_oid) ||
+				!op_in_opfamily(opno, typentry->btree_opf))
+				continue;
+
+			get_op_opfamily_properties(opno, typentry->btree_opf, false,
+									   &strategy, &lefttype, &righttype);
+			if (lefttype != var->vartype || righttype != var->vartype)
+				continue;
+
+			ScanKeyEntryInitializeWithInfo(&keys[n++],
+										   0,	/* sk_flags */
+										   var->varattno,
+										   strategy,
+										   var->vartype,
+										   InvalidOid,	/* collation */
+										   &typentry->cmp_proc_finfo,
+										   con->constvalue);
+		}
+		else if (IsA(qual, NullTest))
+		{
+			NullTest   *ntest = (NullTest *) qual;
+			Var		   *var;
+
+			if (ntest->argisrow ||
+				!zonemap_qual_var(aoRel, (Node *) ntest->arg))
+				continue;
+
+			var = (Var *) ntest->arg;
+			ScanKeyEntryInitialize(&keys[n++],
+								   SK_ISNULL |
+								   (ntest->nulltesttype == IS_NULL ?
+									SK_SEARCHNULL : SK_SEARCHNOTNULL),
+								   var->varattno,
+								   InvalidStrategy,
+								   var->vartype,
+								   InvalidOid,	/* collation */
+								   InvalidOid,	/* no reg proc for this */
+								   (Datum) 0);
+		}
+	}
+
+	if (n == 0)
+	{
+		pfree(keys);
+		return NULL;
+	}
+
+	*nkeys = n;
+	return keys;
+}
@@ -164,6 +164,19 @@ initscan(AppendOnlyScanDesc scan, ScanKey key)
 	pgstat_count_heap_scan(scan->aos_rd);
 }
 
+/*
+ * Free the zone map excluded ranges of the current segment file, if any.
+ */
+static void
+FreeExcludedRanges(AppendOnlyScanDesc scan)
+{
+	if (scan->aos_excludedRanges)
+		pfree(scan->aos_excludedRanges);
+	scan->aos_excludedRanges = NULL;
+	scan->aos_nexcludedRanges = 0;
+	scan->aos_nextExcludedRange = 0;
+}
+
 /*
  * Open the next file segment to scan and allocate all resources needed for it.
  */
@@ -333,6 +346,24 @@ SetNextFileSegForRead(AppendOnlyScanDesc scan)
 												 &scan->executorReadBlock,
 												  /* blockFirstRowNum */ 1);
 
+	/* Find the blocks of the segment file the zone maps exclude */
+	FreeExcludedRanges(scan);
+	if (scan->aos_nzonemapkeys > 0 && scan->blockDirectory == NULL)
+	{
+		MemoryContext oldMemoryContext = MemoryContextSwitchTo(scan->aoScanInitContext);
+
+		scan->aos_excludedRanges =
+			AppendOnlyBlockDirectory_GetExcludedRanges(reln,
+													   scan->appendOnlyMetaDataSnapshot,
+													   segno,
+													   0,	/* columnGroupNo */
+													   eof,
+													   scan->aos_nzonemapkeys,
+													   scan->aos_zonemapkeys,
+													   &scan->aos_nexcludedRanges);
+		MemoryContextSwitchTo(oldMemoryContext);
+	}
+
 	/* ready to go! */
 	scan->aos_need_new_segfile = false;
 
@@ -1241,6 +1272,37 @@ AppendOnlyExecutorReadBlock_FetchTuple(AppendOnlyExecutorReadBlock *executorRead
 
 /* ------------------------------------------------------------------------------ */
 
+/*
+ * Is the current block within one of the ranges of the current segment file
+ * that the zone maps exclude?
+ *
+ * The blocks are visited in file order, so the ranges are walked with a
+ * cursor. Large content blocks are never excluded, since the rows stored
+ * in them are not summarized.
+ */
+static bool
+BlockExcludedByZoneMap(AppendOnlyScanDesc scan)
+{
+	int64		offset = scan->executorReadBlock.headerOffsetInFile;
+
+	if (scan->aos_nexcludedRanges == 0 || scan->executorReadBlock.isLarge)
+		return false;
+
+	while (scan->aos_nextExcludedRange < scan->aos_nexcludedRanges)
+	{
+		AppendOnlyBlockDirectoryEntry *range =
+		&scan->aos_excludedRanges[scan->aos_nextExcludedRange];
+
+		if (offset < range->range.fileOffset)
+			return false;
+		if (offset < range->range.afterFileOffset)
+			return true;
+		scan->aos_nextExcludedRange++;
+	}
+
+	return false;
+}
+
 /*
  * You can think of this scan routine as get next "executor" AO block.
  */
@@ -1256,19 +1318,30 @@ getNextBlock(AppendOnlyScanDesc scan)
 			return false;
 	}
 
-	if (!AppendOnlyExecutorReadBlock_GetBlockInfo(
-												  &scan->storageRead,
-												  &scan->executorReadBlock))
+	while (true)
 	{
-		if (scan->blockDirectory)
+		if (!AppendOnlyExecutorReadBlock_GetBlockInfo(
+													  &scan->storageRead,
+													  &scan->executorReadBlock))
 		{
-			AppendOnlyBlockDirectory_End_forInsert(scan->blockDirectory);
+			if (scan->blockDirectory)
+			{
+				AppendOnlyBlockDirectory_End_forInsert(scan->blockDirectory);
+			}
+
+			/* done reading the file */
+			CloseScannedFileSeg(scan);
+
+			return false;
 		}
 
-		/* done reading the file */
-		CloseScannedFileSeg(scan);
+		if (!BlockExcludedByZoneMap(scan))
+			break;
 
-		return false;
+		/* No row of the block can satisfy the quals, skip it unread */
+		scan->aos_zonemapSkippedRows += scan->executorReadBlock.rowCount;
+		AppendOnlyStorageRead_SkipCurrentBlock(&scan->storageRead);
+		AppendOnlyExecutionReadBlock_FinishedScanBlock(&scan->executorReadBlock);
 	}
 
 	if (scan->blockDirectory)
@@ -1521,13 +1594,16 @@ finishWriteBlock(AppendOnlyInsertDesc aoInsertDesc)
 	}
 
 	/* Insert an entry to the block directory */
-	AppendOnlyBlockDirectory_InsertEntry(
-										 &aoInsertDesc->blockDirectory,
-										 0,
-										 aoInsertDesc->blockFirstRowNum,
-										 AppendOnlyStorageWrite_LogicalBlockStartOffset(&aoInsertDesc->storageWrite),
-										 itemCount,
-										 false);
+	AppendOnlyBlockDirectory_InsertEntryWithZoneMap(
+													&aoInsertDesc->blockDirectory,
+													0,
+													aoInsertDesc->blockFirstRowNum,
+													AppendOnlyStorageWrite_LogicalBlockStartOffset(&aoInsertDesc->storageWrite),
+													itemCount,
+													aoInsertDesc->zoneMapBuilder);
+
+	if (aoInsertDesc->zoneMapBuilder)
+		AppendOnlyZoneMapBuilder_Reset(aoInsertDesc->zoneMapBuilder);
 
 	Assert(aoInsertDesc->nonCompressedData == NULL);
 	Assert(!AppendOnlyStorageWrite_IsBufferAllocated(&aoInsertDesc->storageWrite));
@@ -1728,6 +1804,10 @@ appendonly_afterscan(AppendOnlyScanDesc scan)
 {
 	CloseScannedFileSeg(scan);
 
+	if (scan->initedStorageRoutines)
+		BufferedReadAccumStats(&scan->ioStats,
+							   &scan->storageRead.bufferedRead);
+
 	AppendOnlyStorageRead_FinishSession(&scan->storageRead);
 
 	scan->initedStorageRoutines = false;
@@ -1758,6 +1838,18 @@ appendonly_rescan(AppendOnlyScanDesc scan,
 	initscan(scan, key);
 }
 
+/*
+ * Return the I/O statistics of the scan so far, for EXPLAIN ANALYZE.
+ */
+void
+appendonly_get_io_stats(AppendOnlyScanDesc scan, BufferedReadStats *stats)
+{
+	*stats = scan->ioStats;
+
+	if (scan->initedStorageRoutines)
+		BufferedReadAccumStats(stats, &scan->storageRead.bufferedRead);
+}
+
 /* ----------------
  *		appendonly_endscan	- end relation scan
  * ----------------
@@ -1770,6 +1862,10 @@ appendonly_endscan(AppendOnlyScanDesc scan)
 	if (scan->aos_key)
 		pfree(scan->aos_key);
 
+	FreeExcludedRanges(scan);
+	if (scan->aos_zonemapkeys)
+		pfree(scan->aos_zonemapkeys);
+
 	if (scan->aos_segfile_arr)
 	{
 		for (int seginfo_no = 0; seginfo_no < scan->aos_total_segfiles; seginfo_no++)
@@ -1782,6 +1878,10 @@ appendonly_endscan(AppendOnlyScanDesc scan)
 
 	CloseScannedFileSeg(scan);
 
+	if (scan->initedStorageRoutines)
+		BufferedReadAccumStats(&scan->ioStats,
+							   &scan->storageRead.bufferedRead);
+
 	AppendOnlyStorageRead_FinishSession(&scan->storageRead);
 
 	scan->initedStorageRoutines = false;
@@ -1796,6 +1896,25 @@ appendonly_endscan(AppendOnlyScanDesc scan)
 	pfree(scan);
 }
 
+/* ----------------
+ *		appendonly_set_zonemap_keys	- set the zone map scan keys
+ *
+ * The keys, built with AppendOnlyZoneMap_BuildScanKeys(), are used to skip
+ * the blocks whose zone map summary proves that none of their rows satisfy
+ * all of them. The rows of the blocks read are not checked against the
+ * keys; the caller still has to evaluate its quals. Must be called before
+ * the first tuple is fetched.
+ * ----------------
+ */
+void
+appendonly_set_zonemap_keys(AppendOnlyScanDesc scan, int nkeys, ScanKey keys)
+{
+	Assert(scan->aos_excludedRanges == NULL);
+
+	scan->aos_nzonemapkeys = nkeys;
+	scan->aos_zonemapkeys = keys;
+}
+
 /* ----------------
  *		appendonly_getnext	- retrieve next tuple in scan
  * ----------------
@@ -2815,6 +2934,9 @@ aoInsertDesc->appendOnlyMetaDataSnapshot, //CONCERN:Safe to assume all block dir
 											aoInsertDesc->fsInfo, aoInsertDesc->lastSequence,
 											rel, segno, 1, false);
 
+	if (AppendOnlyBlockDirectory_HasZoneMap(&aoInsertDesc->blockDirectory, 0))
+		aoInsertDesc->zoneMapBuilder = AppendOnlyZoneMapBuilder_Create(rel, 0);
+
 	return aoInsertDesc;
 }
 
@@ -3018,6 +3140,24 @@ appendonly_insert(AppendOnlyInsertDesc aoInsertDesc,
 
 		if (itemLen > 0)
 			memcpy(itemPtr, tup, itemLen);
+
+		/* Summarize the tuple into the zone map entry of the block */
+		if (aoInsertDesc->zoneMapBuilder)
+		{
+			AppendOnlyZoneMapBuilder *builder = aoInsertDesc->zoneMapBuilder;
+			int			columnNo;
+
+			for (columnNo = 0; columnNo < builder->nColumns; columnNo++)
+			{
+				Datum		value;
+				bool		isnull;
+
+				value = memtuple_getattr(tup, aoInsertDesc->mt_bind,
+										 builder->attnums[columnNo], &isnull);
+				AppendOnlyZoneMapBuilder_AddValue(builder, columnNo,
+												  value, isnull);
+			}
+		}
 	}
 	else
 	{
@@ -48,6 +48,12 @@ static int find_minipage_entry(
 					Minipage *minipage,
 					uint32 numEntries,
 					int64 rowNum);
+static inline void copy_out_minipage(MinipagePerColumnGroup *minipageInfo,
+				  Datum minipage_value,
+				  bool minipage_isnull);
+static void copy_out_zonemap(MinipagePerColumnGroup *minipageInfo,
+				 Datum zonemap_value,
+				 bool zonemap_isnull);
 static void extract_minipage(
 				 AppendOnlyBlockDirectory *blockDirectory,
 				 HeapTuple tuple,
@@ -61,7 +67,8 @@ static bool insert_new_entry(AppendOnlyBlockDirectory *blockDirectory,
 				 int64 firstRowNum,
 				 int64 fileOffset,
 				 int64 rowCount,
-				 bool addColAction);
+				 bool addColAction,
+				 AppendOnlyZoneMapBuilder *zoneMapBuilder);
 
 void
 AppendOnlyBlockDirectoryEntry_GetBeginRange(
@@ -277,6 +284,23 @@ AppendOnlyBlockDirectory_Init_forInsert(
 
 	init_internal(blockDirectory, NULL);
 
+	/*
+	 * Maintain the zone maps of the column groups, if the block directory
+	 * relation was created with the zonemap column.
+	 */
+	if (RelationGetDescr(blockDirectory->blkdirRel)->natts >= Anum_pg_aoblkdir_zonemap)
+	{
+		MemoryContext oldcxt;
+
+		oldcxt = MemoryContextSwitchTo(blockDirectory->memoryContext);
+		for (groupNo = 0; groupNo < blockDirectory->numColumnGroups; groupNo++)
+		{
+			blockDirectory->minipages[groupNo].zonemap =
+				AppendOnlyZoneMap_Create(aoRel, groupNo, NUM_MINIPAGE_ENTRIES);
+		}
+		MemoryContextSwitchTo(oldcxt);
+	}
+
 	ereportif(Debug_appendonly_print_blockdirectory, LOG,
 			  (errmsg("Append-only block directory init for insert: "
 					  "(segno, numColumnGroups, isAOCol, lastSequence)="
@@ -679,7 +703,44 @@ AppendOnlyBlockDirectory_InsertEntry(
 									 bool addColAction)
 {
 	return insert_new_entry(blockDirectory, columnGroupNo, firstRowNum,
-							fileOffset, rowCount, addColAction);
+							fileOffset, rowCount, addColAction, NULL);
+}
+
+/*
+ * AppendOnlyBlockDirectory_InsertEntryWithZoneMap
+ *
+ * Same as AppendOnlyBlockDirectory_InsertEntry, but also records the zone
+ * map summary of the written block(s) collected in zoneMapBuilder. Without
+ * a builder, the zone map entry of the new entry is marked not valid.
+ */
+bool
+AppendOnlyBlockDirectory_InsertEntryWithZoneMap(
+												AppendOnlyBlockDirectory *blockDirectory,
+												int columnGroupNo,
+												int64 firstRowNum,
+												int64 fileOffset,
+												int64 rowCount,
+												AppendOnlyZoneMapBuilder *zoneMapBuilder)
+{
+	return insert_new_entry(blockDirectory, columnGroupNo, firstRowNum,
+							fileOffset, rowCount, false, zoneMapBuilder);
+}
+
+/*
+ * AppendOnlyBlockDirectory_HasZoneMap
+ *
+ * Does the block directory, initialized for insert, maintain a zone map
+ * for the given column group?
+ */
+bool
+AppendOnlyBlockDirectory_HasZoneMap(AppendOnlyBlockDirectory *blockDirectory,
+									int columnGroupNo)
+{
+	if (blockDirectory->blkdirRel == NULL ||
+		blockDirectory->blkdirIdx == NULL)
+		return false;
+
+	return blockDirectory->minipages[columnGroupNo].zonemap != NULL;
 }
 
 /*
@@ -694,7 +755,8 @@ insert_new_entry(
 				 int64 firstRowNum,
 				 int64 fileOffset,
 				 int64 rowCount,
-				 bool addColAction)
+				 bool addColAction,
+				 AppendOnlyZoneMapBuilder *zoneMapBuilder)
 {
 	MinipageEntry *entry = NULL;
 	MinipagePerColumnGroup *minipageInfo;
@@ -739,7 +801,13 @@ insert_new_entry(
 
 		if (gp_blockdirectory_entry_min_range > 0 &&
 			fileOffset - entry->fileOffset < gp_blockdirectory_entry_min_range)
+		{
+			/* The latest entry now covers the new block as well */
+			if (minipageInfo->zonemap != NULL)
+				AppendOnlyZoneMap_MergeEntry(minipageInfo->zonemap, lastEntryNo,
+											 zoneMapBuilder);
 			return true;
+		}
 
 		/* Update the rowCount in the latest entry */
 		Assert(entry->rowCount <= firstRowNum - entry->firstRowNum);
@@ -780,6 +848,11 @@ insert_new_entry(
 	entry->fileOffset = fileOffset;
 	entry->rowCount = rowCount;
 
+	if (minipageInfo->zonemap != NULL)
+		AppendOnlyZoneMap_SetEntry(minipageInfo->zonemap,
+								   minipageInfo->numMinipageEntries,
+								   zoneMapBuilder);
+
 	minipageInfo->numMinipageEntries++;
 
 	ereportif(Debug_appendonly_print_blockdirectory, LOG,
@@ -838,6 +911,202 @@ AppendOnlyBlockDirectory_DeleteSegmentFile(Relation aoRel,
 
 }
 
+/*
+ * add_excluded_range
+ *
+ * Append a range to the array of excluded ranges, merging it into the
+ * previous range if they are adjacent.
+ */
+static void
+add_excluded_range(AppendOnlyBlockDirectoryEntry **ranges,
+				   int *nranges, int *maxranges,
+				   int64 fileOffset, int64 firstRowNum,
+				   int64 afterFileOffset, int64 lastRowNum)
+{
+	AppendOnlyBlockDirectoryEntry *range;
+
+	if (*nranges > 0)
+	{
+		range = &(*ranges)[*nranges - 1];
+		if (range->range.afterFileOffset == fileOffset)
+		{
+			range->range.afterFileOffset = afterFileOffset;
+			range->range.lastRowNum = lastRowNum;
+			return;
+		}
+	}
+
+	if (*nranges >= *maxranges)
+	{
+		if (*maxranges == 0)
+		{
+			*maxranges = 16;
+			*ranges = palloc(*maxranges * sizeof(AppendOnlyBlockDirectoryEntry));
+		}
+		else
+		{
+			*maxranges *= 2;
+			*ranges = repalloc(*ranges,
+							   *maxranges * sizeof(AppendOnlyBlockDirectoryEntry));
+		}
+	}
+
+	range = &(*ranges)[(*nranges)++];
+	range->range.fileOffset = fileOffset;
+	range->range.firstRowNum = firstRowNum;
+	range->range.afterFileOffset = afterFileOffset;
+	range->range.lastRowNum = lastRowNum;
+}
+
+/*
+ * AppendOnlyBlockDirectory_GetExcludedRanges
+ *
+ * Use the zone maps of the given segment file and column group to find the
+ * ranges of the file that cannot contain a row satisfying all of the given
+ * zone map scan keys (see AppendOnlyZoneMap_BuildScanKeys). The ranges are
+ * returned in file order, with adjacent ranges merged, and *nranges is set
+ * to their number. Only the part of the file below eof is considered; the
+ * range of the last directory entry extends to eof.
+ *
+ * Returns NULL if the relation has no block directory, or its block
+ * directory has no zone maps.
+ */
+AppendOnlyBlockDirectoryEntry *
+AppendOnlyBlockDirectory_GetExcludedRanges(Relation aoRel,
+										   Snapshot appendOnlyMetaDataSnapshot,
+										   int segno,
+										   int columnGroupNo,
+										   int64 eof,
+										   int nkeys,
+										   ScanKey keys,
+										   int *nranges)
+{
+	Relation	blkdirRel;
+	Relation	blkdirIdx;
+	TupleDesc	heapTupleDesc;
+	ScanKeyData scanKeys[2];
+	IndexScanDesc indexScan;
+	HeapTuple	tuple;
+	Datum	   *values;
+	bool	   *nulls;
+	MinipagePerColumnGroup minipageInfo;
+	AppendOnlyBlockDirectoryEntry *ranges = NULL;
+	int			maxranges = 0;
+	MinipageEntry prevEntry = {0, 0, 0};
+	bool		havePrev = false;
+	bool		prevExcluded = false;
+	bool		done = false;
+
+	*nranges = 0;
+
+	if (nkeys == 0 || !OidIsValid(aoRel->rd_appendonly->blkdirrelid))
+		return NULL;
+
+	blkdirRel = heap_open(aoRel->rd_appendonly->blkdirrelid, AccessShareLock);
+	heapTupleDesc = RelationGetDescr(blkdirRel);
+
+	MemSet(&minipageInfo, 0, sizeof(MinipagePerColumnGroup));
+	if (heapTupleDesc->natts >= Anum_pg_aoblkdir_zonemap)
+		minipageInfo.zonemap = AppendOnlyZoneMap_Create(aoRel, columnGroupNo,
+														NUM_MINIPAGE_ENTRIES);
+	if (minipageInfo.zonemap == NULL)
+	{
+		heap_close(blkdirRel, AccessShareLock);
+		return NULL;
+	}
+
+	Assert(OidIsValid(aoRel->rd_appendonly->blkdiridxid));
+	blkdirIdx = index_open(aoRel->rd_appendonly->blkdiridxid, AccessShareLock);
+
+	minipageInfo.minipage = palloc0(minipage_size(NUM_MINIPAGE_ENTRIES));
+	values = palloc(sizeof(Datum) * heapTupleDesc->natts);
+	nulls = palloc(sizeof(bool) * heapTupleDesc->natts);
+
+	ScanKeyInit(&scanKeys[0],
+				Anum_pg_aoblkdir_segno,
+				BTEqualStrategyNumber,
+				F_INT4EQ,
+				Int32GetDatum(segno));
+	ScanKeyInit(&scanKeys[1],
+				Anum_pg_aoblkdir_columngroupno,
+				BTEqualStrategyNumber,
+				F_INT4EQ,
+				Int32GetDatum(columnGroupNo));
+
+	indexScan = index_beginscan(blkdirRel, blkdirIdx,
+								appendOnlyMetaDataSnapshot, 2, 0);
+	index_rescan(indexScan, scanKeys, 2, NULL, 0);
+
+	/* The minipages come in first_row_no order */
+	while (!done &&
+		   (tuple = index_getnext(indexScan, ForwardScanDirection)) != NULL)
+	{
+		uint32		entryNo;
+
+		heap_deform_tuple(tuple, heapTupleDesc, values, nulls);
+
+		copy_out_minipage(&minipageInfo,
+						  values[Anum_pg_aoblkdir_minipage - 1],
+						  nulls[Anum_pg_aoblkdir_minipage - 1]);
+		copy_out_zonemap(&minipageInfo,
+						 values[Anum_pg_aoblkdir_zonemap - 1],
+						 nulls[Anum_pg_aoblkdir_zonemap - 1]);
+
+		for (entryNo = 0; entryNo < minipageInfo.numMinipageEntries; entryNo++)
+		{
+			MinipageEntry *entry = &minipageInfo.minipage->entry[entryNo];
+
+			/*
+			 * Entries beyond eof belong to aborted inserts, which may also
+			 * have left behind entries that are out of order.
+			 */
+			if (entry->fileOffset >= eof ||
+				(havePrev && entry->fileOffset <= prevEntry.fileOffset))
+			{
+				done = true;
+				break;
+			}
+
+			if (havePrev && prevExcluded)
+				add_excluded_range(&ranges, nranges, &maxranges,
+								   prevEntry.fileOffset,
+								   prevEntry.firstRowNum,
+								   entry->fileOffset,
+								   entry->firstRowNum - 1);
+
+			prevEntry = *entry;
+			prevExcluded = AppendOnlyZoneMap_EntryExcluded(minipageInfo.zonemap,
+														   entryNo,
+														   nkeys, keys);
+			havePrev = true;
+		}
+	}
+
+	if (havePrev && prevExcluded)
+		add_excluded_range(&ranges, nranges, &maxranges,
+						   prevEntry.fileOffset,
+						   prevEntry.firstRowNum,
+						   eof,
+						   INT64_MAX);
+
+	index_endscan(indexScan);
+
+	pfree(values);
+	pfree(nulls);
+	pfree(minipageInfo.minipage);
+	pfree(minipageInfo.zonemap);
+
+	index_close(blkdirIdx, AccessShareLock);
+	heap_close(blkdirRel, AccessShareLock);
+
+	ereportif(Debug_appendonly_print_blockdirectory, LOG,
+			  (errmsg("Append-only block directory zone maps exclude %d range(s): "
+					  "(segno, columnGroupNo, eof) = (%d, %d, " INT64_FORMAT ")",
+					  *nranges, segno, columnGroupNo, eof)));
+
+	return ranges;
+}
+
 /*
  * init_scankeys
  *
@@ -933,6 +1202,35 @@ copy_out_minipage(MinipagePerColumnGroup *minipageInfo,
 	minipageInfo->numMinipageEntries = minipageInfo->minipage->nEntry;
 }
 
+/*
+ * copy_out_zonemap
+ *
+ * Load the in-memory zone map from the zone map of a deformed tuple, which
+ * is NULL if the minipage was written without one.
+ */
+static void
+copy_out_zonemap(MinipagePerColumnGroup *minipageInfo,
+				 Datum zonemap_value,
+				 bool zonemap_isnull)
+{
+	AppendOnlyZoneMap *stored = NULL;
+
+	if (!zonemap_isnull)
+	{
+		struct varlena *detoast_value;
+
+		/* Copy it out to get the Datums of the entries aligned */
+		detoast_value = pg_detoast_datum_copy((struct varlena *)
+											  DatumGetPointer(zonemap_value));
+		stored = (AppendOnlyZoneMap *) detoast_value;
+	}
+
+	AppendOnlyZoneMap_Load(minipageInfo->zonemap, stored,
+						   minipageInfo->numMinipageEntries);
+
+	if (stored != NULL)
+		pfree(stored);
+}
 
 /*
  * extract_minipage
@@ -969,6 +1267,14 @@ extract_minipage(AppendOnlyBlockDirectory *blockDirectory,
 					  values[Anum_pg_aoblkdir_minipage - 1],
 					  nulls[Anum_pg_aoblkdir_minipage - 1]);
 
+	/*
+	 * Copy out the zone map, if we maintain one.
+	 */
+	if (minipageInfo->zonemap != NULL)
+		copy_out_zonemap(minipageInfo,
+						 values[Anum_pg_aoblkdir_zonemap - 1],
+						 nulls[Anum_pg_aoblkdir_zonemap - 1]);
+
 	ItemPointerCopy(&tuple->t_self, &minipageInfo->tupleTid);
 
 	/*
@@ -1173,6 +1479,26 @@ write_minipage(AppendOnlyBlockDirectory *blockDirectory,
 		PointerGetDatum(minipageInfo->minipage);
 	nulls[Anum_pg_aoblkdir_minipage - 1] = false;
 
+	if (heapTupleDesc->natts >= Anum_pg_aoblkdir_zonemap)
+	{
+		AppendOnlyZoneMap *zonemap = minipageInfo->zonemap;
+
+		if (zonemap != NULL)
+		{
+			SET_VARSIZE(zonemap,
+						AppendOnlyZoneMap_Size(minipageInfo->numMinipageEntries,
+											   zonemap->nColumns));
+			zonemap->nEntry = minipageInfo->numMinipageEntries;
+			values[Anum_pg_aoblkdir_zonemap - 1] = PointerGetDatum(zonemap);
+			nulls[Anum_pg_aoblkdir_zonemap - 1] = false;
+		}
+		else
+		{
+			values[Anum_pg_aoblkdir_zonemap - 1] = (Datum) 0;
+			nulls[Anum_pg_aoblkdir_zonemap - 1] = true;
+		}
+	}
+
 	tuple = heaptuple_form_to(heapTupleDesc,
 							  values,
 							  nulls,
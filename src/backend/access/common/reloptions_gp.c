@@ -1002,6 +1002,27 @@ validate_and_adjust_options(StdRdOptions *result,
 			}
 		}
 
+		if (result->compresstype[0] &&
+			(pg_strcasecmp(result->compresstype, "lz4") == 0))
+		{
+#ifndef HAVE_LIBLZ4
+			ereport(ERROR,
+					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+					 errmsg("LZ4 library is not supported by this build"),
+					 errhint("Compile with --with-lz4 to use LZ4 compression.")));
+#endif
+			if (result->compresslevel > 9)
+			{
+				if (validate)
+					ereport(ERROR,
+							(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+							 errmsg("compresslevel=%d is out of range for lz4 (should be in the range 1 to 9)",
+									result->compresslevel)));
+
+				result->compresslevel = setDefaultCompressionLevel(result->compresstype);
+			}
+		}
+
 		if (result->compresstype[0] &&
 			(pg_strcasecmp(result->compresstype, "quicklz") == 0))
 		{
@@ -1204,7 +1225,8 @@ validateAppendOnlyRelOptions(bool ao,
 		(pg_strcasecmp(comptype, "quicklz") == 0 ||
 		 pg_strcasecmp(comptype, "zlib") == 0 ||
 		 pg_strcasecmp(comptype, "rle_type") == 0 ||
-		 pg_strcasecmp(comptype, "zstd") == 0))
+		 pg_strcasecmp(comptype, "zstd") == 0 ||
+		 pg_strcasecmp(comptype, "lz4") == 0))
 	{
 		if (!co &&
 			pg_strcasecmp(comptype, "rle_type") == 0)
@@ -1252,6 +1274,21 @@ validateAppendOnlyRelOptions(bool ao,
 								complevel)));
 		}
 
+		if (comptype && (pg_strcasecmp(comptype, "lz4") == 0))
+		{
+#ifndef HAVE_LIBLZ4
+			ereport(ERROR,
+					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+					 errmsg("LZ4 library is not supported by this build"),
+					 errhint("Compile with --with-lz4 to use LZ4 compression.")));
+#endif
+			if (complevel < 0 || complevel > 9)
+				ereport(ERROR,
+						(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+						 errmsg("compresslevel=%d is out of range for lz4 (should be in the range 1 to 9)",
+								complevel)));
+		}
+
 		if (comptype && (pg_strcasecmp(comptype, "quicklz") == 0))
 		{
 #ifndef HAVE_LIBQUICKLZ
@@ -1298,7 +1335,7 @@ validateAppendOnlyRelOptions(bool ao,
 
 /*
  * if no compressor type was specified, we set to no compression (level 0)
- * otherwise default for both zlib, quicklz, zstd and RLE to level 1.
+ * otherwise default for both zlib, quicklz, zstd, lz4 and RLE to level 1.
  */
 static int
 setDefaultCompressionLevel(char *compresstype)
@@ -17,6 +17,7 @@
 #include "postgres.h"
 
 #include "catalog/pg_opclass.h"
+#include "access/appendonly_zonemap.h"
 #include "catalog/aoblkdir.h"
 #include "catalog/aocatalog.h"
 #include "miscadmin.h"
@@ -28,6 +29,7 @@ AlterTableCreateAoBlkdirTable(Oid relOid, bool is_part_child, bool is_part_paren
 {
 	Relation	rel;
 	TupleDesc	tupdesc;
+	int			natts;
 	IndexInfo  *indexInfo;
 	Oid			classObjectId[3];
 	int16		coloptions[3];
@@ -62,8 +64,15 @@ AlterTableCreateAoBlkdirTable(Oid relOid, bool is_part_child, bool is_part_paren
 		return;
 	}
 
+	/*
+	 * The zonemap column is only added while zone maps are enabled. Block
+	 * directories created otherwise keep the layout of older releases;
+	 * readers and writers of the zone maps check the number of attributes.
+	 */
+	natts = gp_appendonly_zone_maps ? Natts_pg_aoblkdir : Anum_pg_aoblkdir_minipage;
+
 	/* Create a tuple descriptor */
-	tupdesc = CreateTemplateTupleDesc(4, false);
+	tupdesc = CreateTemplateTupleDesc(natts, false);
 	TupleDescInitEntry(tupdesc, (AttrNumber) 1,
 					   "segno",
 					   INT4OID,
@@ -80,6 +89,11 @@ AlterTableCreateAoBlkdirTable(Oid relOid, bool is_part_child, bool is_part_paren
 					   "minipage",
 					   BYTEAOID,
 					   -1, 0);
+	if (natts >= Anum_pg_aoblkdir_zonemap)
+		TupleDescInitEntry(tupdesc, (AttrNumber) Anum_pg_aoblkdir_zonemap,
+						   "zonemap",
+						   BYTEAOID,
+						   -1, 0);
 
 	/*
 	 * We don't want any toast columns here.
@@ -88,6 +102,8 @@ AlterTableCreateAoBlkdirTable(Oid relOid, bool is_part_child, bool is_part_paren
 	tupdesc->attrs[1]->attstorage = 'p';
 	tupdesc->attrs[2]->attstorage = 'p';
 	tupdesc->attrs[3]->attstorage = 'p';
+	if (natts >= Anum_pg_aoblkdir_zonemap)
+		tupdesc->attrs[4]->attstorage = 'p';
 
 	/*
 	 * Create index on segno, first_row_no.
@@ -519,6 +519,9 @@ compresstype_is_valid(char *comptype)
 #endif
 #ifdef HAVE_LIBZSTD
 			"zstd",
+#endif
+#ifdef HAVE_LIBLZ4
+			"lz4",
 #endif
 			"rle_type", "none"};
 
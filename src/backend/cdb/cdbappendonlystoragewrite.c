@@ -1236,7 +1236,9 @@ AppendOnlyStorageWrite_CompressAppend(AppendOnlyStorageWrite *storageWrite,
 			 * rle_type compression.  The sourceData is already encoded with
 			 * RLE.  It is further compressed with bulk compression.
 			 * Corresponding datumstream version is
-			 * DatumStreamVersion_Dense_Enhanced.
+			 * DatumStreamVersion_Dense_Enhanced.  It is also used for the
+			 * dictionary encoded blocks of columns with a bulk compression
+			 * type, whose version is DatumStreamVersion_Dense_Dictionary.
 			 */
 			AppendOnlyStorageFormat_MakeBulkDenseContentHeader
 				(header,
@@ -20,6 +20,11 @@
 #include "utils/guc.h"
 #include "miscadmin.h"
 
+/* GUC */
+int			gp_appendonly_read_ahead = 0;
+
+static void BufferedReadPrefetch(
+			   BufferedRead *bufferedRead);
 static void BufferedReadIo(
 			   BufferedRead *bufferedRead);
 static uint8 *BufferedReadUseBeforeBuffer(
@@ -106,6 +111,11 @@ BufferedReadInit(
 	 */
 	bufferedRead->haveTemporaryLimitInEffect = false;
 	bufferedRead->temporaryLimitFileLen = 0;
+
+	/*
+	 * Read-ahead support.
+	 */
+	bufferedRead->prefetchPosition = 0;
 }
 
 /*
@@ -152,6 +162,65 @@ BufferedReadSetFile(
 	}
 }
 
+/*
+ * Ask the kernel to read ahead the gp_appendonly_read_ahead large reads that
+ * follow the current one, so that they are in flight while the current one
+ * is read and its blocks are processed.
+ *
+ * We use posix_fadvise(POSIX_FADV_WILLNEED) through FilePrefetch(), like
+ * effective_io_concurrency does for bitmap heap scans.  Only the ranges not
+ * advised yet are passed down, so in steady state each large read advises
+ * one more large read at the end of the window.
+ */
+static void
+BufferedReadPrefetch(
+					 BufferedRead *bufferedRead)
+{
+#ifdef USE_PREFETCH
+	int64		inEffectFileLen;
+	int64		windowBegin;
+	int64		windowEnd;
+
+	if (gp_appendonly_read_ahead <= 0)
+		return;
+
+	if (bufferedRead->haveTemporaryLimitInEffect)
+		inEffectFileLen = bufferedRead->temporaryLimitFileLen;
+	else
+		inEffectFileLen = bufferedRead->fileLen;
+
+	windowBegin = bufferedRead->largeReadPosition + bufferedRead->largeReadLen;
+	windowEnd = windowBegin +
+		(int64) gp_appendonly_read_ahead * bufferedRead->maxLargeReadLen;
+	if (windowEnd > inEffectFileLen)
+		windowEnd = inEffectFileLen;
+
+	/*
+	 * After a seek, whatever was advised before has nothing to do with the
+	 * new window.
+	 */
+	if (bufferedRead->prefetchPosition < windowBegin ||
+		bufferedRead->prefetchPosition > windowEnd)
+		bufferedRead->prefetchPosition = windowBegin;
+
+	while (bufferedRead->prefetchPosition < windowEnd)
+	{
+		int32		amount;
+
+		if (windowEnd - bufferedRead->prefetchPosition > bufferedRead->maxLargeReadLen)
+			amount = bufferedRead->maxLargeReadLen;
+		else
+			amount = (int32) (windowEnd - bufferedRead->prefetchPosition);
+
+		(void) FilePrefetch(bufferedRead->file,
+							bufferedRead->prefetchPosition,
+							amount);
+
+		bufferedRead->prefetchPosition += amount;
+	}
+#endif
+}
+
 /*
  * Perform a large read i/o.
  */
@@ -162,6 +231,8 @@ BufferedReadIo(
 	int32		largeReadLen;
 	uint8	   *largeReadMemory;
 	int32		offset;
+	instr_time	starttime;
+	instr_time	endtime;
 
 	largeReadLen = bufferedRead->largeReadLen;
 	Assert(bufferedRead->largeReadLen > 0);
@@ -190,6 +261,10 @@ BufferedReadIo(
 	}
 #endif
 
+	BufferedReadPrefetch(bufferedRead);
+
+	INSTR_TIME_SET_CURRENT(starttime);
+
 	offset = 0;
 	while (largeReadLen > 0)
 	{
@@ -237,6 +312,11 @@ BufferedReadIo(
 		offset += actualLen;
 	}
 
+	INSTR_TIME_SET_CURRENT(endtime);
+	INSTR_TIME_ACCUM_DIFF(bufferedRead->stats.waitTime, endtime, starttime);
+	bufferedRead->stats.reads++;
+	bufferedRead->stats.bytes += bufferedRead->largeReadLen;
+
 	if (VacuumCostActive)
 		VacuumCostBalance += VacuumCostPageMiss;
 }
@@ -410,6 +490,13 @@ BufferedReadSetTemporaryRange(
 		}
 	}
 
+	/*
+	 * Set the limit before doing any read, so that the read-ahead stays
+	 * within the range.
+	 */
+	bufferedRead->haveTemporaryLimitInEffect = true;
+	bufferedRead->temporaryLimitFileLen = afterFileOffset;
+
 	if (newReadNeeded)
 	{
 		int64		remainingFileLen;
@@ -443,10 +530,6 @@ BufferedReadSetTemporaryRange(
 		if (bufferedRead->largeReadLen > 0)
 			BufferedReadIo(bufferedRead);
 	}
-
-	bufferedRead->haveTemporaryLimitInEffect = true;
-	bufferedRead->temporaryLimitFileLen = afterFileOffset;
-
 }
 
 /*
@@ -675,6 +758,24 @@ BufferedReadCompleteFile(
 
 	bufferedRead->largeReadPosition = 0;
 	bufferedRead->largeReadLen = 0;
+
+	bufferedRead->prefetchPosition = 0;
+}
+
+/*
+ * Add the I/O statistics of a BufferedRead to the given statistics.
+ */
+void
+BufferedReadAccumStats(
+					   BufferedReadStats *stats,
+					   BufferedRead *bufferedRead)
+{
+	Assert(stats != NULL);
+	Assert(bufferedRead != NULL);
+
+	stats->reads += bufferedRead->stats.reads;
+	stats->bytes += bufferedRead->stats.bytes;
+	INSTR_TIME_ADD(stats->waitTime, bufferedRead->stats.waitTime);
 }
 
 
@@ -51,6 +51,8 @@ bool gp_use_legacy_hashops = false;
 /* local function declarations */
 static int	ispowof2(int numsegs);
 static inline int32 jump_consistent_hash(uint64 key, int32 num_segments);
+static CdbHashFuncKind cdbhash_func_kind(Oid funcid);
+static inline uint32 cdbhash_datum(CdbHash *h, int attidx, Datum datum);
 
 /*================================================================
  *
@@ -97,6 +99,7 @@ makeCdbHash(int numsegs, int natts, Oid *hashfuncs)
 
 	/* Load hash function info */
 	h->hashfuncs = (FmgrInfo *) palloc(natts * sizeof(FmgrInfo));
+	h->hashkinds = (CdbHashFuncKind *) palloc(natts * sizeof(CdbHashFuncKind));
 	for (i = 0; i < natts; i++)
 	{
 		Oid			funcid = hashfuncs[i];
@@ -105,6 +108,7 @@ makeCdbHash(int numsegs, int natts, Oid *hashfuncs)
 			is_legacy_hash = true;
 
 		fmgr_info(funcid, &h->hashfuncs[i]);
+		h->hashkinds[i] = cdbhash_func_kind(funcid);
 	}
 	h->natts = natts;
 	h->is_legacy_hash = is_legacy_hash;
@@ -162,6 +166,8 @@ void freeCdbHash(CdbHash *hash)
 	{
 		if (hash->hashfuncs)
 			pfree(hash->hashfuncs);
+		if (hash->hashkinds)
+			pfree(hash->hashkinds);
 		pfree(hash);
 	}
 }
@@ -198,25 +204,7 @@ cdbhash(CdbHash *h, int attno, Datum datum, bool isnull)
 		hashkey = (hashkey << 1) | ((hashkey & 0x80000000) ? 1 : 0);
 
 		if (!isnull)
-		{
-			FunctionCallInfoData fcinfo;
-			uint32		hkey;
-
-			InitFunctionCallInfoData(fcinfo, &h->hashfuncs[attno - 1], 1,
-									 InvalidOid,
-									 NULL, NULL);
-
-			fcinfo.arg[0] = datum;
-			fcinfo.argnull[0] = false;
-
-			hkey = DatumGetUInt32(FunctionCallInvoke(&fcinfo));
-
-			/* Check for null result, since caller is clearly not expecting one */
-			if (fcinfo.isnull)
-				elog(ERROR, "function %u returned NULL", fcinfo.flinfo->fn_oid);
-
-			hashkey ^= hkey;
-		}
+			hashkey ^= cdbhash_datum(h, attno - 1, datum);
 	}
 	else
 	{
@@ -248,6 +236,107 @@ cdbhash(CdbHash *h, int attno, Datum datum, bool isnull)
 	h->hash = hashkey;
 }
 
+/*
+ * Compute the hash value of a non-NULL datum of the given distribution key
+ * column, with the column's (non-legacy) hash function.
+ *
+ * The hash functions of the common distribution key types are computed
+ * inline, which avoids the fmgr call per datum. They must return the same
+ * values as the functions they stand in for, see hashfunc.c.
+ */
+static inline uint32
+cdbhash_datum(CdbHash *h, int attidx, Datum datum)
+{
+	switch (h->hashkinds[attidx])
+	{
+		case CDBHASH_FUNC_INT2:
+			return DatumGetUInt32(hash_uint32((int32) DatumGetInt16(datum)));
+
+		case CDBHASH_FUNC_INT4:
+			return DatumGetUInt32(hash_uint32(DatumGetInt32(datum)));
+
+		case CDBHASH_FUNC_INT8:
+			{
+				int64		val = DatumGetInt64(datum);
+				uint32		lohalf = (uint32) val;
+				uint32		hihalf = (uint32) (val >> 32);
+
+				lohalf ^= (val >= 0) ? hihalf : ~hihalf;
+
+				return DatumGetUInt32(hash_uint32(lohalf));
+			}
+
+		case CDBHASH_FUNC_OID:
+			return DatumGetUInt32(hash_uint32((uint32) DatumGetObjectId(datum)));
+
+		case CDBHASH_FUNC_TEXT:
+			{
+				text	   *key = DatumGetTextPP(datum);
+				uint32		hkey;
+
+				hkey = DatumGetUInt32(hash_any((unsigned char *) VARDATA_ANY(key),
+											   VARSIZE_ANY_EXHDR(key)));
+
+				/* Avoid leaking memory for toasted inputs */
+				if ((Pointer) key != DatumGetPointer(datum))
+					pfree(key);
+
+				return hkey;
+			}
+
+		case CDBHASH_FUNC_FMGR:
+			break;
+	}
+
+	{
+		FunctionCallInfoData fcinfo;
+		uint32		hkey;
+
+		InitFunctionCallInfoData(fcinfo, &h->hashfuncs[attidx], 1,
+								 InvalidOid,
+								 NULL, NULL);
+
+		fcinfo.arg[0] = datum;
+		fcinfo.argnull[0] = false;
+
+		hkey = DatumGetUInt32(FunctionCallInvoke(&fcinfo));
+
+		/* Check for null result, since caller is clearly not expecting one */
+		if (fcinfo.isnull)
+			elog(ERROR, "function %u returned NULL", fcinfo.flinfo->fn_oid);
+
+		return hkey;
+	}
+}
+
+/*
+ * Which of the hash functions computed inline by cdbhash_datum() is funcid,
+ * if any.
+ */
+static CdbHashFuncKind
+cdbhash_func_kind(Oid funcid)
+{
+	switch (funcid)
+	{
+		case F_HASHINT2:
+			return CDBHASH_FUNC_INT2;
+		case F_HASHINT4:
+			return CDBHASH_FUNC_INT4;
+		case F_HASHINT8:
+			return CDBHASH_FUNC_INT8;
+#ifdef HAVE_INT64_TIMESTAMP
+		case F_TIMESTAMP_HASH:
+			return CDBHASH_FUNC_INT8;
+#endif
+		case F_HASHOID:
+			return CDBHASH_FUNC_OID;
+		case F_HASHTEXT:
+			return CDBHASH_FUNC_TEXT;
+		default:
+			return CDBHASH_FUNC_FMGR;
+	}
+}
+
 /*
  * Reduce the hash to a segment number.
  */
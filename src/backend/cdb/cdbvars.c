@@ -220,6 +220,10 @@ bool		gp_interconnect_aggressive_retry = true;	/* fast-track app-level
 
 bool		gp_interconnect_full_crc = false;	/* sanity check UDP data. */
 
+bool		gp_interconnect_batch_syscalls = false;	/* sendmmsg/recvmmsg */
+
+bool		gp_interconnect_compression = false;	/* LZ4 data packets */
+
 bool		gp_interconnect_log_stats = false;	/* emit stats at log-level */
 
 bool		gp_interconnect_cache_future_packets = true;
@@ -25,6 +25,9 @@
 #include "postgres.h"
 
 #include <pthread.h>
+#ifdef HAVE_LIBLZ4
+#include <lz4.h>
+#endif
 
 #include "access/transam.h"
 #include "access/xact.h"
@@ -138,6 +141,12 @@ int
 /* 1/4 sec in msec */
 #define RX_THREAD_POLL_TIMEOUT (250)
 
+/*
+ * Maximum number of packets moved with one sendmmsg() or recvmmsg() call,
+ * see gp_interconnect_batch_syscalls.
+ */
+#define IC_MAX_PKTS_PER_SYSCALL (16)
+
 /*
  * Flags definitions for flag-field of UDP-messages
  *
@@ -151,6 +160,15 @@ int
 #define UDPIC_FLAGS_DISORDER    		(32)
 #define UDPIC_FLAGS_DUPLICATE   		(64)
 #define UDPIC_FLAGS_CAPACITY    		(128)
+#define UDPIC_FLAGS_COMPRESSED			(256)
+
+/*
+ * A data packet is sent compressed only if that saves at least 1/8 of its
+ * payload. After one that does not, the next IC_COMPRESSION_RETRY_INTERVAL
+ * packets of the connection are sent without trying.
+ */
+#define IC_COMPRESSION_MIN_SAVING		(8)
+#define IC_COMPRESSION_RETRY_INTERVAL	(32)
 
 /*
  * ConnHtabBin
@@ -267,6 +285,12 @@ struct ReceiveControlInfo
 	 */
 	icpkthdr   *disorderBuffer;
 
+	/*
+	 * Buffer the payload of a compressed packet is decompressed into, while
+	 * its tuple chunks are processed. Allocated on first use.
+	 */
+	char	   *decompressBuffer;
+
 	/* The last interconnect instance id which is torn down. */
 	uint32		lastTornIcId;
 
@@ -313,10 +337,11 @@ struct RxBufferPool
 /*
  * The buffer pool used for keeping data packets.
  *
- * maxCount is set to 1 to make sure there is always a buffer
- * for picking packets from OS buffer.
+ * maxCount starts at IC_MAX_PKTS_PER_SYSCALL to make sure the rx thread
+ * always has a buffer for each packet it picks from the OS buffer in one
+ * recvmmsg() call, see InitMotionUDPIFC().
  */
-static RxBufferPool rx_buffer_pool = {1, 0, NULL};
+static RxBufferPool rx_buffer_pool = {IC_MAX_PKTS_PER_SYSCALL, 0, NULL};
 
 /*
  * SendBufferPool
@@ -365,6 +390,9 @@ struct SendControlInfo
 	/* slow start threshold */
 	float		ssthresh;
 
+	/* LZ4 state and output buffer for compressing packets, or NULL */
+	void	   *compressState;
+	char	   *compressBuffer;
 };
 
 /*
@@ -629,6 +657,11 @@ typedef struct ICStatistics
 	int32		duplicatedPktNum;
 	int32		recvAckNum;
 	int32		statusQueryMsgNum;
+	int32		sndSyscallNum;
+	int32		recvSyscallNum;
+	int32		recvDatagramNum;
+	int32		compressedPktNum;
+	uint64		compressionSavedBytes;
 } ICStatistics;
 
 /* Statistics for UDP interconnect. */
@@ -738,6 +771,8 @@ static void checkQDConnectionAlive(void);
 
 
 static void *rxThreadFunc(void *arg);
+static int	receivePackets(icpkthdr **pkts, int npkts, struct sockaddr_storage *peers, socklen_t *peerlens, int *lens);
+static bool handleRxPacket(icpkthdr *pkt, int read_count, struct sockaddr_storage *peer, socklen_t peerlen);
 
 static bool handleMismatch(icpkthdr *pkt, struct sockaddr_storage *peer, int peer_len);
 static void handleAckedPacket(MotionConn *ackConn, ICBuffer *buf, uint64 now);
@@ -749,10 +784,16 @@ static bool handleAckForDuplicatePkt(MotionConn *conn, icpkthdr *pkt);
 static bool handleAckForDisorderPkt(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, MotionConn *conn, icpkthdr *pkt);
 
 static inline void prepareXmit(MotionConn *conn);
+static bool compressXmit(MotionConn *conn);
+static void decompressRxPacket(MotionConn *conn);
 static inline void addCRC(icpkthdr *pkt);
 static inline bool checkCRC(icpkthdr *pkt);
 static void sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, MotionConn *conn);
 static void sendOnce(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, ICBuffer *buf, MotionConn *conn);
+static void sendBatch(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, ICBuffer **bufs, int nbufs, MotionConn *conn);
+static bool handleSendError(MotionConn *conn, const char *syscall_name);
+static void checkTransmitLength(MotionConn *conn, icpkthdr *pkt, int n, const char *syscall_name);
+static inline bool useBatchedSyscalls(void);
 static inline uint64 computeExpirationPeriod(MotionConn *conn, uint32 retry);
 
 static ICBuffer *getSndBuffer(MotionConn *conn);
@@ -1565,19 +1606,25 @@ InitMotionUDPIFC(int *listenerSocketFd, uint16 *listenerPort)
 
 	/* allocate a buffer for sending disorder messages */
 	rx_control_info.disorderBuffer = palloc0(MIN_PACKET_SIZE);
+	rx_control_info.decompressBuffer = NULL;
 	rx_control_info.lastDXatId = InvalidTransactionId;
 	rx_control_info.lastTornIcId = 0;
 	initCursorICHistoryTable(&rx_control_info.cursorHistoryTable);
 
-	/* Initialize receive buffer pool */
+	/*
+	 * Initialize receive buffer pool, leaving room for the buffers the rx
+	 * thread holds to read packets into.
+	 */
 	rx_buffer_pool.count = 0;
-	rx_buffer_pool.maxCount = 1;
+	rx_buffer_pool.maxCount = IC_MAX_PKTS_PER_SYSCALL;
 	rx_buffer_pool.freeList = NULL;
 
 	/* Initialize send control data */
 	snd_control_info.cwnd = 0;
 	snd_control_info.minCwnd = 0;
 	snd_control_info.ackBuffer = palloc0(MIN_PACKET_SIZE);
+	snd_control_info.compressState = NULL;
+	snd_control_info.compressBuffer = NULL;
 
 	MemoryContextSwitchTo(old);
 
@@ -2820,6 +2867,7 @@ startOutgoingUDPConnections(ChunkTransportState *transportStates,
 			conn->tupleCount = 0;
 			conn->msgSize = sizeof(conn->conn_info);
 			conn->sentSeq = 0;
+			conn->compressSkip = 0;
 			conn->receivedAckSeq = 0;
 			conn->consumedSeq = 0;
 			conn->pBuff = (uint8 *) conn->curBuff->pkt;
@@ -3761,7 +3809,9 @@ TeardownUDPIFCInterconnect_Internal(ChunkTransportState *transportStates,
 		 " freebuf_avg %f "
 		 "mismatch_pkt_num %d disordered_pkt_num %d duplicated_pkt_num %d"
 		 " rtt/dev [" UINT64_FORMAT "/" UINT64_FORMAT ", %f/%f, " UINT64_FORMAT "/" UINT64_FORMAT "] "
-		 " cwnd %f status_query_msg_num %d",
+		 " cwnd %f status_query_msg_num %d"
+		 " snd_pkts_per_syscall %f recv_pkts_per_syscall %f"
+		 " compressed_pkt_num %d compression_saved_bytes " UINT64_FORMAT,
 		 ic_control_info.isSender, isReceiver,
 		 Gp_interconnect_snd_queue_depth, Gp_interconnect_queue_depth, Gp_max_packet_size,
 		 UNACK_QUEUE_RING_SLOTS_NUM, TIMER_SPAN, DEFAULT_RTT,
@@ -3774,7 +3824,12 @@ TeardownUDPIFCInterconnect_Internal(ChunkTransportState *transportStates,
 		 (double) ((double) ic_statistics.totalBuffers) / ((double) ic_statistics.bufferCountingTime),
 		 ic_statistics.mismatchNum, ic_statistics.disorderedPktNum, ic_statistics.duplicatedPktNum,
 		 (minRtt == ~((uint64) 0) ? 0 : minRtt), (minDev == ~((uint64) 0) ? 0 : minDev), avgRtt, avgDev, maxRtt, maxDev,
-		 snd_control_info.cwnd, ic_statistics.statusQueryMsgNum);
+		 snd_control_info.cwnd, ic_statistics.statusQueryMsgNum,
+		 (ic_statistics.sndSyscallNum > 0 ?
+		  (double) ic_statistics.sndPktNum / (double) ic_statistics.sndSyscallNum : 0.0),
+		 (ic_statistics.recvSyscallNum > 0 ?
+		  (double) ic_statistics.recvDatagramNum / (double) ic_statistics.recvSyscallNum : 0.0),
+		 ic_statistics.compressedPktNum, ic_statistics.compressionSavedBytes);
 
 	ic_control_info.isSender = false;
 	memset(&ic_statistics, 0, sizeof(ICStatistics));
@@ -3847,6 +3902,55 @@ prepareRxConnForRead(MotionConn *conn)
 	conn->recvBytes = conn->msgSize;
 }
 
+/*
+ * decompressRxPacket
+ * 		Decompress the packet prepared for reading on conn, if it is
+ * 		compressed.
+ *
+ * The tuple chunks are then read from the decompression buffer. That is safe
+ * to share among the connections, because the chunks of a packet are all
+ * processed before the next packet is read.
+ *
+ * Must be called with ic_control_info.lock UNLOCKED.
+ */
+static void
+decompressRxPacket(MotionConn *conn)
+{
+	icpkthdr   *pkt = (icpkthdr *) conn->pBuff;
+
+	if ((pkt->flags & UDPIC_FLAGS_COMPRESSED) == 0)
+		return;
+
+#ifdef HAVE_LIBLZ4
+	{
+		int			n;
+
+		if (rx_control_info.decompressBuffer == NULL)
+			rx_control_info.decompressBuffer =
+				MemoryContextAlloc(ic_control_info.memContext, Gp_max_packet_size);
+
+		memcpy(rx_control_info.decompressBuffer, pkt, sizeof(icpkthdr));
+		n = LZ4_decompress_safe((char *) pkt + sizeof(icpkthdr),
+								rx_control_info.decompressBuffer + sizeof(icpkthdr),
+								pkt->len - sizeof(icpkthdr),
+								Gp_max_packet_size - sizeof(icpkthdr));
+		if (n < 0)
+			ereport(ERROR,
+					(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+					 errmsg("interconnect error: could not decompress packet [seq %d] from %s",
+							pkt->seq, conn->remoteHostAndPort)));
+
+		conn->msgPos = (uint8 *) rx_control_info.decompressBuffer;
+		conn->msgSize = sizeof(icpkthdr) + n;
+		conn->recvBytes = conn->msgSize;
+	}
+#else
+	ereport(ERROR,
+			(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+			 errmsg("interconnect error: received a compressed packet, but LZ4 is not supported by this build")));
+#endif
+}
+
 /*
  * receiveChunksUDPIFC
  * 		Receive chunks from the senders
@@ -3907,6 +4011,7 @@ receiveChunksUDPIFC(ChunkTransportState *pTransportStates, ChunkTransportStateEn
 
 			elog(DEBUG2, "got data with length %d", rxconn->recvBytes);
 			/* successfully read into this connection's buffer. */
+			decompressRxPacket(rxconn);
 			tcItem = RecvTupleChunk(rxconn, pTransportStates);
 
 			if (!directed)
@@ -4048,6 +4153,7 @@ RecvTupleChunkFromAnyUDPIFC_Internal(ChunkTransportState *transportStates,
 	{
 		pthread_mutex_unlock(&ic_control_info.lock);
 
+		decompressRxPacket(conn);
 		tcItem = RecvTupleChunk(conn, transportStates);
 		*srcRoute = conn->route;
 		pEntry->scanStart = index + 1;
@@ -4166,6 +4272,7 @@ RecvTupleChunkFromUDPIFC_Internal(ChunkTransportState *transportStates,
 
 		TupleChunkListItem tcItem = NULL;
 
+		decompressRxPacket(conn);
 		tcItem = RecvTupleChunk(conn, transportStates);
 
 		return tcItem;
@@ -4675,6 +4782,156 @@ prepareXmit(MotionConn *conn)
 	}
 }
 
+/*
+ * compressXmit
+ * 		Compress the payload of the data packet about to be sent on conn.
+ *
+ * Returns true if the payload in conn->pBuff was replaced with its compressed
+ * form, and conn->msgSize adjusted. Packets that do not compress well make
+ * the connection skip compressing for a while, so incompressible streams pay
+ * for one attempt every IC_COMPRESSION_RETRY_INTERVAL packets only.
+ */
+static bool
+compressXmit(MotionConn *conn)
+{
+#ifdef HAVE_LIBLZ4
+	int			payloadSize = conn->msgSize - sizeof(icpkthdr);
+	int			n;
+
+	if (!gp_interconnect_compression)
+		return false;
+
+	if (conn->compressSkip > 0)
+	{
+		conn->compressSkip--;
+		return false;
+	}
+
+	if (snd_control_info.compressState == NULL)
+	{
+		snd_control_info.compressState =
+			MemoryContextAlloc(ic_control_info.memContext, LZ4_sizeofState());
+		snd_control_info.compressBuffer =
+			MemoryContextAlloc(ic_control_info.memContext, Gp_max_packet_size);
+	}
+
+	n = LZ4_compress_fast_extState(snd_control_info.compressState,
+								   (char *) conn->pBuff + sizeof(icpkthdr),
+								   snd_control_info.compressBuffer,
+								   payloadSize,
+								   payloadSize - payloadSize / IC_COMPRESSION_MIN_SAVING,
+								   1);
+	if (n <= 0)
+	{
+		conn->compressSkip = IC_COMPRESSION_RETRY_INTERVAL;
+		return false;
+	}
+
+	memcpy(conn->pBuff + sizeof(icpkthdr), snd_control_info.compressBuffer, n);
+	conn->msgSize = sizeof(icpkthdr) + n;
+
+	ic_statistics.compressedPktNum++;
+	ic_statistics.compressionSavedBytes += payloadSize - n;
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+/*
+ * useBatchedSyscalls
+ * 		Whether to move several packets per sendmmsg() or recvmmsg() call.
+ *
+ * The fault injection of assert-enabled builds wraps sendto() and recvfrom(),
+ * so the single-packet calls are used while it is active.
+ */
+static inline bool
+useBatchedSyscalls(void)
+{
+#ifdef USE_ASSERT_CHECKING
+	if (udp_testmode)
+		return false;
+#endif
+	return gp_interconnect_batch_syscalls;
+}
+
+/*
+ * handleSendError
+ * 		Handle a failed send of a data packet of conn.
+ *
+ * Returns true if the send should be retried right away, and false if the
+ * packet is left to the retransmission logic. Errors that retransmitting
+ * cannot help are reported with ERROR.
+ */
+static bool
+handleSendError(MotionConn *conn, const char *syscall_name)
+{
+	if (errno == EINTR)
+		return true;
+
+	if (errno == EAGAIN)		/* no space ? not an error. */
+		return false;
+
+	/*
+	 * If Linux iptables (nf_conntrack?) drops an outgoing packet, it may
+	 * return an EPERM to the application. This might be simply because of
+	 * traffic shaping or congestion, so ignore it.
+	 */
+	if (errno == EPERM)
+	{
+		ereport(LOG,
+				(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+				 errmsg("Interconnect error writing an outgoing packet: %m"),
+				 errdetail("error during %s() for Remote Connection: contentId=%d at %s",
+						   syscall_name, conn->remoteContentId, conn->remoteHostAndPort)));
+		return false;
+	}
+
+	/*
+	 * If the OS can detect an MTU issue on the host network interfaces, we 
+	 * would get EMSGSIZE here. So, bail with a HINT about checking MTU.
+	 */
+	if (errno == EMSGSIZE)
+	{
+		ereport(ERROR, (errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+						errmsg("Interconnect error writing an outgoing packet: %m"),
+						errdetail("error during %s() call (error:%d).\n"
+								  "For Remote Connection: contentId=%d at %s",
+								  syscall_name, errno, conn->remoteContentId,
+								  conn->remoteHostAndPort),
+						errhint("check if interface MTU is equal across the cluster and lower than gp_max_packet_size")));
+	}
+
+	ereport(ERROR, (errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+					errmsg("Interconnect error writing an outgoing packet: %m"),
+					errdetail("error during %s() call (error:%d).\n"
+							  "For Remote Connection: contentId=%d at %s",
+							  syscall_name, errno, conn->remoteContentId,
+							  conn->remoteHostAndPort)));
+	return false;				/* not reached */
+}
+
+/*
+ * checkTransmitLength
+ * 		Log a short transmit of a packet, which was sent with n bytes.
+ */
+static void
+checkTransmitLength(MotionConn *conn, icpkthdr *pkt, int n, const char *syscall_name)
+{
+	if (n != pkt->len)
+	{
+		if (DEBUG1 >= log_min_messages)
+			write_log("Interconnect error writing an outgoing packet [seq %d]: short transmit (given %d sent %d) during %s() call."
+					  "For Remote Connection: contentId=%d at %s", pkt->seq, pkt->len, n,
+					  syscall_name, conn->remoteContentId,
+					  conn->remoteHostAndPort);
+#ifdef AMS_VERBOSE_LOGGING
+		logPkt("PKT DETAILS ", pkt);
+#endif
+	}
+}
+
 /*
  * sendOnce
  * 		Send a packet.
@@ -4699,64 +4956,78 @@ xmit_retry:
 			   (struct sockaddr *) &conn->peer, conn->peer_len);
 	if (n < 0)
 	{
-		if (errno == EINTR)
+		if (handleSendError(conn, "sendto"))
 			goto xmit_retry;
+		return;
+	}
 
-		if (errno == EAGAIN)	/* no space ? not an error. */
-			return;
+	checkTransmitLength(conn, buf->pkt, n, "sendto");
+}
 
-		/*
-		 * If Linux iptables (nf_conntrack?) drops an outgoing packet, it may
-		 * return an EPERM to the application. This might be simply because of
-		 * traffic shaping or congestion, so ignore it.
-		 */
-		if (errno == EPERM)
+/*
+ * sendBatch
+ * 		Send the packets of the given buffers, all of which belong to conn.
+ *
+ * When batched system calls are in use, the packets are handed to the kernel
+ * with as few sendmmsg() calls as it accepts; otherwise each one is sent with
+ * sendOnce().
+ */
+static void
+sendBatch(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, ICBuffer **bufs, int nbufs, MotionConn *conn)
+{
+	int			i;
+
+	Assert(nbufs > 0 && nbufs <= IC_MAX_PKTS_PER_SYSCALL);
+
+#ifdef HAVE_SENDMMSG
+	if (nbufs > 1 && useBatchedSyscalls())
+	{
+		struct mmsghdr msgs[IC_MAX_PKTS_PER_SYSCALL];
+		struct iovec iovs[IC_MAX_PKTS_PER_SYSCALL];
+		int			sent = 0;
+
+		MemSet(msgs, 0, sizeof(msgs));
+		for (i = 0; i < nbufs; i++)
 		{
-			ereport(LOG,
-					(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
-					 errmsg("Interconnect error writing an outgoing packet: %m"),
-					 errdetail("error during sendto() for Remote Connection: contentId=%d at %s",
-							   conn->remoteContentId, conn->remoteHostAndPort)));
-			return;
+			iovs[i].iov_base = bufs[i]->pkt;
+			iovs[i].iov_len = bufs[i]->pkt->len;
+			msgs[i].msg_hdr.msg_name = &conn->peer;
+			msgs[i].msg_hdr.msg_namelen = conn->peer_len;
+			msgs[i].msg_hdr.msg_iov = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
 		}
 
-		/*
-		 * If the OS can detect an MTU issue on the host network interfaces, we 
-		 * would get EMSGSIZE here. So, bail with a HINT about checking MTU.
-		 */
-		if (errno == EMSGSIZE)
+		while (sent < nbufs)
 		{
-			ereport(ERROR, (errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
-							errmsg("Interconnect error writing an outgoing packet: %m"),
-							errdetail("error during sendto() call (error:%d).\n"
-								  "For Remote Connection: contentId=%d at %s",
-								  errno, conn->remoteContentId,
-								  conn->remoteHostAndPort),
-							errhint("check if interface MTU is equal across the cluster and lower than gp_max_packet_size")));
-		}
+			int			n;
 
-		ereport(ERROR, (errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
-						errmsg("Interconnect error writing an outgoing packet: %m"),
-						errdetail("error during sendto() call (error:%d).\n"
-								  "For Remote Connection: contentId=%d at %s",
-								  errno, conn->remoteContentId,
-								  conn->remoteHostAndPort)));
-		/* not reached */
+			n = sendmmsg(pEntry->txfd, msgs + sent, nbufs - sent, 0);
+			if (n < 0)
+			{
+				if (handleSendError(conn, "sendmmsg"))
+					continue;
+
+				/*
+				 * The packets not sent are in the unack queue already, and
+				 * get retransmitted like a single packet dropped here would.
+				 */
+				return;
+			}
+			ic_statistics.sndSyscallNum++;
+
+			for (i = sent; i < sent + n; i++)
+				checkTransmitLength(conn, bufs[i]->pkt, msgs[i].msg_len, "sendmmsg");
+			sent += n;
+		}
+		return;
 	}
+#endif
 
-	if (n != buf->pkt->len)
+	for (i = 0; i < nbufs; i++)
 	{
-		if (DEBUG1 >= log_min_messages)
-			write_log("Interconnect error writing an outgoing packet [seq %d]: short transmit (given %d sent %d) during sendto() call."
-					  "For Remote Connection: contentId=%d at %s", buf->pkt->seq, buf->pkt->len, n,
-					  conn->remoteContentId,
-					  conn->remoteHostAndPort);
-#ifdef AMS_VERBOSE_LOGGING
-		logPkt("PKT DETAILS ", buf->pkt);
-#endif
+		sendOnce(transportStates, pEntry, bufs[i], conn);
+		ic_statistics.sndSyscallNum++;
 	}
-
-	return;
 }
 
 
@@ -4868,6 +5139,9 @@ handleStopMsgs(ChunkTransportState *transportStates, ChunkTransportStateEntry *p
 static void
 sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, MotionConn *conn)
 {
+	ICBuffer   *batch[IC_MAX_PKTS_PER_SYSCALL];
+	int			nbatch = 0;
+
 	while (conn->capacity > 0 && icBufferListLength(&conn->sndQueue) > 0)
 	{
 		ICBuffer   *buf = NULL;
@@ -4906,9 +5180,9 @@ sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEnt
 		}
 
 		/*
-		 * Note the place of sendOnce here. If we send before appending it to
+		 * Note the place of sendBatch here. If we send before appending it to
 		 * the unack queue and putting it into unack queue ring, and there is
-		 * a network error occurred in the sendOnce function, error message
+		 * a network error occurred in the sendBatch function, error message
 		 * will be output. In the time of error message output, interrupts is
 		 * potentially checked, if there is a pending query cancel, it will
 		 * lead to a dangled buffer (memory leak).
@@ -4917,7 +5191,12 @@ sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEnt
 		updateStats(TPE_DATA_PKT_SEND, conn, buf->pkt);
 #endif
 
-		sendOnce(transportStates, pEntry, buf, conn);
+		batch[nbatch++] = buf;
+		if (nbatch == IC_MAX_PKTS_PER_SYSCALL)
+		{
+			sendBatch(transportStates, pEntry, batch, nbatch, conn);
+			nbatch = 0;
+		}
 		ic_statistics.sndPktNum++;
 
 #ifdef AMS_VERBOSE_LOGGING
@@ -4926,6 +5205,9 @@ sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEnt
 
 		buf->conn->sentSeq = buf->pkt->seq;
 	}
+
+	if (nbatch > 0)
+		sendBatch(transportStates, pEntry, batch, nbatch, conn);
 }
 
 /*
@@ -5590,7 +5872,14 @@ SendChunkUDPIFC(ChunkTransportState *transportStates,
 
 	/* try to send it */
 
-	prepareXmit(conn);
+	if (compressXmit(conn))
+	{
+		conn->conn_info.flags |= UDPIC_FLAGS_COMPRESSED;
+		prepareXmit(conn);
+		conn->conn_info.flags &= ~UDPIC_FLAGS_COMPRESSED;
+	}
+	else
+		prepareXmit(conn);
 
 	icBufferListAppend(&conn->sndQueue, conn->curBuff);
 	sendBuffers(transportStates, pEntry, conn);
@@ -6277,13 +6566,16 @@ handleDataPacket(MotionConn *conn, icpkthdr *pkt, struct sockaddr_storage *peer,
 static void *
 rxThreadFunc(void *arg)
 {
-	icpkthdr   *pkt = NULL;
+	icpkthdr   *pkts[IC_MAX_PKTS_PER_SYSCALL];
+	int			npkts = 0;
 	bool		skip_poll = false;
+	int			i;
 
 	for (;;)
 	{
 		struct pollfd nfd;
 		int			n;
+		int			maxpkts;
 
 		/* check shutdown condition */
 		if (pg_atomic_read_u32(&ic_control_info.shutdown) == 1)
@@ -6295,14 +6587,26 @@ rxThreadFunc(void *arg)
 			break;
 		}
 
-		/* Try to get a buffer */
-		if (pkt == NULL)
+		/* Try to get a buffer for each packet to read in one go */
+		maxpkts = 1;
+#ifdef HAVE_RECVMMSG
+		if (useBatchedSyscalls())
+			maxpkts = IC_MAX_PKTS_PER_SYSCALL;
+#endif
+		if (npkts < maxpkts)
 		{
 			pthread_mutex_lock(&ic_control_info.lock);
-			pkt = getRxBuffer(&rx_buffer_pool);
+			while (npkts < maxpkts)
+			{
+				icpkthdr   *pkt = getRxBuffer(&rx_buffer_pool);
+
+				if (pkt == NULL)
+					break;
+				pkts[npkts++] = pkt;
+			}
 			pthread_mutex_unlock(&ic_control_info.lock);
 
-			if (pkt == NULL)
+			if (npkts == 0)
 			{
 				setRxThreadError(ENOMEM);
 				continue;
@@ -6352,15 +6656,13 @@ rxThreadFunc(void *arg)
 			/* we've got something interesting to read */
 			/* handle incoming */
 			/* ready to read on our socket */
-			MotionConn *conn = NULL;
-			int			read_count = 0;
-
-			struct sockaddr_storage peer;
-			socklen_t	peerlen;
+			struct sockaddr_storage peers[IC_MAX_PKTS_PER_SYSCALL];
+			socklen_t	peerlens[IC_MAX_PKTS_PER_SYSCALL];
+			int			lens[IC_MAX_PKTS_PER_SYSCALL];
+			int			nrecv;
+			int			nkept;
 
-			peerlen = sizeof(peer);
-			read_count = recvfrom(UDP_listenerFd, (char *) pkt, Gp_max_packet_size, 0,
-								  (struct sockaddr *) &peer, &peerlen);
+			nrecv = receivePackets(pkts, Min(npkts, maxpkts), peers, peerlens, lens);
 
 			if (pg_atomic_read_u32(&ic_control_info.shutdown) == 1)
 			{
@@ -6371,17 +6673,15 @@ rxThreadFunc(void *arg)
 				break;
 			}
 
-			if (DEBUG5 >= log_min_messages)
-				write_log("received inbound len %d", read_count);
-
-			if (read_count < 0)
+			if (nrecv < 0)
 			{
 				skip_poll = false;
 
 				if (errno == EWOULDBLOCK || errno == EINTR)
 					continue;
 
-				write_log("Interconnect error: recvfrom (%d)", errno);
+				write_log("Interconnect error: %s (%d)",
+						  maxpkts > 1 ? "recvmmsg" : "recvfrom", errno);
 
 				/*
 				 * ERROR case: if simply break out the loop here, there will
@@ -6395,126 +6695,216 @@ rxThreadFunc(void *arg)
 				continue;
 			}
 
-			if (read_count < sizeof(icpkthdr))
-			{
-				if (DEBUG1 >= log_min_messages)
-					write_log("Interconnect error: short conn receive (%d)", read_count);
-				continue;
-			}
-
-			/*
-			 * when we get a "good" recvfrom() result, we can skip poll()
-			 * until we get a bad one.
-			 */
-			skip_poll = true;
+			pg_atomic_add_fetch_u32((pg_atomic_uint32 *) &ic_statistics.recvSyscallNum, 1);
+			pg_atomic_add_fetch_u32((pg_atomic_uint32 *) &ic_statistics.recvDatagramNum, nrecv);
 
-			/* length must be >= 0 */
-			if (pkt->len < 0)
+			for (i = 0; i < nrecv; i++)
 			{
-				if (DEBUG3 >= log_min_messages)
-					write_log("received inbound with negative length");
-				continue;
-			}
+				/*
+				 * when we get a "good" recvfrom() result, we can skip poll()
+				 * until we get a bad one.
+				 */
+				if (lens[i] >= sizeof(icpkthdr))
+					skip_poll = true;
 
-			if (pkt->len != read_count)
-			{
-				if (DEBUG3 >= log_min_messages)
-					write_log("received inbound packet [%d], short: read %d bytes, pkt->len %d", pkt->seq, read_count, pkt->len);
-				continue;
+				if (handleRxPacket(pkts[i], lens[i], &peers[i], peerlens[i]))
+					pkts[i] = NULL;
 			}
 
-			/*
-			 * check the CRC of the payload.
-			 */
-			if (gp_interconnect_full_crc)
+			/* keep the buffers not taken over for the next read */
+			nkept = 0;
+			for (i = 0; i < npkts; i++)
 			{
-				if (!checkCRC(pkt))
-				{
-					pg_atomic_add_fetch_u32((pg_atomic_uint32 *) &ic_statistics.crcErrors, 1);
-					if (DEBUG2 >= log_min_messages)
-						write_log("received network data error, dropping bad packet, user data unaffected.");
-					continue;
-				}
+				if (pkts[i] != NULL)
+					pkts[nkept++] = pkts[i];
 			}
+			npkts = nkept;
+		}
 
-#ifdef AMS_VERBOSE_LOGGING
-			logPkt("GOT MESSAGE", pkt);
+		/* pthread_yield(); */
+	}
+
+	/* Before return, we release the packets. */
+	if (npkts > 0)
+	{
+		pthread_mutex_lock(&ic_control_info.lock);
+		for (i = 0; i < npkts; i++)
+			freeRxBuffer(&rx_buffer_pool, pkts[i]);
+		npkts = 0;
+		pthread_mutex_unlock(&ic_control_info.lock);
+	}
+
+	/* nothing to return */
+	return NULL;
+}
+
+/*
+ * receivePackets
+ * 		Read up to npkts packets from the listener socket into pkts.
+ *
+ * Returns the number of packets read, with the sender address and the length
+ * of each, or -1 with errno set. More than one packet is read only with
+ * recvmmsg().
+ *
+ * NOTE: This function MUST NOT contain elog or ereport statements.
+ */
+static int
+receivePackets(icpkthdr **pkts, int npkts, struct sockaddr_storage *peers, socklen_t *peerlens, int *lens)
+{
+	Assert(npkts > 0 && npkts <= IC_MAX_PKTS_PER_SYSCALL);
+
+#ifdef HAVE_RECVMMSG
+	if (npkts > 1)
+	{
+		struct mmsghdr msgs[IC_MAX_PKTS_PER_SYSCALL];
+		struct iovec iovs[IC_MAX_PKTS_PER_SYSCALL];
+		int			n;
+		int			i;
+
+		MemSet(msgs, 0, sizeof(msgs));
+		for (i = 0; i < npkts; i++)
+		{
+			iovs[i].iov_base = pkts[i];
+			iovs[i].iov_len = Gp_max_packet_size;
+			msgs[i].msg_hdr.msg_name = &peers[i];
+			msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+			msgs[i].msg_hdr.msg_iov = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		n = recvmmsg(UDP_listenerFd, msgs, npkts, 0, NULL);
+
+		for (i = 0; i < n; i++)
+		{
+			peerlens[i] = msgs[i].msg_hdr.msg_namelen;
+			lens[i] = msgs[i].msg_len;
+		}
+		return n;
+	}
 #endif
 
-			bool		wakeup_mainthread = false;
-			AckSendParam param;
+	peerlens[0] = sizeof(struct sockaddr_storage);
+	lens[0] = recvfrom(UDP_listenerFd, (char *) pkts[0], Gp_max_packet_size, 0,
+					   (struct sockaddr *) &peers[0], &peerlens[0]);
+	return (lens[0] < 0 ? -1 : 1);
+}
 
-			memset(&param, 0, sizeof(AckSendParam));
+/*
+ * handleRxPacket
+ * 		Handle a packet the receive thread has read from the listener socket.
+ *
+ * Returns true if the packet buffer has been taken over, and must not be
+ * reused by the caller.
+ *
+ * NOTE: This function MUST NOT contain elog or ereport statements.
+ */
+static bool
+handleRxPacket(icpkthdr *pkt, int read_count, struct sockaddr_storage *peer, socklen_t peerlen)
+{
+	MotionConn *conn = NULL;
+	bool		taken = false;
+	bool		wakeup_mainthread = false;
+	AckSendParam param;
 
-			/*
-			 * Get the connection for the pkt.
-			 *
-			 * The connection hash table should be locked until finishing the
-			 * processing of the packet to avoid the connection
-			 * addition/removal from the hash table during the mean time.
-			 */
+	if (DEBUG5 >= log_min_messages)
+		write_log("received inbound len %d", read_count);
 
-			pthread_mutex_lock(&ic_control_info.lock);
-			conn = findConnByHeader(&ic_control_info.connHtab, pkt);
+	if (read_count < sizeof(icpkthdr))
+	{
+		if (DEBUG1 >= log_min_messages)
+			write_log("Interconnect error: short conn receive (%d)", read_count);
+		return false;
+	}
 
-			if (conn != NULL)
-			{
-				/* Handling a regular packet */
-				if (handleDataPacket(conn, pkt, &peer, &peerlen, &param, &wakeup_mainthread))
-					pkt = NULL;
-				ic_statistics.recvPktNum++;
-			}
-			else
-			{
-				/*
-				 * There may have two kinds of Mismatched packets: a) Past
-				 * packets from previous command after I was torn down b)
-				 * Future packets from current command before my connections
-				 * are built.
-				 *
-				 * The handling logic is to "Ack the past and Nak the future".
-				 */
-				if ((pkt->flags & UDPIC_FLAGS_RECEIVER_TO_SENDER) == 0)
-				{
-					if (DEBUG1 >= log_min_messages)
-						write_log("mismatched packet received, seq %d, srcpid %d, dstpid %d, icid %d, sid %d", pkt->seq, pkt->srcPid, pkt->dstPid, pkt->icId, pkt->sessionId);
+	/* length must be >= 0 */
+	if (pkt->len < 0)
+	{
+		if (DEBUG3 >= log_min_messages)
+			write_log("received inbound with negative length");
+		return false;
+	}
+
+	if (pkt->len != read_count)
+	{
+		if (DEBUG3 >= log_min_messages)
+			write_log("received inbound packet [%d], short: read %d bytes, pkt->len %d", pkt->seq, read_count, pkt->len);
+		return false;
+	}
+
+	/*
+	 * check the CRC of the payload.
+	 */
+	if (gp_interconnect_full_crc)
+	{
+		if (!checkCRC(pkt))
+		{
+			pg_atomic_add_fetch_u32((pg_atomic_uint32 *) &ic_statistics.crcErrors, 1);
+			if (DEBUG2 >= log_min_messages)
+				write_log("received network data error, dropping bad packet, user data unaffected.");
+			return false;
+		}
+	}
 
 #ifdef AMS_VERBOSE_LOGGING
-					logPkt("Got a Mismatched Packet", pkt);
+	logPkt("GOT MESSAGE", pkt);
 #endif
 
-					if (handleMismatch(pkt, &peer, peerlen))
-						pkt = NULL;
-					ic_statistics.mismatchNum++;
-				}
-			}
-			pthread_mutex_unlock(&ic_control_info.lock);
+	memset(&param, 0, sizeof(AckSendParam));
 
-			if (wakeup_mainthread)
-				SetLatch(&ic_control_info.latch);
+	/*
+	 * Get the connection for the pkt.
+	 *
+	 * The connection hash table should be locked until finishing the
+	 * processing of the packet to avoid the connection addition/removal from
+	 * the hash table during the mean time.
+	 */
 
-			/*
-			 * real ack sending is after lock release to decrease the lock
-			 * holding time.
-			 */
-			if (param.msg.len != 0)
-				sendAckWithParam(&param);
-		}
+	pthread_mutex_lock(&ic_control_info.lock);
+	conn = findConnByHeader(&ic_control_info.connHtab, pkt);
 
-		/* pthread_yield(); */
+	if (conn != NULL)
+	{
+		/* Handling a regular packet */
+		if (handleDataPacket(conn, pkt, peer, &peerlen, &param, &wakeup_mainthread))
+			taken = true;
+		ic_statistics.recvPktNum++;
 	}
-
-	/* Before return, we release the packet. */
-	if (pkt)
+	else
 	{
-		pthread_mutex_lock(&ic_control_info.lock);
-		freeRxBuffer(&rx_buffer_pool, pkt);
-		pkt = NULL;
-		pthread_mutex_unlock(&ic_control_info.lock);
+		/*
+		 * There may have two kinds of Mismatched packets: a) Past packets
+		 * from previous command after I was torn down b) Future packets from
+		 * current command before my connections are built.
+		 *
+		 * The handling logic is to "Ack the past and Nak the future".
+		 */
+		if ((pkt->flags & UDPIC_FLAGS_RECEIVER_TO_SENDER) == 0)
+		{
+			if (DEBUG1 >= log_min_messages)
+				write_log("mismatched packet received, seq %d, srcpid %d, dstpid %d, icid %d, sid %d", pkt->seq, pkt->srcPid, pkt->dstPid, pkt->icId, pkt->sessionId);
+
+#ifdef AMS_VERBOSE_LOGGING
+			logPkt("Got a Mismatched Packet", pkt);
+#endif
+
+			if (handleMismatch(pkt, peer, peerlen))
+				taken = true;
+			ic_statistics.mismatchNum++;
+		}
 	}
+	pthread_mutex_unlock(&ic_control_info.lock);
 
-	/* nothing to return */
-	return NULL;
+	if (wakeup_mainthread)
+		SetLatch(&ic_control_info.latch);
+
+	/*
+	 * real ack sending is after lock release to decrease the lock holding
+	 * time.
+	 */
+	if (param.msg.len != 0)
+		sendAckWithParam(&param);
+
+	return taken;
 }
 
 /*
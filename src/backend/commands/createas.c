@@ -48,7 +48,9 @@
 #include "utils/rel.h"
 #include "utils/snapmgr.h"
 
+#include "access/appendonly_zonemap.h"
 #include "access/appendonlywriter.h"
+#include "catalog/aoblkdir.h"
 #include "catalog/aoseg.h"
 #include "catalog/aovisimap.h"
 #include "catalog/oid_dispatch.h"
@@ -169,7 +171,8 @@ create_ctas_internal(List *attrList, IntoClause *into, QueryDesc *queryDesc, boo
 	create->is_part_parent = false;
 	create->is_add_part = false;
 	create->is_split_part = false;
-	create->buildAoBlkdir = false;
+	/* Zone maps are kept in the block directory, see below */
+	create->buildAoBlkdir = gp_appendonly_zone_maps;
 	create->attr_encodings = NULL; /* Handle by AddDefaultRelationAttributeOptions() */
 
 	/* Save them in CreateStmt for dispatching. */
@@ -215,7 +218,12 @@ create_ctas_internal(List *attrList, IntoClause *into, QueryDesc *queryDesc, boo
 
 	NewRelationCreateToastTable(intoRelationId, toast_options, false, false);
 	AlterTableCreateAoSegTable(intoRelationId, false, false);
-	/* don't create AO block directory here, it'll be created when needed. */
+	/*
+	 * Don't create AO block directory here, it'll be created when needed,
+	 * unless zone maps are to be maintained in it.
+	 */
+	if (create->buildAoBlkdir)
+		AlterTableCreateAoBlkdirTable(intoRelationId, false, false);
 	AlterTableCreateAoVisimapTable(intoRelationId, false, false);
 
 	/* Create the "view" part of a materialized view. */
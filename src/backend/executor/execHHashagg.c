@@ -105,7 +105,7 @@ typedef enum InputRecordType
 		(AVAIL_MEM(hashtable) > 0)
 
 /* Actual memory needed per bucket = entry pointer + bloom value */
-#define OVERHEAD_PER_BUCKET (sizeof(HashAggBucket) + sizeof(uint64))
+#define OVERHEAD_PER_BUCKET (sizeof(HashAggBucket))
 
 #define BLOOMVAL(hashkey) ((uint64)1) << (((hashkey) >> 23) & 0x3f);
 
@@ -480,8 +480,8 @@ lookup_agg_hash_entry(AggState *aggstate,
 
 	bucket_idx = BUCKET_IDX(hashtable, hashkey);
 	bloomval = BLOOMVAL(hashkey);
-	entry = (0 == (hashtable->bloom[bucket_idx] & bloomval) ? NULL :
-			 hashtable->buckets[bucket_idx]);
+	entry = (0 == (hashtable->buckets[bucket_idx].bloom & bloomval) ? NULL :
+			 hashtable->buckets[bucket_idx].entry);
 
 	/*
 	 * Search entry chain for the bucket. If such an entry found in the
@@ -564,9 +564,9 @@ lookup_agg_hash_entry(AggState *aggstate,
 				bucket_idx = BUCKET_IDX(hashtable, hashkey);
 			}
 
-			entry->next = hashtable->buckets[bucket_idx];
-			hashtable->buckets[bucket_idx] = entry;
-			hashtable->bloom[bucket_idx] |= bloomval;
+			entry->next = hashtable->buckets[bucket_idx].entry;
+			hashtable->buckets[bucket_idx].entry = entry;
+			hashtable->buckets[bucket_idx].bloom |= bloomval;
 			
 			++hashtable->num_ht_groups;
 			++hashtable->num_entries;
@@ -849,7 +849,6 @@ create_agg_hash_table(AggState *aggstate)
 	/* Initialize the hash buckets */
 	hashtable->nbuckets = hashtable->hats.nbuckets;
 	hashtable->buckets = (HashAggBucket *) palloc0(hashtable->nbuckets * sizeof(HashAggBucket));
-	hashtable->bloom = (uint64 *) palloc0(hashtable->nbuckets * sizeof(uint64));
 
 	hashtable->pshift = 0;
 	hashtable->expandable = true;
@@ -1408,7 +1407,7 @@ spill_hash_table(AggState *aggstate)
 		for (bucket_no = file_no; bucket_no < hashtable->nbuckets;
 			 bucket_no += spill_set->num_spill_files)
 		{
-			HashAggEntry *entry = hashtable->buckets[bucket_no];
+			HashAggEntry *entry = hashtable->buckets[bucket_no].entry;
 			
 			/* Ignore empty chains. */
 			if (entry == NULL) continue;
@@ -1431,8 +1430,8 @@ spill_hash_table(AggState *aggstate)
 				}
 			}
 
-			hashtable->buckets[bucket_no] = NULL;
-			hashtable->bloom[bucket_no] = 0;
+			hashtable->buckets[bucket_no].entry = NULL;
+			hashtable->buckets[bucket_no].bloom = 0;
 		}
 	}
 
@@ -1493,17 +1492,14 @@ expand_hash_table(AggState *aggstate)
 
 	hashtable->buckets = (HashAggBucket *) repalloc(hashtable->buckets,
 		hashtable->nbuckets * sizeof(HashAggBucket));
-	hashtable->bloom =  (uint64 *) repalloc(hashtable->bloom,
-		hashtable->nbuckets * sizeof(uint64));
-
-	memset(hashtable->bloom, 0, hashtable->nbuckets * sizeof(uint64));
 	memset(hashtable->buckets + old_nbuckets, 0, old_nbuckets * sizeof(HashAggBucket));
 
 	/* Iterate all the entries from the hashtable move them as needed */
 	for(bucket_idx=0; bucket_idx < old_nbuckets; ++bucket_idx)
 	{
-		entry = hashtable->buckets[bucket_idx];
-		hashtable->buckets[bucket_idx] = NULL;
+		entry = hashtable->buckets[bucket_idx].entry;
+		hashtable->buckets[bucket_idx].entry = NULL;
+		hashtable->buckets[bucket_idx].bloom = 0;
 
 		while(entry != NULL)
 		{
@@ -1517,9 +1513,9 @@ expand_hash_table(AggState *aggstate)
 					new_bucket_idx == bucket_idx + old_nbuckets);
 
 			/* Insert this at the head of the bucket */
-			entry->next = hashtable->buckets[new_bucket_idx];
-			hashtable->buckets[new_bucket_idx] = entry;
-			hashtable->bloom[new_bucket_idx] |= bloomval;
+			entry->next = hashtable->buckets[new_bucket_idx].entry;
+			hashtable->buckets[new_bucket_idx].entry = entry;
+			hashtable->buckets[new_bucket_idx].bloom |= bloomval;
 
 			entry = nextentry;
 #ifdef USE_ASSERT_CHECKING
@@ -1693,7 +1689,7 @@ agg_hash_table_stat_upd(HashAggTable *hashtable)
 
 	for (i = 0; i < hashtable->nbuckets; i++)
 	{
-		HashAggEntry   *entry = hashtable->buckets[i];
+		HashAggEntry   *entry = hashtable->buckets[i].entry;
 		int             chainlength = 0;
 
 		if (entry)
@@ -1748,7 +1744,7 @@ agg_hash_iter(AggState *aggstate)
 	while (entry == NULL &&
 		   hashtable->nbuckets > ++ hashtable->curr_bucket_idx)
 	{
-		entry = hashtable->buckets[hashtable->curr_bucket_idx];
+		entry = hashtable->buckets[hashtable->curr_bucket_idx].entry;
 		if (entry != NULL)
 		{
 			Assert(entry->is_primodial);
@@ -2301,7 +2297,7 @@ void reset_agg_hash_table(AggState *aggstate, int64 nentries)
 		"HashAgg: resetting " INT64_FORMAT "-entry hash table",
 		hashtable->num_ht_groups);
 
-	Assert(hashtable->buckets && hashtable->bloom);
+	Assert(hashtable->buckets);
 
 	/*
 	 * Determine whether to reallocate buckets. Especially avoid re-allocation if
@@ -2333,10 +2329,8 @@ void reset_agg_hash_table(AggState *aggstate, int64 nentries)
 		hashtable->hats.nentries = hats.nentries;
 
 		pfree(hashtable->buckets);
-		pfree(hashtable->bloom);
 
 		hashtable->buckets = (HashAggBucket *) palloc0(hashtable->nbuckets * sizeof(HashAggBucket));
-		hashtable->bloom = (uint64 *) palloc0(hashtable->nbuckets * sizeof(uint64));
 
 		hashtable->expandable = true;
 
@@ -2350,7 +2344,6 @@ void reset_agg_hash_table(AggState *aggstate, int64 nentries)
 	{
 		/* No need to reallocated buckets. Reset to zero. */
 		MemSet(hashtable->buckets, 0, hashtable->nbuckets * sizeof(HashAggBucket));
-		MemSet(hashtable->bloom, 0, hashtable->nbuckets * sizeof(uint64));
 	}
 
 	Assert(hashtable->mem_for_metadata > 0);
@@ -2390,7 +2383,6 @@ void destroy_agg_hash_table(AggState *aggstate)
 
 		/* destroy_batches(aggstate->hhashtable); */
 		pfree(aggstate->hhashtable->buckets);
-		pfree(aggstate->hhashtable->bloom);
 		if (aggstate->hhashtable->hashkey_buf)
 			pfree(aggstate->hhashtable->hashkey_buf);
 
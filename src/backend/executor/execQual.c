@@ -57,6 +57,7 @@
 #include "miscadmin.h"
 #include "nodes/makefuncs.h"
 #include "nodes/nodeFuncs.h"
+#include "optimizer/planmain.h"
 #include "optimizer/planner.h"
 #include "parser/parse_coerce.h"
 #include "parser/parsetree.h"
@@ -6776,6 +6777,260 @@ void GetNeededColumnsForScan(Node *expr, bool *mask, int n)
 	neededColumnContextWalker(expr, &c);
 }
 
+/* ----------------------------------------------------------------
+ *		Batch qual evaluation
+ *
+ * A scan that decodes its rows into column vectors can evaluate the simple
+ * clauses of its quals over a whole vector at a time, instead of row by row
+ * through ExecQual(). The clauses supported are "Var op Const" and
+ * "Const op Var" with a strict, non-volatile operator, and
+ * "Var IS [NOT] NULL", for Vars of the scanned relation.
+ * ----------------------------------------------------------------
+ */
+typedef enum BatchQualKind
+{
+	BATCHQUAL_OP,
+	BATCHQUAL_IS_NULL,
+	BATCHQUAL_IS_NOT_NULL
+} BatchQualKind;
+
+typedef struct BatchQualClause
+{
+	BatchQualKind kind;
+	int			attno;			/* column number of the Var, from 0 */
+	int			vararg;			/* argument number of the Var */
+	FmgrInfo	flinfo;
+	FunctionCallInfoData fcinfo;	/* with the Const argument filled in */
+} BatchQualClause;
+
+struct BatchQual
+{
+	List	   *clauses;		/* list of BatchQualClause */
+};
+
+static bool
+batchQualVar(Expr *expr, int *attno)
+{
+	Var		   *var;
+
+	if (expr && IsA(expr, RelabelType))
+		expr = ((RelabelType *) expr)->arg;
+
+	if (expr == NULL || !IsA(expr, Var))
+		return false;
+
+	var = (Var *) expr;
+	if (IS_SPECIAL_VARNO(var->varno) || var->varlevelsup != 0 ||
+		var->varattno <= 0)
+		return false;
+
+	*attno = var->varattno - 1;
+	return true;
+}
+
+static BatchQualClause *
+initBatchQualClause(Expr *clause)
+{
+	BatchQualClause *bqc;
+	int			attno;
+
+	if (IsA(clause, OpExpr))
+	{
+		OpExpr	   *op = (OpExpr *) clause;
+		Expr	   *left;
+		Expr	   *right;
+		Const	   *con;
+		int			vararg;
+
+		if (list_length(op->args) != 2 || op->opretset)
+			return NULL;
+
+		left = (Expr *) linitial(op->args);
+		right = (Expr *) lsecond(op->args);
+		if (batchQualVar(left, &attno) && IsA(right, Const))
+		{
+			vararg = 0;
+			con = (Const *) right;
+		}
+		else if (IsA(left, Const) && batchQualVar(right, &attno))
+		{
+			vararg = 1;
+			con = (Const *) left;
+		}
+		else
+			return NULL;
+
+		set_opfuncid(op);
+		if (con->constisnull ||
+			!func_strict(op->opfuncid) ||
+			func_volatile(op->opfuncid) == PROVOLATILE_VOLATILE)
+			return NULL;
+
+		bqc = palloc0(sizeof(BatchQualClause));
+		bqc->kind = BATCHQUAL_OP;
+		bqc->attno = attno;
+		bqc->vararg = vararg;
+		fmgr_info(op->opfuncid, &bqc->flinfo);
+		fmgr_info_set_expr((Node *) op, &bqc->flinfo);
+		InitFunctionCallInfoData(bqc->fcinfo, &bqc->flinfo, 2,
+								 op->inputcollid, NULL, NULL);
+		bqc->fcinfo.arg[1 - vararg] = con->constvalue;
+		bqc->fcinfo.argnull[0] = false;
+		bqc->fcinfo.argnull[1] = false;
+
+		return bqc;
+	}
+
+	if (IsA(clause, NullTest))
+	{
+		NullTest   *ntest = (NullTest *) clause;
+
+		if (ntest->argisrow || !batchQualVar(ntest->arg, &attno))
+			return NULL;
+
+		bqc = palloc0(sizeof(BatchQualClause));
+		bqc->kind = (ntest->nulltesttype == IS_NULL) ?
+			BATCHQUAL_IS_NULL : BATCHQUAL_IS_NOT_NULL;
+		bqc->attno = attno;
+
+		return bqc;
+	}
+
+	return NULL;
+}
+
+static void
+splitBatchQual(Expr *clause, ExprState *clausestate, BatchQual *batchqual,
+			   List **remaining)
+{
+	BatchQualClause *bqc;
+
+	/* Look into ANDs, like the ones ORCA puts its scan filters in */
+	if (and_clause((Node *) clause))
+	{
+		BoolExprState *bstate = (BoolExprState *) clausestate;
+		ListCell   *lc;
+		ListCell   *lcs;
+
+		forboth(lc, ((BoolExpr *) clause)->args, lcs, bstate->args)
+			splitBatchQual((Expr *) lfirst(lc), (ExprState *) lfirst(lcs),
+						   batchqual, remaining);
+		return;
+	}
+
+	bqc = initBatchQualClause(clause);
+	if (bqc)
+		batchqual->clauses = lappend(batchqual->clauses, bqc);
+	else
+		*remaining = lappend(*remaining, clausestate);
+}
+
+/*
+ * Set up the batch evaluation of the clauses of the implicitly-ANDed 'qual'
+ * that support it. 'qualstate' is 'qual' as initialized by ExecInitExpr().
+ * The states of the other clauses are returned in *remaining, to be evaluated
+ * by ExecQual(). Returns NULL if no clause supports batch evaluation.
+ */
+BatchQual *
+ExecInitBatchQual(List *qual, List *qualstate, List **remaining)
+{
+	BatchQual  *batchqual;
+	ListCell   *lc;
+	ListCell   *lcs;
+
+	batchqual = palloc0(sizeof(BatchQual));
+	*remaining = NIL;
+
+	forboth(lc, qual, lcs, qualstate)
+		splitBatchQual((Expr *) lfirst(lc), (ExprState *) lfirst(lcs),
+					   batchqual, remaining);
+
+	if (batchqual->clauses == NIL)
+	{
+		pfree(batchqual);
+		list_free(*remaining);
+		*remaining = qualstate;
+		return NULL;
+	}
+
+	return batchqual;
+}
+
+/*
+ * Evaluate a batch qual over 'nrows' rows, given by column vectors indexed
+ * by column number. Only the rows that are set in 'selected' are evaluated,
+ * and the ones that do not satisfy the qual are cleared. Returns the number
+ * of rows cleared.
+ *
+ * The operators are called in the current memory context.
+ */
+int
+ExecBatchQual(BatchQual *batchqual, Datum **values, bool **isnull,
+			  int nrows, bool *selected)
+{
+	int			nrejected = 0;
+	ListCell   *lc;
+
+	foreach(lc, batchqual->clauses)
+	{
+		BatchQualClause *bqc = (BatchQualClause *) lfirst(lc);
+		Datum	   *colvalues = values[bqc->attno];
+		bool	   *colisnull = isnull[bqc->attno];
+		FunctionCallInfo fcinfo = &bqc->fcinfo;
+		int			vararg = bqc->vararg;
+		int			k;
+
+		switch (bqc->kind)
+		{
+			case BATCHQUAL_OP:
+				for (k = 0; k < nrows; k++)
+				{
+					Datum		result;
+
+					if (!selected[k])
+						continue;
+
+					if (!colisnull[k])
+					{
+						fcinfo->arg[vararg] = colvalues[k];
+						fcinfo->isnull = false;
+						result = FunctionCallInvoke(fcinfo);
+						if (!fcinfo->isnull && DatumGetBool(result))
+							continue;
+					}
+
+					selected[k] = false;
+					nrejected++;
+				}
+				break;
+
+			case BATCHQUAL_IS_NULL:
+				for (k = 0; k < nrows; k++)
+				{
+					if (selected[k] && !colisnull[k])
+					{
+						selected[k] = false;
+						nrejected++;
+					}
+				}
+				break;
+
+			case BATCHQUAL_IS_NOT_NULL:
+				for (k = 0; k < nrows; k++)
+				{
+					if (selected[k] && colisnull[k])
+					{
+						selected[k] = false;
+						nrejected++;
+					}
+				}
+				break;
+		}
+	}
+
+	return nrejected;
+}
+
 /* ----------------------------------------------------------------
  *	isJoinExprNull
  *
@@ -131,6 +131,9 @@ MultiExecHash(HashState *node)
 		{
 			int			bucketNumber;
 
+			if (hashtable->bloom != NULL)
+				HJ_BLOOM_WORD(hashtable, hashvalue) |= HJ_BLOOM_BITS(hashvalue);
+
 			bucketNumber = ExecHashGetSkewBucket(hashtable, hashvalue);
 			if (bucketNumber != INVALID_SKEW_BUCKET_NO)
 			{
@@ -158,6 +161,18 @@ MultiExecHash(HashState *node)
 	}
 	MemoryAccounting_DeclareDone();
 
+	/*
+	 * CDB: With far more inner tuples than the planner estimated, most bits of
+	 * the Bloom filter are set and it rejects too few outer tuples to pay off.
+	 */
+	if (hashtable->bloom != NULL &&
+		hashtable->totalTuples > 16 * ((uint64) hashtable->bloomMask + 1))
+	{
+		hashtable->spaceUsed -= HJ_BLOOM_SIZE(hashtable);
+		pfree(hashtable->bloom);
+		hashtable->bloom = NULL;
+	}
+
 	/* Now we have set up all the initial batches & primary overflow batches. */
 	hashtable->nbatch_outstart = hashtable->nbatch;
 
@@ -328,6 +343,9 @@ ExecHashTableCreate(HashState *hashState, HashJoinState *hjstate, List *hashOper
 	hashtable->nbatch_outstart = nbatch;
 	hashtable->growEnabled = true;
 	hashtable->totalTuples = 0;
+	hashtable->bloom = NULL;
+	hashtable->bloomMask = 0;
+	hashtable->bloomRejected = 0;
 	hashtable->innerBatchFile = NULL;
 	hashtable->outerBatchFile = NULL;
 	hashtable->work_set = NULL;
@@ -397,6 +415,36 @@ ExecHashTableCreate(HashState *hashState, HashJoinState *hjstate, List *hashOper
 		i++;
 	}
 
+	/*
+	 * CDB: Build a Bloom filter on the inner hash values, if the join
+	 * discards outer tuples that have no match.  Aim for 8 inner tuples per
+	 * 64-bit word, but spend at most 1/16th of the operator memory on it.
+	 * The filter lives as long as the hash table and is counted in
+	 * spaceUsed for every batch.
+	 */
+	if (gp_enable_runtime_filter &&
+		(hjstate->js.jointype == JOIN_INNER ||
+		 hjstate->js.jointype == JOIN_SEMI ||
+		 hjstate->js.jointype == JOIN_RIGHT))
+	{
+		Size		maxwords;
+		Size		nwords = 64;
+
+		maxwords = Min(hashtable->spaceAllowed / 16 / sizeof(uint64),
+					   HJ_BLOOM_MAX_WORDS);
+		while (nwords * 8 < outerNode->plan_rows && nwords * 2 <= maxwords)
+			nwords *= 2;
+
+		if (nwords <= maxwords)
+		{
+			hashtable->bloom = (uint64 *) palloc0(nwords * sizeof(uint64));
+			hashtable->bloomMask = nwords - 1;
+			hashtable->spaceUsed += HJ_BLOOM_SIZE(hashtable);
+			if (hashtable->spaceUsed > hashtable->spacePeak)
+				hashtable->spacePeak = hashtable->spaceUsed;
+		}
+	}
+
 	if (nbatch > 1)
 	{
 		/*
@@ -1337,7 +1385,7 @@ ExecHashTableReset(HashState *hashState, HashJoinTable hashtable)
 	hashtable->buckets = (HashJoinTuple *)
 		palloc0(nbuckets * sizeof(HashJoinTuple));
 
-	hashtable->spaceUsed = 0;
+	hashtable->spaceUsed = HJ_BLOOM_SIZE(hashtable);
 	hashtable->totalTuples = 0;
 
 	MemoryContextSwitchTo(oldcxt);
@@ -1532,6 +1580,12 @@ ExecHashTableExplainEnd(PlanState *planstate, struct StringInfoData *buf)
 		ResetWorkFileSetStatsInfo(hashtable);
     }
 
+    /* Report outer tuples discarded by the Bloom filter. */
+    if (hashtable->bloomRejected > 0)
+        appendStringInfo(buf,
+                         "Bloom filter rejected " UINT64_FORMAT " outer rows.\n",
+                         hashtable->bloomRejected);
+
     /* Report hash chain statistics. */
     total_buckets = stats->nonemptybatches * hashtable->nbuckets;
     if (total_buckets > 0)
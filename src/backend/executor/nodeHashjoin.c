@@ -842,12 +842,26 @@ ExecHashJoinOuterGetTuple(PlanState *outerNode,
 				/* remember outer relation is not empty for possible rescan */
 				hjstate->hj_OuterNotEmpty = true;
 
-				return slot;
+				/*
+				 * CDB: If no inner tuple has this hash value, the tuple
+				 * cannot match; don't bother probing or spilling it.
+				 */
+				if (hashtable->bloom == NULL)
+					return slot;
+				else
+				{
+					uint64		bits = HJ_BLOOM_BITS(*hashvalue);
+
+					if ((HJ_BLOOM_WORD(hashtable, *hashvalue) & bits) == bits)
+						return slot;
+				}
+
+				hashtable->bloomRejected++;
 			}
 
 			/*
-			 * That tuple couldn't match because of a NULL, so discard it and
-			 * continue with the next one.
+			 * That tuple couldn't match because of a NULL or the Bloom
+			 * filter, so discard it and continue with the next one.
 			 */
 			slot = ExecProcNode(outerNode);
 		}
@@ -29,6 +29,7 @@
 #include "executor/nodeSeqscan.h"
 #include "utils/rel.h"
 
+#include "access/appendonly_zonemap.h"
 #include "cdb/cdbappendonlyam.h"
 #include "cdb/cdbaocsam.h"
 #include "utils/snapmgr.h"
@@ -37,6 +38,10 @@ static void InitScanRelation(SeqScanState *node, EState *estate, int eflags, Rel
 static TupleTableSlot *SeqNext(SeqScanState *node);
 
 static void InitAOCSScanOpaque(SeqScanState *scanState, Relation currentRelation);
+static void InitAOCSFilter(SeqScanState *node, bool batch);
+static bool AOCSRowFilter(void *arg, TupleTableSlot *slot);
+static void AOCSBatchQualFilter(void *arg, AOCSScanBatch *batch);
+static void ExecSeqScanExplainEnd(PlanState *planstate, struct StringInfoData *buf);
 
 /* ----------------------------------------------------------------
  *						Scan Support
@@ -161,10 +166,24 @@ InitScanRelation(SeqScanState *node, EState *estate, int eflags, Relation curren
 			node->ss.ps.state->es_snapshot,
 			appendOnlyMetaDataSnapshot,
 			0, NULL);
+
+		if (gp_appendonly_zone_maps)
+		{
+			ScanKey		keys;
+			int			nkeys;
+
+			keys = AppendOnlyZoneMap_BuildScanKeys(currentRelation,
+												   node->ss.ps.plan->qual,
+												   &nkeys);
+			if (nkeys > 0)
+				appendonly_set_zonemap_keys(node->ss_currentScanDesc_ao,
+											nkeys, keys);
+		}
 	}
 	else if (RelationIsAoCols(currentRelation))
 	{
 		Snapshot appendOnlyMetaDataSnapshot;
+		bool		batch = false;
 
 		InitAOCSScanOpaque(node, currentRelation);
 
@@ -184,6 +203,30 @@ InitScanRelation(SeqScanState *node, EState *estate, int eflags, Relation curren
 						   appendOnlyMetaDataSnapshot,
 						   NULL /* relationTupleDesc */,
 						   node->ss_aocs_proj);
+
+		if (gp_appendonly_zone_maps)
+		{
+			ScanKey		keys;
+			int			nkeys;
+
+			keys = AppendOnlyZoneMap_BuildScanKeys(currentRelation,
+												   node->ss.ps.plan->qual,
+												   &nkeys);
+			if (nkeys > 0)
+				aocs_set_zonemap_keys(node->ss_currentScanDesc_aocs,
+									  nkeys, keys);
+		}
+
+		if (gp_aocs_dictionary_encoding)
+			aocs_set_dictionary_quals(node->ss_currentScanDesc_aocs,
+									  node->ss.ps.plan->qual);
+
+		if (gp_aocs_batch_scan)
+			batch = aocs_set_batch_mode(node->ss_currentScanDesc_aocs);
+
+		if (node->ss.ps.qual != NIL &&
+			(gp_aocs_late_materialization || batch))
+			InitAOCSFilter(node, batch);
 	}
 	else
 	{
@@ -194,6 +237,14 @@ InitScanRelation(SeqScanState *node, EState *estate, int eflags, Relation curren
 	}
 	node->ss.ss_currentRelation = currentRelation;
 
+	/*
+	 * CDB: Report the zone maps and I/O of append-optimized scans in EXPLAIN
+	 * ANALYZE.
+	 */
+	if ((estate->es_instrument & INSTRUMENT_CDB) &&
+		(node->ss_currentScanDesc_ao || node->ss_currentScanDesc_aocs))
+		node->ss.ps.cdbexplainfun = ExecSeqScanExplainEnd;
+
 	/* and report the scan tuple slot's rowtype */
 	ExecAssignScanType(&node->ss, RelationGetDescr(currentRelation));
 }
@@ -396,3 +447,153 @@ InitAOCSScanOpaque(SeqScanState *scanstate, Relation currentRelation)
 	scanstate->ss_aocs_ncol = ncol;
 	scanstate->ss_aocs_proj = proj;
 }
+
+/*
+ * Let the AOCS scan evaluate the quals itself. With late materialization, it
+ * evaluates them on the columns they reference before it reads the other
+ * columns of the row; in batch mode, it evaluates the simple clauses over
+ * whole batches of rows. If it does, the quals are taken out of ExecScan()'s
+ * hands, so that they are evaluated only once per row.
+ */
+static void
+InitAOCSFilter(SeqScanState *node, bool batch)
+{
+	BatchQual  *batchqual = NULL;
+	List	   *rowqual = node->ss.ps.qual;
+	bool	   *filter_proj;
+	int			ncol = node->ss_aocs_ncol;
+
+	if (batch)
+		batchqual = ExecInitBatchQual(node->ss.ps.plan->qual,
+									  node->ss.ps.qual, &rowqual);
+
+	if (!gp_aocs_late_materialization && batchqual == NULL)
+		return;
+
+	/*
+	 * Without late materialization, all the projected columns are read
+	 * before the quals are evaluated.
+	 */
+	filter_proj = palloc0(ncol * sizeof(bool));
+	if (gp_aocs_late_materialization)
+		GetNeededColumnsForScan((Node *) node->ss.ps.plan->qual,
+								filter_proj, ncol);
+	else
+		memcpy(filter_proj, node->ss_aocs_proj, ncol * sizeof(bool));
+
+	if (aocs_set_filter(node->ss_currentScanDesc_aocs, filter_proj,
+						(rowqual != NIL) ? AOCSRowFilter : NULL,
+						(batchqual != NULL) ? AOCSBatchQualFilter : NULL,
+						node))
+	{
+		node->ss_aocs_qual = rowqual;
+		node->ss_aocs_batchqual = batchqual;
+		node->ss.ps.qual = NIL;
+	}
+
+	pfree(filter_proj);
+}
+
+/*
+ * Row filter of an AOCS scan that evaluates its quals. With late
+ * materialization, only the columns referenced by the quals are filled in
+ * the slot.
+ */
+static bool
+AOCSRowFilter(void *arg, TupleTableSlot *slot)
+{
+	SeqScanState *node = (SeqScanState *) arg;
+	ExprContext *econtext = node->ss.ps.ps_ExprContext;
+
+	ResetExprContext(econtext);
+	econtext->ecxt_scantuple = slot;
+
+	if (ExecQual(node->ss_aocs_qual, econtext, false))
+		return true;
+
+	InstrCountFiltered1(node, 1);
+	return false;
+}
+
+/*
+ * Batch filter of an AOCS scan in batch mode, for the clauses of the quals
+ * that support batch evaluation.
+ */
+static void
+AOCSBatchQualFilter(void *arg, AOCSScanBatch *batch)
+{
+	SeqScanState *node = (SeqScanState *) arg;
+	ExprContext *econtext = node->ss.ps.ps_ExprContext;
+	MemoryContext oldcontext;
+	int			nrejected;
+
+	ResetExprContext(econtext);
+	oldcontext = MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
+
+	nrejected = ExecBatchQual(node->ss_aocs_batchqual,
+							  batch->values, batch->isnull,
+							  batch->nrows, batch->selected);
+
+	MemoryContextSwitchTo(oldcontext);
+
+	InstrCountFiltered1(node, nrejected);
+}
+
+/*
+ * ExecSeqScanExplainEnd
+ *		Called before ExecutorEnd to finish EXPLAIN ANALYZE reporting.
+ *
+ * Reports what the zone maps and late materialization of an
+ * append-optimized table let the scan skip, and how many rows it decoded
+ * in batch mode, followed by the large reads of the scan and how long it
+ * waited for them, whether or not gp_appendonly_read_ahead is on.
+ */
+static void
+ExecSeqScanExplainEnd(PlanState *planstate, struct StringInfoData *buf)
+{
+	SeqScanState *node = (SeqScanState *) planstate;
+	BufferedReadStats stats;
+
+	if (node->ss_currentScanDesc_ao)
+	{
+		AppendOnlyScanDesc scan = node->ss_currentScanDesc_ao;
+
+		if (scan->aos_zonemapSkippedRows > 0)
+			appendStringInfo(buf,
+							 "Zone maps skipped " INT64_FORMAT " rows.\n",
+							 scan->aos_zonemapSkippedRows);
+		appendonly_get_io_stats(scan, &stats);
+	}
+	else if (node->ss_currentScanDesc_aocs)
+	{
+		AOCSScanDesc scan = node->ss_currentScanDesc_aocs;
+
+		if (scan->zonemap_skipped_rows > 0)
+			appendStringInfo(buf,
+							 "Zone maps skipped " INT64_FORMAT " rows.\n",
+							 scan->zonemap_skipped_rows);
+		if (scan->batch_rows > 0)
+			appendStringInfo(buf,
+							 "Batch mode decoded " INT64_FORMAT " rows.\n",
+							 scan->batch_rows);
+		if (scan->late_mat_skipped_blocks > 0)
+			appendStringInfo(buf,
+							 "Late materialization skipped " INT64_FORMAT
+							 " column blocks.\n",
+							 scan->late_mat_skipped_blocks);
+		aocs_get_io_stats(scan, &stats);
+	}
+	else
+		return;
+
+	if (stats.reads == 0)
+		return;
+
+	appendStringInfo(buf,
+					 "Append-only storage: " INT64_FORMAT " reads, " INT64_FORMAT
+					 "K bytes, I/O wait %.3f ms, read-ahead %d.\n",
+					 stats.reads,
+					 (stats.bytes + 1023) / 1024,
+					 INSTR_TIME_GET_MILLISEC(stats.waitTime),
+					 gp_appendonly_read_ahead);
+}
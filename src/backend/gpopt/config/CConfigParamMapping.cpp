@@ -275,6 +275,17 @@ CConfigParamMapping::SConfigMappingElem CConfigParamMapping::m_elements[] = {
 	 false,	 // m_negate_param
 	 GPOS_WSZ_LIT("Enable ordered aggregate plans.")},
 
+	{EopttraceEnableWindowTopNPushdown, &optimizer_enable_window_topn_pushdown,
+	 false,	 // m_negate_param
+	 GPOS_WSZ_LIT(
+		 "Pre-filter windows followed by a top-N filter on each segment.")},
+
+	{EopttraceEnableOuterJoinElimination,
+	 &optimizer_enable_outer_join_elimination,
+	 false,	 // m_negate_param
+	 GPOS_WSZ_LIT(
+		 "Remove left outer joins to a unique key whose inner columns are unused.")},
+
 	{EopttraceExpandFullJoin, &optimizer_expand_fulljoin,
 	 false,	 // m_negate_param
 	 GPOS_WSZ_LIT(
@@ -283,6 +294,10 @@ CConfigParamMapping::SConfigMappingElem CConfigParamMapping::m_elements[] = {
 	 true,	// m_negate_param
 	 GPOS_WSZ_LIT(
 		 "Penalize a hash join with a skewed redistribute as a child.")},
+	{EopttracePenalizeSkewMCV, &optimizer_penalize_skew_mcv,
+	 false,	 // m_negate_param
+	 GPOS_WSZ_LIT(
+		 "Use most common value frequencies to detect skewed redistributes.")},
 	{EopttraceTranslateUnusedColrefs, &optimizer_prune_unused_columns,
 	 true,	// m_negate_param
 	 GPOS_WSZ_LIT("Prune unused columns from the query.")},
@@ -471,6 +486,18 @@ CConfigParamMapping::PackConfigParamInBitset(
 			GPOPT_DISABLE_XFORM_TF(CXform::ExfImplementFullOuterMergeJoin));
 	}
 
+	if (!optimizer_enable_full_hash_join)
+	{
+		traceflag_bitset->ExchangeSet(
+			GPOPT_DISABLE_XFORM_TF(CXform::ExfFullOuterJoin2HashJoin));
+	}
+
+	if (!optimizer_enable_semi_join_reduction)
+	{
+		traceflag_bitset->ExchangeSet(
+			GPOPT_DISABLE_XFORM_TF(CXform::ExfInnerJoinSemiJoinReduction));
+	}
+
 	CBitSet *join_heuristic_bitset = NULL;
 	switch (optimizer_join_order)
 	{
@@ -486,6 +513,9 @@ CConfigParamMapping::PackConfigParamInBitset(
 		case JOIN_ORDER_EXHAUSTIVE2_SEARCH:
 			join_heuristic_bitset = CXform::PbsJoinOrderOnExhaustive2Xforms(mp);
 			break;
+		case JOIN_ORDER_ADAPTIVE_SEARCH:
+			join_heuristic_bitset = CXform::PbsJoinOrderOnAdaptiveXforms(mp);
+			break;
 		default:
 			elog(ERROR,
 				 "Invalid value for optimizer_join_order, must \
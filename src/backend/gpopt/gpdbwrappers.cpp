@@ -2498,11 +2498,15 @@ gpdb::CountLeafPartTables(Oid rel_oid)
  * We register a callback to a cache on all the catalog tables that contain
  * information that's contained in the ORCA metadata cache.
 
- * There is no fine-grained mechanism in the metadata cache for invalidating
- * individual entries ATM, so we just blow the whole cache whenever anything
- * changes. The callback simply increments a counter. Whenever we start
- * planning a query, we check the counter to see if it has changed since the
- * last planned query, and reset the whole cache if it has.
+ * Catalog cache callbacks don't tell which object changed, so for those we
+ * just blow the whole cache. The callback simply increments a counter.
+ * Whenever we start planning a query, we check the counter to see if it has
+ * changed since the last planned query, and reset the whole cache if it has.
+ *
+ * Relcache callbacks do tell us the relation, so we remember up to
+ * MDCACHE_MAX_INVALIDATED_RELS of them and drop only the entries of those
+ * relations from the metadata cache. Partitioned tables are still handled by
+ * a full reset, as the metadata of the root depends on all its parts.
  *
  * To make sure we've covered all catalog tables that contain information
  * that's stored in the metadata cache, there are "catalog tables: xxx"
@@ -2515,6 +2519,12 @@ static bool mdcache_invalidation_counter_registered = false;
 static int64 mdcache_invalidation_counter = 0;
 static int64 last_mdcache_invalidation_counter = 0;
 
+#define MDCACHE_MAX_INVALIDATED_RELS 64
+
+// relations invalidated since the last planned query
+static Oid mdcache_invalidated_rels[MDCACHE_MAX_INVALIDATED_RELS];
+static int mdcache_num_invalidated_rels = 0;
+
 // If we have cached a relation without an index, because that index cannot
 // be used in the current snapshot (for more info see
 // src/backend/access/heap/README.HOT), we save TransactionXmin. If
@@ -2532,7 +2542,23 @@ mdsyscache_invalidation_counter_callback(Datum arg, int cacheid,
 static void
 mdrelcache_invalidation_counter_callback(Datum arg, Oid relid)
 {
-	mdcache_invalidation_counter++;
+	int i;
+
+	// InvalidOid means all relations
+	if (!OidIsValid(relid) ||
+		mdcache_num_invalidated_rels >= MDCACHE_MAX_INVALIDATED_RELS)
+	{
+		mdcache_invalidation_counter++;
+		return;
+	}
+
+	for (i = 0; i < mdcache_num_invalidated_rels; i++)
+	{
+		if (mdcache_invalidated_rels[i] == relid)
+			return;
+	}
+
+	mdcache_invalidated_rels[mdcache_num_invalidated_rels++] = relid;
 }
 
 static void
@@ -2617,6 +2643,18 @@ gpdb::MDCacheNeedsReset(void)
 		}
 		if (last_mdcache_invalidation_counter == mdcache_invalidation_counter)
 		{
+			// the metadata of a partitioned table covers all of its parts,
+			// don't try to invalidate only some of them
+			for (int i = 0; i < mdcache_num_invalidated_rels; i++)
+			{
+				if (PART_STATUS_NONE !=
+					rel_part_status(mdcache_invalidated_rels[i]))
+				{
+					mdcache_num_invalidated_rels = 0;
+					return true;
+				}
+			}
+
 			return TransactionIdIsValid(mdcache_transaction_xmin) &&
 				   !TransactionIdEquals(TransactionXmin,
 										mdcache_transaction_xmin);
@@ -2624,6 +2662,7 @@ gpdb::MDCacheNeedsReset(void)
 		else
 		{
 			last_mdcache_invalidation_counter = mdcache_invalidation_counter;
+			mdcache_num_invalidated_rels = 0;
 			return true;
 		}
 	}
@@ -2632,6 +2671,27 @@ gpdb::MDCacheNeedsReset(void)
 	return true;
 }
 
+// Return the relations invalidated since the last call, and forget them
+List *
+gpdb::MDCacheGetInvalidatedRelations(void)
+{
+	GP_WRAP_START;
+	{
+		List *relids = NIL;
+
+		for (int i = 0; i < mdcache_num_invalidated_rels; i++)
+		{
+			relids = lappend_oid(relids, mdcache_invalidated_rels[i]);
+		}
+		mdcache_num_invalidated_rels = 0;
+
+		return relids;
+	}
+	GP_WRAP_END;
+
+	return NIL;
+}
+
 bool
 gpdb::MDCacheSetTransientState(Relation index_rel)
 {
@@ -29,10 +29,12 @@ CContextQueryToDXL::CContextQueryToDXL(CMemoryPool *mp)
 	// map that stores gpdb att to optimizer col mapping
 	m_colid_counter = GPOS_NEW(mp) CIdGenerator(GPDXL_COL_ID_START);
 	m_cte_id_counter = GPOS_NEW(mp) CIdGenerator(GPDXL_CTE_ID_START);
+	m_rel_mdids = GPOS_NEW(mp) MdidHashSet(mp);
 }
 
 CContextQueryToDXL::~CContextQueryToDXL()
 {
 	GPOS_DELETE(m_colid_counter);
 	GPOS_DELETE(m_cte_id_counter);
+	m_rel_mdids->Release();
 }
@@ -3252,6 +3252,15 @@ CTranslatorQueryToDXL::TranslateRTEToDXLLogicalGet(const RangeTblEntry *rte,
 	CDXLLogicalGet *dxl_op = NULL;
 	const IMDRelation *md_rel =
 		m_md_accessor->RetrieveRel(dxl_table_descr->MDId());
+
+	// remember the relation, so its statistics can be fetched before
+	// optimization starts
+	IMDId *rel_mdid = dxl_table_descr->MDId();
+	if (!m_context->m_rel_mdids->Contains(rel_mdid))
+	{
+		rel_mdid->AddRef();
+		m_context->m_rel_mdids->Insert(rel_mdid);
+	}
 	if (IMDRelation::ErelstorageExternal == md_rel->RetrieveRelStorageType())
 	{
 		dxl_op = GPOS_NEW(m_mp) CDXLLogicalExternalGet(m_mp, dxl_table_descr);
@@ -2007,7 +2007,29 @@ CTranslatorUtils::CreateMultiByteCharStringFromWCString(const WCHAR *wcstr)
 {
 	GPOS_ASSERT(NULL != wcstr);
 
-	ULONG max_len = GPOS_WSZ_LENGTH(wcstr) * GPOS_SIZEOF(WCHAR) + 1;
+	const ULONG wcstr_len = GPOS_WSZ_LENGTH(wcstr);
+
+	// names are almost always plain ASCII, narrow those directly into a
+	// buffer of the exact size instead of the worst case multibyte length
+	ULONG ul = 0;
+	while (ul < wcstr_len && 0x80 > (ULONG) wcstr[ul])
+	{
+		ul++;
+	}
+
+	if (ul == wcstr_len)
+	{
+		CHAR *str = (CHAR *) gpdb::GPDBAlloc(wcstr_len + 1);
+		for (ul = 0; ul < wcstr_len; ul++)
+		{
+			str[ul] = (CHAR) wcstr[ul];
+		}
+		str[wcstr_len] = '\0';
+
+		return str;
+	}
+
+	ULONG max_len = wcstr_len * GPOS_SIZEOF(WCHAR) + 1;
 	CHAR *str = (CHAR *) gpdb::GPDBAlloc(max_len);
 #ifdef GPOS_DEBUG
 	LINT li = (INT)
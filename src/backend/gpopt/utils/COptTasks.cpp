@@ -388,6 +388,7 @@ COptTasks::CreateOptimizerConfig(CMemoryPool *mp, ICostModel *cost_model)
 		(ULONG) optimizer_push_group_by_below_setop_threshold;
 	ULONG xform_bind_threshold = (ULONG) optimizer_xform_bind_threshold;
 	ULONG skew_factor = (ULONG) optimizer_skew_factor;
+	ULONG join_order_budget = (ULONG) optimizer_join_order_budget;
 
 	return GPOS_NEW(mp) COptimizerConfig(
 		GPOS_NEW(mp)
@@ -403,7 +404,7 @@ COptTasks::CreateOptimizerConfig(CMemoryPool *mp, ICostModel *cost_model)
 				  false, /* don't create Assert nodes for constraints, we'll
 								      * enforce them ourselves in the executor */
 				  push_group_by_below_setop_threshold, xform_bind_threshold,
-				  skew_factor),
+				  skew_factor, join_order_budget),
 		GPOS_NEW(mp) CWindowOids(OID(F_WINDOW_ROW_NUMBER), OID(F_WINDOW_RANK)));
 }
 
@@ -444,6 +445,18 @@ COptTasks::SetCostModelParams(ICostModel *cost_model)
 			cost_param->GetLowerBoundVal() * optimizer_sort_factor,
 			cost_param->GetUpperBoundVal() * optimizer_sort_factor);
 	}
+
+	if (optimizer_penalize_skew_mcv)
+	{
+		// change the frequency from which a hot key penalizes a hash join
+		ICostModelParams::SCostParam *cost_param =
+			cost_model->GetCostModelParams()->PcpLookup(
+				CCostModelParamsGPDB::EcpPenalizeSkewMCVThreshold);
+		CDouble threshold(optimizer_penalize_skew_mcv_threshold);
+		cost_model->GetCostModelParams()->SetParam(
+			cost_param->Id(), threshold, cost_param->GetLowerBoundVal(),
+			cost_param->GetUpperBoundVal());
+	}
 }
 
 
@@ -493,6 +506,7 @@ COptTasks::OptimizeTask(void *ptr)
 	// we need to call it anyway, to give it a chance to initialize
 	// the invalidation mechanism.
 	bool reset_mdcache = gpdb::MDCacheNeedsReset();
+	List *invalidated_rels = gpdb::MDCacheGetInvalidatedRelations();
 
 	// initialize metadata cache, or purge if needed, or change size if requested
 	if (!CMDCache::FInitialized())
@@ -507,11 +521,29 @@ COptTasks::OptimizeTask(void *ptr)
 		CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
 		gpdb::MDCacheResetTransientState();
 	}
-	else if (CMDCache::ULLGetCacheQuota() !=
-			 (ULLONG) optimizer_mdcache_size * 1024L)
+	else
 	{
-		CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
+		if (NIL != invalidated_rels)
+		{
+			// only drop the relations that changed since the last query
+			IMdIdArray *rel_mdids = GPOS_NEW(mp) IMdIdArray(mp);
+			ListCell *lc = NULL;
+			ForEach(lc, invalidated_rels)
+			{
+				rel_mdids->Append(GPOS_NEW(mp)
+									  CMDIdGPDB(IMDId::EmdidRel, lfirst_oid(lc)));
+			}
+			CMDCache::InvalidateRelations(mp, rel_mdids);
+			rel_mdids->Release();
+		}
+
+		if (CMDCache::ULLGetCacheQuota() !=
+			(ULLONG) optimizer_mdcache_size * 1024L)
+		{
+			CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
+		}
 	}
+	gpdb::ListFree(invalidated_rels);
 
 
 	// load search strategy
@@ -569,6 +601,11 @@ COptTasks::OptimizeTask(void *ptr)
 				query_to_dxl_translator->GetCTEs();
 			GPOS_ASSERT(NULL != query_output_dxlnode_array);
 
+			// fetch the statistics of the scanned relations up front instead
+			// of interleaving catalog access with the search
+			mda.PrefetchRelStats(
+				query_to_dxl_translator->GetScannedRelations());
+
 			BOOL is_master_only =
 				!optimizer_enable_motions ||
 				(!optimizer_enable_motions_masteronly_queries &&
@@ -586,6 +623,10 @@ COptTasks::OptimizeTask(void *ptr)
 				cte_dxlnode_array, expr_evaluator, num_segments, gp_session_id,
 				MyProc->queryCommandId, search_strategy_arr, optimizer_config);
 
+			// the query tree is not needed for plan translation, release it
+			// early to keep the peak memory of large queries down
+			query_dxl->Release();
+
 			if (opt_ctxt->m_should_serialize_plan_dxl)
 			{
 				// serialize DXL to xml
@@ -612,6 +653,9 @@ COptTasks::OptimizeTask(void *ptr)
 						query_to_dxl_translator->GetDistributionHashOpsKind()));
 			}
 
+			plan_dxl->Release();
+			plan_dxl = NULL;
+
 			CStatisticsConfig *stats_conf = optimizer_config->GetStatsConf();
 			col_stats = GPOS_NEW(mp) IMdIdArray(mp);
 			stats_conf->CollectMissingStatsColumns(col_stats);
@@ -623,9 +667,7 @@ COptTasks::OptimizeTask(void *ptr)
 			col_stats->Release();
 
 			expr_evaluator->Release();
-			query_dxl->Release();
 			optimizer_config->Release();
-			plan_dxl->Release();
 		}
 	}
 	GPOS_CATCH_EX(ex)
@@ -25,6 +25,7 @@ extern "C" {
 #include "gpos/_api.h"
 
 #include "gpopt/gpdbwrappers.h"
+#include "gpopt/mdcache/CMDCache.h"
 #include "gpopt/utils/COptTasks.h"
 #include "gpopt/utils/funcs.h"
 
@@ -116,3 +117,36 @@ LibraryVersion()
 	PG_RETURN_TEXT_P(result);
 }
 }
+
+//---------------------------------------------------------------------------
+//	@function:
+//		MDCacheStats
+//
+//	@doc:
+//		Returns the hits, misses and evictions of the optimizer's metadata
+//		cache in this session, one line per metadata object type
+//
+//---------------------------------------------------------------------------
+extern "C" {
+Datum
+MDCacheStats()
+{
+	StringInfoData str;
+	initStringInfo(&str);
+
+	for (ULONG ul = 0; ul < IMDCacheObject::EmdtSentinel; ul++)
+	{
+		IMDCacheObject::Emdtype mdtype = (IMDCacheObject::Emdtype) ul;
+		appendStringInfo(&str,
+						 "%s%s: hits=" UINT64_FORMAT ", misses=" UINT64_FORMAT
+						 ", evictions=" UINT64_FORMAT,
+						 0 == ul ? "" : "\n", CMDCache::SzMDType(mdtype),
+						 (uint64) CMDCache::ULLGetHits(mdtype),
+						 (uint64) CMDCache::ULLGetMisses(mdtype),
+						 (uint64) CMDCache::ULLGetEvictions(mdtype));
+	}
+	text *result = cstring_to_text(str.data);
+
+	PG_RETURN_TEXT_P(result);
+}
+}
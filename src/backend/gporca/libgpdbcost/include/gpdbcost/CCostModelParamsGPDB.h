@@ -106,6 +106,8 @@ public:
 
 		EcpScalarFuncCost,	// cost of scalar func
 
+		EcpPenalizeSkewMCVThreshold,  // smallest frequency of a hot key that penalizes a hashjoin
+
 		EcpSentinel
 	};
 
@@ -279,6 +281,9 @@ private:
 	// default value of compute scalar func cost
 	static const CDouble DScalarFuncCost;
 
+	// default smallest frequency of a hot key that penalizes a hashjoin
+	static const CDouble DPenalizeSkewMCVThreshold;
+
 	// private copy ctor
 	CCostModelParamsGPDB(CCostModelParamsGPDB &);
 
@@ -83,6 +83,7 @@ const CCostModelGPDB::SCostMapping CCostModelGPDB::m_rgcm[] = {
 	{COperator::EopPhysicalLeftAntiSemiHashJoinNotIn, CostHashJoin},
 	{COperator::EopPhysicalLeftOuterHashJoin, CostHashJoin},
 	{COperator::EopPhysicalRightOuterHashJoin, CostHashJoin},
+	{COperator::EopPhysicalFullHashJoin, CostHashJoin},
 
 	{COperator::EopPhysicalInnerIndexNLJoin, CostIndexNLJoin},
 	{COperator::EopPhysicalLeftOuterIndexNLJoin, CostIndexNLJoin},
@@ -930,7 +931,8 @@ CCostModelGPDB::CostHashJoin(CMemoryPool *mp, CExpressionHandle &exprhdl,
 				COperator::EopPhysicalLeftAntiSemiHashJoin == op_id ||
 				COperator::EopPhysicalLeftAntiSemiHashJoinNotIn == op_id ||
 				COperator::EopPhysicalLeftOuterHashJoin == op_id ||
-				COperator::EopPhysicalRightOuterHashJoin == op_id);
+				COperator::EopPhysicalRightOuterHashJoin == op_id ||
+				COperator::EopPhysicalFullHashJoin == op_id);
 #endif	// GPOS_DEBUG
 
 	const DOUBLE num_rows_outer = pci->PdRows()[0];
@@ -989,6 +991,10 @@ CCostModelGPDB::CostHashJoin(CMemoryPool *mp, CExpressionHandle &exprhdl,
 		pcmgpdb->GetCostModelParams()
 			->PcpLookup(CCostModelParamsGPDB::EcpPenalizeHJSkewUpperLimit)
 			->Get();
+	const CDouble dPenalizeSkewMCVThreshold =
+		pcmgpdb->GetCostModelParams()
+			->PcpLookup(CCostModelParamsGPDB::EcpPenalizeSkewMCVThreshold)
+			->Get();
 	GPOS_ASSERT(0 < dHJHashTableInitCostFactor);
 	GPOS_ASSERT(0 < dHJHashTableColumnCostUnit);
 	GPOS_ASSERT(0 < dHJHashTableWidthCostUnit);
@@ -1110,6 +1116,24 @@ CCostModelGPDB::CostHashJoin(CMemoryPool *mp, CExpressionHandle &exprhdl,
 				skew_ratio = CDouble(std::max(sk.Get(), skew_ratio.Get()));
 			}
 
+			// a handful of hot keys may hold a large fraction of the rows
+			// even when the NDVs are plentiful; the segment receiving the
+			// most common key gets all of its rows on top of an even share
+			// of the rest, so penalize with that segment's load relative
+			// to the average, once the key is frequent enough to count as
+			// hot
+			if (GPOS_FTRACE(EopttracePenalizeSkewMCV))
+			{
+				CDouble max_freq = CPhysical::GetMaxKeyFreq(
+					pci->Pcstats(ul)->Pstats(), motion->Pds());
+				if (max_freq >= dPenalizeSkewMCVThreshold)
+				{
+					CDouble sk = 1.0 + max_freq * (pcmgpdb->UlHosts() - 1);
+					skew_ratio =
+						CDouble(std::max(sk.Get(), skew_ratio.Get()));
+				}
+			}
+
 			ULONG skew_factor = optimizer_config->GetHint()->UlSkewFactor();
 			if (skew_factor > 0)
 			{
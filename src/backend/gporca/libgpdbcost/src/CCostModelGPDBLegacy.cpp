@@ -61,6 +61,7 @@ const CCostModelGPDBLegacy::SCostMapping CCostModelGPDBLegacy::m_rgcm[] = {
 	{COperator::EopPhysicalLeftAntiSemiHashJoinNotIn, CostHashJoin},
 	{COperator::EopPhysicalLeftOuterHashJoin, CostHashJoin},
 	{COperator::EopPhysicalRightOuterHashJoin, CostHashJoin},
+	{COperator::EopPhysicalFullHashJoin, CostHashJoin},
 
 	{COperator::EopPhysicalInnerIndexNLJoin, CostIndexNLJoin},
 	{COperator::EopPhysicalLeftOuterIndexNLJoin, CostIndexNLJoin},
@@ -712,7 +713,8 @@ CCostModelGPDBLegacy::CostHashJoin(CMemoryPool *,  // mp
 				COperator::EopPhysicalLeftAntiSemiHashJoin == op_id ||
 				COperator::EopPhysicalLeftAntiSemiHashJoinNotIn == op_id ||
 				COperator::EopPhysicalLeftOuterHashJoin == op_id ||
-				COperator::EopPhysicalRightOuterHashJoin == op_id);
+				COperator::EopPhysicalRightOuterHashJoin == op_id ||
+				COperator::EopPhysicalFullHashJoin == op_id);
 #endif	// GPOS_DEBUG
 
 	DOUBLE num_rows_outer = pci->PdRows()[0];
@@ -186,6 +186,10 @@ const CDouble CCostModelParamsGPDB::DPenalizeHJSkewUpperLimit(10.0);
 // default scalar func cost
 const CDouble CCostModelParamsGPDB::DScalarFuncCost(1.0e-04);
 
+// see CCostModelGPDB::CostHashJoin() for how the frequency of the most
+// common value of a redistribute key is used
+const CDouble CCostModelParamsGPDB::DPenalizeSkewMCVThreshold(0.1);
+
 #define GPOPT_COSTPARAM_NAME_MAX_LENGTH 80
 
 // parameter names in the same order of param enumeration
@@ -436,6 +440,10 @@ CCostModelParamsGPDB::CCostModelParamsGPDB(CMemoryPool *mp) : m_mp(mp)
 	m_rgpcp[EcpScalarFuncCost] =
 		GPOS_NEW(mp) SCostParam(EcpScalarFuncCost, DScalarFuncCost,
 								DScalarFuncCost - 0.0, DScalarFuncCost + 0.0);
+
+	m_rgpcp[EcpPenalizeSkewMCVThreshold] = GPOS_NEW(mp)
+		SCostParam(EcpPenalizeSkewMCVThreshold, DPenalizeSkewMCVThreshold,
+				   0.0, 1.0);
 }
 
 
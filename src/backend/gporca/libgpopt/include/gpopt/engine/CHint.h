@@ -20,6 +20,7 @@
 #define PUSH_GROUP_BY_BELOW_SETOP_THRESHOLD ULONG(10)
 #define XFORM_BIND_THRESHOLD ULONG(0)
 #define SKEW_FACTOR ULONG(0)
+#define JOIN_ORDER_BUDGET ULONG(0)
 
 
 namespace gpopt
@@ -55,13 +56,15 @@ private:
 	CHint(const CHint &);
 	ULONG m_ulSkewFactor;
 
+	ULONG m_ulJoinOrderBudget;
+
 public:
 	// ctor
 	CHint(ULONG join_arity_for_associativity_commutativity,
 		  ULONG array_expansion_threshold, ULONG ulJoinOrderDPLimit,
 		  ULONG broadcast_threshold, BOOL enforce_constraint_on_dml,
 		  ULONG push_group_by_below_setop_threshold, ULONG xform_bind_threshold,
-		  ULONG skew_factor)
+		  ULONG skew_factor, ULONG join_order_budget)
 		: m_ulJoinArityForAssociativityCommutativity(
 			  join_arity_for_associativity_commutativity),
 		  m_ulArrayExpansionThreshold(array_expansion_threshold),
@@ -71,7 +74,8 @@ public:
 		  m_ulPushGroupByBelowSetopThreshold(
 			  push_group_by_below_setop_threshold),
 		  m_ulXform_bind_threshold(xform_bind_threshold),
-		  m_ulSkewFactor(skew_factor)
+		  m_ulSkewFactor(skew_factor),
+		  m_ulJoinOrderBudget(join_order_budget)
 	{
 	}
 
@@ -143,6 +147,15 @@ public:
 		return m_ulSkewFactor;
 	}
 
+	// Number of join pairs after which adaptive join ordering stops the
+	// dynamic programming enumeration and completes the join greedily,
+	// 0 means no limit
+	ULONG
+	UlJoinOrderBudget() const
+	{
+		return m_ulJoinOrderBudget;
+	}
+
 	// generate default hint configurations, which disables sort during insert on
 	// append only row-oriented partitioned tables by default
 	static CHint *
@@ -156,7 +169,8 @@ public:
 			true,								 /* enforce_constraint_on_dml */
 			PUSH_GROUP_BY_BELOW_SETOP_THRESHOLD, /* push_group_by_below_setop_threshold */
 			XFORM_BIND_THRESHOLD,				 /* xform_bind_threshold */
-			SKEW_FACTOR							 /* skew_factor */
+			SKEW_FACTOR,						 /* skew_factor */
+			JOIN_ORDER_BUDGET					 /* join_order_budget */
 		);
 	}
 
@@ -222,6 +222,10 @@ private:
 	// this time is currently dominated by serialization time
 	CDouble m_dFetchTime;
 
+	// total time consumed in prefetching MD objects before optimization
+	// (including lookup and fetch time)
+	CDouble m_dPrefetchTime;
+
 	// private copy ctor
 	CMDAccessor(const CMDAccessor &);
 
@@ -354,6 +358,10 @@ public:
 	// retrieve a relation stats object from the cache
 	const IMDRelStats *Pmdrelstats(IMDId *mdid);
 
+	// retrieve the stats objects of the given relations, so that they are
+	// available in the accessor when statistics are derived
+	void PrefetchRelStats(MdidHashSet *rel_mdids);
+
 	// retrieve a cast object from the cache
 	const IMDCast *Pmdcast(IMDId *mdid_src, IMDId *mdid_dest);
 
@@ -44,6 +44,18 @@ private:
 	// the maximum size of the cache
 	static ULLONG m_ullCacheQuota;
 
+	// number of cache lookups that found the object, per object type
+	static ULLONG m_rgullHits[IMDCacheObject::EmdtSentinel];
+
+	// number of cache lookups that missed the object, per object type
+	static ULLONG m_rgullMisses[IMDCacheObject::EmdtSentinel];
+
+	// number of objects evicted from the cache, per object type
+	static ULLONG m_rgullEvictions[IMDCacheObject::EmdtSentinel];
+
+	// eviction callback of the underlying cache
+	static void RecordEviction(IMDCacheObject *pmdobj);
+
 	// private ctor
 	CMDCache(){};
 
@@ -76,9 +88,28 @@ public:
 	// get the number of times we evicted entries from this cache
 	static ULLONG ULLGetCacheEvictionCounter();
 
+	// count a lookup of an object of the given type
+	static void RecordLookup(IMDCacheObject::Emdtype mdtype, BOOL fHit);
+
+	// get the number of lookups of the given object type that hit the cache
+	static ULLONG ULLGetHits(IMDCacheObject::Emdtype mdtype);
+
+	// get the number of lookups of the given object type that missed the cache
+	static ULLONG ULLGetMisses(IMDCacheObject::Emdtype mdtype);
+
+	// get the number of evicted objects of the given type
+	static ULLONG ULLGetEvictions(IMDCacheObject::Emdtype mdtype);
+
+	// get the name of the given object type
+	static const CHAR *SzMDType(IMDCacheObject::Emdtype mdtype);
+
 	// reset global instance
 	static void Reset();
 
+	// remove the given relations, their statistics and the objects they
+	// reference from the cache
+	static void InvalidateRelations(CMemoryPool *mp, IMdIdArray *rel_mdids);
+
 	// global accessor
 	static CMDAccessor::MDCache *
 	Pcache()
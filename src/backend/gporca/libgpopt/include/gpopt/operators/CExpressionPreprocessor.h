@@ -158,6 +158,18 @@ private:
 	static CExpression *PexprOuterJoinToInnerJoin(CMemoryPool *mp,
 												  CExpression *pexpr);
 
+	// check if the inner side of a left outer join can be dropped
+	static BOOL FRedundantLeftOuterJoin(CMemoryPool *mp, CExpression *pexpr,
+										CColRefSet *pcrsReqd);
+
+	// remove left outer joins whose inner side is not needed
+	static CExpression *PexprRemoveRedundantLeftOuterJoins(
+		CMemoryPool *mp, CExpression *pexpr, CColRefSet *pcrsReqd);
+
+	// workhorse for removing redundant left outer joins
+	static CExpression *PexprRemoveRedundantLeftOuterJoinsRecursive(
+		CMemoryPool *mp, CExpression *pexpr, CColRefSet *pcrsReqd);
+
 	// eliminate CTE Anchors for CTEs that have zero consumers
 	static CExpression *PexprRemoveUnusedCTEs(CMemoryPool *mp,
 											  CExpression *pexpr);
@@ -42,6 +42,9 @@ private:
 	// frames of child window functions
 	CWindowFrameArray *m_pdrgpwf;
 
+	// global or local sequence project
+	COperator::ESPType m_esptype;
+
 	// flag indicating if current operator has any non-empty order specs
 	BOOL m_fHasOrderSpecs;
 
@@ -54,14 +57,21 @@ private:
 	// set the flag indicating that SeqPrj has specified frame specs
 	void SetHasFrameSpecs(CMemoryPool *mp);
 
+	// bound the row_number() and rank() columns of a local sequence project
+	// by the size of the partitions on each segment
+	IStatistics *PstatsBoundLocalRanks(CMemoryPool *mp,
+									   CExpressionHandle &exprhdl,
+									   IStatistics *stats) const;
+
 	// private copy ctor
 	CLogicalSequenceProject(const CLogicalSequenceProject &);
 
 public:
 	// ctor
-	CLogicalSequenceProject(CMemoryPool *mp, CDistributionSpec *pds,
-							COrderSpecArray *pdrgpos,
-							CWindowFrameArray *pdrgpwf);
+	CLogicalSequenceProject(
+		CMemoryPool *mp, CDistributionSpec *pds, COrderSpecArray *pdrgpos,
+		CWindowFrameArray *pdrgpwf,
+		COperator::ESPType esptype = COperator::EsptypeGlobal);
 
 	// ctor for pattern
 	explicit CLogicalSequenceProject(CMemoryPool *mp);
@@ -104,6 +114,13 @@ public:
 		return m_pdrgpwf;
 	}
 
+	// sequence project type
+	COperator::ESPType
+	Esptype() const
+	{
+		return m_esptype;
+	}
+
 	// return true if non-empty order specs are used by current operator
 	BOOL
 	FHasOrderSpecs() const
@@ -220,6 +220,7 @@ public:
 		EopPhysicalLeftAntiSemiHashJoin,
 		EopPhysicalLeftAntiSemiHashJoinNotIn,
 		EopPhysicalRightOuterHashJoin,
+		EopPhysicalFullHashJoin,
 
 		EopPhysicalMotionGather,
 		EopPhysicalMotionBroadcast,
@@ -274,6 +275,15 @@ public:
 		EgbaggtypeSentinel
 	};
 
+	// sequence project type
+	enum ESPType
+	{
+		EsptypeGlobal,	// computes window functions over whole partitions
+		EsptypeLocal,	// computes window functions over each segment's rows
+
+		EsptypeSentinel
+	};
+
 	// coercion form
 	enum ECoercionForm
 	{
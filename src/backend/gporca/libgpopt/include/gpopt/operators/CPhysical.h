@@ -333,6 +333,10 @@ public:
 	// helper to compute skew estimate based on given stats and distribution spec
 	static CDouble GetSkew(IStatistics *stats, CDistributionSpec *pds);
 
+	// helper to estimate the fraction of rows sharing the most common
+	// distribution key value, based on given stats and distribution spec
+	static CDouble GetMaxKeyFreq(IStatistics *stats, CDistributionSpec *pds);
+
 	// type of operator
 	virtual BOOL
 	FPhysical() const
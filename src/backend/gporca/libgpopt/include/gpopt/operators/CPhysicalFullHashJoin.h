@@ -0,0 +1,99 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CPhysicalFullHashJoin.h
+//
+//	@doc:
+//		Full outer hash join operator
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CPhysicalFullHashJoin_H
+#define GPOPT_CPhysicalFullHashJoin_H
+
+#include "gpos/base.h"
+
+#include "gpopt/operators/CPhysicalHashJoin.h"
+
+namespace gpopt
+{
+//---------------------------------------------------------------------------
+//	@class:
+//		CPhysicalFullHashJoin
+//
+//	@doc:
+//		Full outer hash join operator; both sides are preserved, so the
+//		children must be co-located on the join keys or both be singleton,
+//		neither side may be broadcast
+//
+//---------------------------------------------------------------------------
+class CPhysicalFullHashJoin : public CPhysicalHashJoin
+{
+private:
+	// private copy ctor
+	CPhysicalFullHashJoin(const CPhysicalFullHashJoin &);
+
+public:
+	// ctor
+	CPhysicalFullHashJoin(CMemoryPool *mp, CExpressionArray *pdrgpexprOuterKeys,
+						  CExpressionArray *pdrgpexprInnerKeys,
+						  IMdIdArray *hash_opfamilies = NULL,
+						  BOOL is_null_aware = true,
+						  CXform::EXformId origin_xform = CXform::ExfSentinel);
+
+	// dtor
+	virtual ~CPhysicalFullHashJoin();
+
+	// ident accessors
+	virtual EOperatorId
+	Eopid() const
+	{
+		return EopPhysicalFullHashJoin;
+	}
+
+	// return a string for operator name
+	virtual const CHAR *
+	SzId() const
+	{
+		return "CPhysicalFullHashJoin";
+	}
+
+	// conversion function
+	static CPhysicalFullHashJoin *
+	PopConvert(COperator *pop)
+	{
+		GPOS_ASSERT(NULL != pop);
+		GPOS_ASSERT(EopPhysicalFullHashJoin == pop->Eopid());
+
+		return dynamic_cast<CPhysicalFullHashJoin *>(pop);
+	}
+
+	//-------------------------------------------------------------------------------------
+	// Required Plan Properties
+	//-------------------------------------------------------------------------------------
+
+	// compute required distribution of the n-th child
+	virtual CEnfdDistribution *Ped(CMemoryPool *mp, CExpressionHandle &exprhdl,
+								   CReqdPropPlan *prppInput, ULONG child_index,
+								   CDrvdPropArray *pdrgpdpCtxt, ULONG ulOptReq);
+
+	// distribution matching type
+	virtual CEnfdDistribution::EDistributionMatching Edm(
+		CReqdPropPlan *prppInput, ULONG child_index,
+		CDrvdPropArray *pdrgpdpCtxt, ULONG ulOptReq);
+
+	//-------------------------------------------------------------------------------------
+	// Derived Plan Properties
+	//-------------------------------------------------------------------------------------
+
+	// derive distribution
+	virtual CDistributionSpec *PdsDerive(CMemoryPool *mp,
+										 CExpressionHandle &exprhdl) const;
+
+};	// class CPhysicalFullHashJoin
+
+}  // namespace gpopt
+
+#endif	// !GPOPT_CPhysicalFullHashJoin_H
+
+// EOF
@@ -41,6 +41,9 @@ private:
 	// frames of child window functions
 	CWindowFrameArray *m_pdrgpwf;
 
+	// global or local sequence project
+	COperator::ESPType m_esptype;
+
 	// order spec to request from child
 	COrderSpec *m_pos;
 
@@ -58,9 +61,10 @@ private:
 
 public:
 	// ctor
-	CPhysicalSequenceProject(CMemoryPool *mp, CDistributionSpec *pds,
-							 COrderSpecArray *pdrgpos,
-							 CWindowFrameArray *pdrgpwf);
+	CPhysicalSequenceProject(
+		CMemoryPool *mp, CDistributionSpec *pds, COrderSpecArray *pdrgpos,
+		CWindowFrameArray *pdrgpwf,
+		COperator::ESPType esptype = COperator::EsptypeGlobal);
 
 	// dtor
 	virtual ~CPhysicalSequenceProject();
@@ -100,6 +104,13 @@ public:
 		return m_pdrgpwf;
 	}
 
+	// sequence project type
+	COperator::ESPType
+	Esptype() const
+	{
+		return m_esptype;
+	}
+
 	// match function
 	virtual BOOL Matches(COperator *pop) const;
 
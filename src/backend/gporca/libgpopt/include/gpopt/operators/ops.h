@@ -136,6 +136,7 @@
 #include "gpopt/operators/CPhysicalDynamicTableScan.h"
 #include "gpopt/operators/CPhysicalExternalScan.h"
 #include "gpopt/operators/CPhysicalFilter.h"
+#include "gpopt/operators/CPhysicalFullHashJoin.h"
 #include "gpopt/operators/CPhysicalHashAgg.h"
 #include "gpopt/operators/CPhysicalHashAggDeduplicate.h"
 #include "gpopt/operators/CPhysicalHashJoin.h"
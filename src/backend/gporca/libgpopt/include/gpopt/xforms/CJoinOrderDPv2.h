@@ -445,6 +445,28 @@ private:
 	// outer references, if any
 	CColRefSet *m_outer_refs;
 
+	// how the DP enumeration searches the join orders
+	enum EJoinOrderSearch
+	{
+		// DP over all groups, no limits
+		EJoinOrderSearchExhaustive,
+		// DP with a limit for the number of groups per level,
+		// derived from the DP threshold
+		EJoinOrderSearchTopK,
+		// DP over the intervals of the GreedyAvoidXProd join order
+		EJoinOrderSearchLinearized
+	};
+
+	EJoinOrderSearch m_search_strategy;
+
+	// when the join graph is connected, a DP never needs a cross product,
+	// so adaptive join ordering can skip them
+	BOOL m_skip_cross_products;
+
+	// number of join pairs built so far, the unit of the adaptive join
+	// order budget
+	ULLONG m_num_join_pairs;
+
 	CMemoryPool *m_mp;
 
 	SLevelInfo *
@@ -530,11 +552,28 @@ private:
 	static ULONG NChooseK(ULONG n, ULONG k);
 	BOOL LevelIsFull(ULONG level);
 
+	// is there a join predicate between the two sets of atoms?
+	BOOL AreConnected(CBitSet *left_atoms, CBitSet *right_atoms) const;
+
+	// estimate the size of the search space from the join graph shape
+	// and choose the DP enumeration to use
+	void ChooseSearchStrategy();
+
+	// restrict all levels above the given level to a single group
+	void LimitLevelsToGreedy(ULONG level);
+
+	// find the group of the atoms in the given interval of a join order
+	SGroupInfo *GetIntervalGroup(const ULONG *atom_order, ULONG start,
+								 ULONG end);
+
 	void EnumerateDP();
 	void EnumerateQuery();
 	void FindLowestCardTwoWayJoin(JoinOrderPropType prop_type);
 	void EnumerateMinCard();
 	void EnumerateGreedyAvoidXProd();
+	void AddAtomsInJoinOrder(const SGroupAndExpression &group_and_expr,
+							 ULONG *atom_order, ULONG *num_atoms);
+	void EnumerateLinearizedDP();
 
 public:
 	// ctor
@@ -224,6 +224,9 @@ public:
 		ExfLeftJoin2RightJoin,
 		ExfRightOuterJoin2HashJoin,
 		ExfImplementInnerJoin,
+		ExfFullOuterJoin2HashJoin,
+		ExfInnerJoinSemiJoinReduction,
+		ExfSplitWindowTopN,
 		ExfInvalid,
 		ExfSentinel = ExfInvalid
 	};
@@ -341,6 +344,9 @@ public:
 	// returns a set containing xforms to use for exhaustive2 join order
 	static CBitSet *PbsJoinOrderOnExhaustive2Xforms(CMemoryPool *mp);
 
+	// returns a set containing xforms to use for adaptive join order
+	static CBitSet *PbsJoinOrderOnAdaptiveXforms(CMemoryPool *mp);
+
 	// return true if xform should be applied only once.
 	// for expression of type CPatternTree, in deep trees, the number
 	// of expressions generated for group expression can be significantly
@@ -0,0 +1,75 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CXformFullOuterJoin2HashJoin.h
+//
+//	@doc:
+//		Transform full outer join to full outer hash join
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CXformFullOuterJoin2HashJoin_H
+#define GPOPT_CXformFullOuterJoin2HashJoin_H
+
+#include "gpos/base.h"
+
+#include "gpopt/xforms/CXformImplementation.h"
+
+namespace gpopt
+{
+using namespace gpos;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CXformFullOuterJoin2HashJoin
+//
+//	@doc:
+//		Transform full outer join to full outer hash join
+//
+//---------------------------------------------------------------------------
+class CXformFullOuterJoin2HashJoin : public CXformImplementation
+{
+private:
+	// private copy ctor
+	CXformFullOuterJoin2HashJoin(const CXformFullOuterJoin2HashJoin &);
+
+
+public:
+	// ctor
+	explicit CXformFullOuterJoin2HashJoin(CMemoryPool *mp);
+
+	// dtor
+	virtual ~CXformFullOuterJoin2HashJoin()
+	{
+	}
+
+	// ident accessors
+	virtual EXformId
+	Exfid() const
+	{
+		return ExfFullOuterJoin2HashJoin;
+	}
+
+	// return a string for xform name
+	virtual const CHAR *
+	SzId() const
+	{
+		return "CXformFullOuterJoin2HashJoin";
+	}
+
+	// compute xform promise for a given expression handle
+	virtual EXformPromise Exfp(CExpressionHandle &exprhdl) const;
+
+
+	// actual transform
+	void Transform(CXformContext *pxfctxt, CXformResult *pxfres,
+				   CExpression *pexpr) const;
+
+};	// class CXformFullOuterJoin2HashJoin
+
+}  // namespace gpopt
+
+
+#endif	// !GPOPT_CXformFullOuterJoin2HashJoin_H
+
+// EOF
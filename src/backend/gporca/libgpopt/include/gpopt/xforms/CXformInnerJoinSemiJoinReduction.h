@@ -0,0 +1,121 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CXformInnerJoinSemiJoinReduction.h
+//
+//	@doc:
+//		Reduce the larger side of an inner join by a semi join with the
+//		distinct join keys of the smaller side before joining them:
+//
+//		Transform
+//      InnerJoin
+//        |--Big
+//        +--Small
+//
+// 		to
+//
+//      CTEAnchor(A)
+//      +---InnerJoin
+//          |---LeftSemiJoin_(key(Big) = key(Small))
+//          |   |---Big
+//          |   +---Gb(keys(Small))
+//          |       +---CTEConsumer(A)
+//          +---CTEConsumer(A)
+//
+//		where A is the CTE that produces Small. Only the distinct keys
+//		of the smaller side need to be moved to filter the larger side
+//		locally, so only the rows of the larger side that survive the
+//		semi join have to be redistributed for the final join.
+//
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CXformInnerJoinSemiJoinReduction_H
+#define GPOPT_CXformInnerJoinSemiJoinReduction_H
+
+#include "gpos/base.h"
+
+#include "gpopt/xforms/CXformExploration.h"
+
+namespace gpopt
+{
+using namespace gpos;
+
+class CXformInnerJoinSemiJoinReduction : public CXformExploration
+{
+private:
+	// the larger side must be at least this many times larger than the
+	// smaller side
+	static const DOUBLE m_dLargeSmallRatioThreshold;
+
+	// the join must keep at most this fraction of the rows of the
+	// larger side
+	static const DOUBLE m_dReductionThreshold;
+
+	// disable copy ctor
+	CXformInnerJoinSemiJoinReduction(const CXformInnerJoinSemiJoinReduction &);
+
+	// was the given join child produced by this xform
+	static BOOL FReducedChild(CExpression *pexprChild);
+
+	// extract the equality conjuncts between the two join sides
+	static CExpressionArray *PdrgpexprEquiJoinConjuncts(
+		CMemoryPool *mp, CExpression *pexprScalar, CColRefSet *pcrsBig,
+		CColRefSet *pcrsSmall);
+
+public:
+	// ctor
+	explicit CXformInnerJoinSemiJoinReduction(CMemoryPool *mp);
+
+	// dtor
+	virtual ~CXformInnerJoinSemiJoinReduction()
+	{
+	}
+
+	// identifier
+	virtual EXformId
+	Exfid() const
+	{
+		return ExfInnerJoinSemiJoinReduction;
+	}
+
+	// return a string for the xform name
+	virtual const CHAR *
+	SzId() const
+	{
+		return "CXformInnerJoinSemiJoinReduction";
+	}
+
+	// compatibility function, do not reduce joins produced by this xform
+	virtual BOOL
+	FCompatible(CXform::EXformId exfid)
+	{
+		return CXform::ExfInnerJoinSemiJoinReduction != exfid;
+	}
+
+	// compute xform promise for a given expression handle
+	virtual EXformPromise Exfp(CExpressionHandle &exprhdl) const;
+
+	// do stats need to be computed before applying xform?
+	virtual BOOL
+	FNeedsStats() const
+	{
+		return true;
+	}
+
+	// actual transform
+	virtual void Transform(CXformContext *pxfctxt, CXformResult *pxfres,
+						   CExpression *pexpr) const;
+
+	// return true if xform should be applied only once
+	virtual BOOL
+	IsApplyOnce()
+	{
+		return true;
+	}
+};
+}  // namespace gpopt
+
+#endif	// !GPOPT_CXformInnerJoinSemiJoinReduction_H
+
+// EOF
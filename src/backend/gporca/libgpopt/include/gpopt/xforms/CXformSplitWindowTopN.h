@@ -0,0 +1,95 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CXformSplitWindowTopN.h
+//
+//	@doc:
+//		Pre-filter the input of a window followed by a top-N filter on
+//		row_number() or rank() on each segment:
+//
+//		Transform
+//      Select (rn <= N)
+//        +--SequenceProject (rn := row_number())
+//           +--Child
+//
+// 		to
+//
+//      Select (rn <= N)
+//        +--SequenceProject (rn := row_number())
+//           +--Select (rn' <= N)
+//              +--SequenceProject (Local, rn' := row_number())
+//                 +--Child
+//
+//		The local stage runs before the data is moved for the global
+//		window, so it cuts down the rows that have to be sorted and
+//		redistributed. It is only an alternative; the plan without it
+//		wins when the partitions on each segment are not much larger
+//		than N.
+//
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CXformSplitWindowTopN_H
+#define GPOPT_CXformSplitWindowTopN_H
+
+#include "gpos/base.h"
+
+#include "gpopt/xforms/CXformExploration.h"
+
+namespace gpopt
+{
+using namespace gpos;
+
+class CXformSplitWindowTopN : public CXformExploration
+{
+private:
+	// disable copy ctor
+	CXformSplitWindowTopN(const CXformSplitWindowTopN &);
+
+	// return the window function of the given sequence project that the
+	// given predicate bounds from above
+	static CExpression *PexprTopNFunc(CExpression *pexprSeqPrj,
+									  CExpression *pexprPred);
+
+public:
+	// ctor
+	explicit CXformSplitWindowTopN(CMemoryPool *mp);
+
+	// dtor
+	virtual ~CXformSplitWindowTopN()
+	{
+	}
+
+	// identifier
+	virtual EXformId
+	Exfid() const
+	{
+		return ExfSplitWindowTopN;
+	}
+
+	// return a string for the xform name
+	virtual const CHAR *
+	SzId() const
+	{
+		return "CXformSplitWindowTopN";
+	}
+
+	// compatibility function, do not split windows produced by this xform
+	virtual BOOL
+	FCompatible(CXform::EXformId exfid)
+	{
+		return CXform::ExfSplitWindowTopN != exfid;
+	}
+
+	// compute xform promise for a given expression handle
+	virtual EXformPromise Exfp(CExpressionHandle &exprhdl) const;
+
+	// actual transform
+	virtual void Transform(CXformContext *pxfctxt, CXformResult *pxfres,
+						   CExpression *pexpr) const;
+};
+}  // namespace gpopt
+
+#endif	// !GPOPT_CXformSplitWindowTopN_H
+
+// EOF
@@ -40,6 +40,7 @@
 #include "gpopt/xforms/CXformExpandNAryJoinMinCard.h"
 #include "gpopt/xforms/CXformExternalGet2ExternalScan.h"
 #include "gpopt/xforms/CXformFactory.h"
+#include "gpopt/xforms/CXformFullOuterJoin2HashJoin.h"
 #include "gpopt/xforms/CXformGbAgg2Apply.h"
 #include "gpopt/xforms/CXformGbAgg2HashAgg.h"
 #include "gpopt/xforms/CXformGbAgg2ScalarAgg.h"
@@ -85,6 +86,7 @@
 #include "gpopt/xforms/CXformInnerJoin2PartialDynamicIndexGetApply.h"
 #include "gpopt/xforms/CXformInnerJoinAntiSemiJoinNotInSwap.h"
 #include "gpopt/xforms/CXformInnerJoinAntiSemiJoinSwap.h"
+#include "gpopt/xforms/CXformInnerJoinSemiJoinReduction.h"
 #include "gpopt/xforms/CXformInnerJoinSemiJoinSwap.h"
 #include "gpopt/xforms/CXformInnerJoinWithInnerSelect2PartialDynamicIndexGetApply.h"
 #include "gpopt/xforms/CXformInsert2DML.h"
@@ -155,6 +157,7 @@
 #include "gpopt/xforms/CXformSplitGbAgg.h"
 #include "gpopt/xforms/CXformSplitGbAggDedup.h"
 #include "gpopt/xforms/CXformSplitLimit.h"
+#include "gpopt/xforms/CXformSplitWindowTopN.h"
 #include "gpopt/xforms/CXformSubqJoin2Apply.h"
 #include "gpopt/xforms/CXformSubqNAryJoin2Apply.h"
 #include "gpopt/xforms/CXformUnion2UnionAll.h"
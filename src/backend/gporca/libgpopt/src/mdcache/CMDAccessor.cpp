@@ -23,6 +23,7 @@
 #include "gpopt/base/CColRefTable.h"
 #include "gpopt/exception.h"
 #include "gpopt/mdcache/CMDAccessorUtils.h"
+#include "gpopt/mdcache/CMDCache.h"
 #include "naucrates/dxl/CDXLUtils.h"
 #include "naucrates/exception.h"
 #include "naucrates/md/CMDIdCast.h"
@@ -240,7 +241,11 @@ CMDAccessor::SMDProviderElem::HashValue(const SMDProviderElem &mdpelem)
 //
 //---------------------------------------------------------------------------
 CMDAccessor::CMDAccessor(CMemoryPool *mp, MDCache *pcache)
-	: m_mp(mp), m_pcache(pcache), m_dLookupTime(0.0), m_dFetchTime(0.0)
+	: m_mp(mp),
+	  m_pcache(pcache),
+	  m_dLookupTime(0.0),
+	  m_dFetchTime(0.0),
+	  m_dPrefetchTime(0.0)
 {
 	GPOS_ASSERT(NULL != m_mp);
 	GPOS_ASSERT(NULL != m_pcache);
@@ -260,7 +265,11 @@ CMDAccessor::CMDAccessor(CMemoryPool *mp, MDCache *pcache)
 //---------------------------------------------------------------------------
 CMDAccessor::CMDAccessor(CMemoryPool *mp, MDCache *pcache, CSystemId sysid,
 						 IMDProvider *pmdp)
-	: m_mp(mp), m_pcache(pcache), m_dLookupTime(0.0), m_dFetchTime(0.0)
+	: m_mp(mp),
+	  m_pcache(pcache),
+	  m_dLookupTime(0.0),
+	  m_dFetchTime(0.0),
+	  m_dPrefetchTime(0.0)
 {
 	GPOS_ASSERT(NULL != m_mp);
 	GPOS_ASSERT(NULL != m_pcache);
@@ -284,7 +293,11 @@ CMDAccessor::CMDAccessor(CMemoryPool *mp, MDCache *pcache, CSystemId sysid,
 CMDAccessor::CMDAccessor(CMemoryPool *mp, MDCache *pcache,
 						 const CSystemIdArray *pdrgpsysid,
 						 const CMDProviderArray *pdrgpmdp)
-	: m_mp(mp), m_pcache(pcache), m_dLookupTime(0.0), m_dFetchTime(0.0)
+	: m_mp(mp),
+	  m_pcache(pcache),
+	  m_dLookupTime(0.0),
+	  m_dFetchTime(0.0),
+	  m_dPrefetchTime(0.0)
 {
 	GPOS_ASSERT(NULL != m_mp);
 	GPOS_ASSERT(NULL != m_pcache);
@@ -382,6 +395,8 @@ CMDAccessor::~CMDAccessor()
 				<< std::endl;
 		at.Os() << "[OPT]: Total metadata lookup time (including fetch time): "
 				<< m_dLookupTime << "ms" << std::endl;
+		at.Os() << "[OPT]: Total metadata prefetch time: " << m_dPrefetchTime
+				<< "ms" << std::endl;
 	}
 }
 
@@ -568,6 +583,12 @@ CMDAccessor::GetImdObj(IMDId *mdid, IMDCacheObject::Emdtype mdtype)
 				// safely inserted
 				(void) a_pmdkeyCache.Reset();
 			}
+
+			CMDCache::RecordLookup(pmdobjNew->MDType(), false /*fHit*/);
+		}
+		else
+		{
+			CMDCache::RecordLookup(pmdobjNew->MDType(), true /*fHit*/);
 		}
 
 		{
@@ -918,6 +939,39 @@ CMDAccessor::Pmdrelstats(IMDId *mdid)
 	return dynamic_cast<const IMDRelStats *>(pmdobj);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessor::PrefetchRelStats
+//
+//	@doc:
+//		Retrieve the relation statistics of the given relations in one go,
+//		instead of one at a time as statistics derivation reaches each of
+//		the relations during optimization
+//
+//---------------------------------------------------------------------------
+void
+CMDAccessor::PrefetchRelStats(MdidHashSet *rel_mdids)
+{
+	GPOS_ASSERT(NULL != rel_mdids);
+
+	CTimerUser timerPrefetch;
+	timerPrefetch.Restart();
+
+	MdidHashSetIter hsiter(rel_mdids);
+	while (hsiter.Advance())
+	{
+		IMDId *rel_mdid = const_cast<IMDId *>(hsiter.Get());
+		rel_mdid->AddRef();
+		CMDIdRelStats *rel_stats_mdid =
+			GPOS_NEW(m_mp) CMDIdRelStats(CMDIdGPDB::CastMdid(rel_mdid));
+		(void) Pmdrelstats(rel_stats_mdid);
+		rel_stats_mdid->Release();
+	}
+
+	CDouble dPrefetch(timerPrefetch.ElapsedUS() / CDouble(GPOS_USEC_IN_MSEC));
+	m_dPrefetchTime = CDouble(m_dPrefetchTime.Get() + dPrefetch.Get());
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDAccessor::Pmdcast
@@ -13,10 +13,122 @@
 
 #include "gpos/task/CAutoTraceFlag.h"
 
+#include "naucrates/md/CMDIdColStats.h"
+#include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/md/CMDIdRelStats.h"
+#include "naucrates/md/IMDRelation.h"
+
 using namespace gpos;
 using namespace gpmd;
 using namespace gpopt;
 
+// context for removing relations from the cache
+struct SInvalidateRelationsCtxt
+{
+	// relations to remove
+	IMdIdArray *m_rel_mdids;
+
+	// indexes, triggers and check constraints of the removed relations
+	IMdIdArray *m_dependent_mdids;
+};
+
+// does the given mdid identify one of the given relations
+static BOOL
+FRelationMdid(IMdIdArray *rel_mdids, IMDId *mdid)
+{
+	const CMDIdGPDB *mdid_gpdb = CMDIdGPDB::CastMdid(mdid);
+	if (NULL == mdid_gpdb)
+	{
+		return false;
+	}
+
+	const ULONG size = rel_mdids->Size();
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		if (CMDIdGPDB::CastMdid((*rel_mdids)[ul])->Oid() == mdid_gpdb->Oid())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// append the mdid to the array
+static void
+AppendMdid(IMdIdArray *mdids, IMDId *mdid)
+{
+	mdid->AddRef();
+	mdids->Append(mdid);
+}
+
+// is the cached object one of the relations or derived from it
+static BOOL
+FDerivedFromRelation(IMDCacheObject *md_obj, void *arg)
+{
+	SInvalidateRelationsCtxt *ctxt = (SInvalidateRelationsCtxt *) arg;
+
+	switch (md_obj->MDType())
+	{
+		case IMDCacheObject::EmdtRel:
+		{
+			if (!FRelationMdid(ctxt->m_rel_mdids, md_obj->MDId()))
+			{
+				return false;
+			}
+
+			// the objects the relation points to are cached under their
+			// own keys, remember them for the second pass
+			const IMDRelation *md_rel =
+				dynamic_cast<const IMDRelation *>(md_obj);
+			for (ULONG ul = 0; ul < md_rel->IndexCount(); ul++)
+			{
+				AppendMdid(ctxt->m_dependent_mdids, md_rel->IndexMDidAt(ul));
+			}
+			for (ULONG ul = 0; ul < md_rel->TriggerCount(); ul++)
+			{
+				AppendMdid(ctxt->m_dependent_mdids, md_rel->TriggerMDidAt(ul));
+			}
+			for (ULONG ul = 0; ul < md_rel->CheckConstraintCount(); ul++)
+			{
+				AppendMdid(ctxt->m_dependent_mdids,
+						   md_rel->CheckConstraintMDidAt(ul));
+			}
+			return true;
+		}
+		case IMDCacheObject::EmdtInd:
+			return FRelationMdid(ctxt->m_rel_mdids, md_obj->MDId());
+		case IMDCacheObject::EmdtRelStats:
+			return FRelationMdid(
+				ctxt->m_rel_mdids,
+				CMDIdRelStats::CastMdid(md_obj->MDId())->GetRelMdId());
+		case IMDCacheObject::EmdtColStats:
+			return FRelationMdid(
+				ctxt->m_rel_mdids,
+				CMDIdColStats::CastMdid(md_obj->MDId())->GetRelMdId());
+		default:
+			return false;
+	}
+}
+
+// is the cached object referenced by one of the removed relations
+static BOOL
+FReferencedByRelation(IMDCacheObject *md_obj, void *arg)
+{
+	SInvalidateRelationsCtxt *ctxt = (SInvalidateRelationsCtxt *) arg;
+
+	const ULONG size = ctxt->m_dependent_mdids->Size();
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		if (md_obj->MDId()->Equals((*ctxt->m_dependent_mdids)[ul]))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 
 // global instance of metadata cache
 CMDAccessor::MDCache *CMDCache::m_pcache = NULL;
@@ -24,6 +136,27 @@ CMDAccessor::MDCache *CMDCache::m_pcache = NULL;
 // maximum size of the cache
 ULLONG CMDCache::m_ullCacheQuota = UNLIMITED_CACHE_QUOTA;
 
+// cache statistics per object type; kept across cache resets
+ULLONG CMDCache::m_rgullHits[IMDCacheObject::EmdtSentinel];
+ULLONG CMDCache::m_rgullMisses[IMDCacheObject::EmdtSentinel];
+ULLONG CMDCache::m_rgullEvictions[IMDCacheObject::EmdtSentinel];
+
+// names of object types, in the order of IMDCacheObject::Emdtype
+static const CHAR *rgszMDTypes[] = {"relation",
+									"index",
+									"function",
+									"aggregate",
+									"operator",
+									"type",
+									"trigger",
+									"check constraint",
+									"relation stats",
+									"column stats",
+									"cast",
+									"scalar comparison"};
+
+GPOS_CPL_ASSERT(GPOS_ARRAY_SIZE(rgszMDTypes) == IMDCacheObject::EmdtSentinel);
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDCache::Init
@@ -40,6 +173,7 @@ CMDCache::Init()
 	m_pcache = CCacheFactory::CreateCache<IMDCacheObject *, CMDKey *>(
 		true /*fUnique*/, m_ullCacheQuota, CMDKey::UlHashMDKey,
 		CMDKey::FEqualMDKey);
+	m_pcache->SetEvictFunc(RecordEviction);
 }
 
 
@@ -109,6 +243,108 @@ CMDCache::ULLGetCacheEvictionCounter()
 	return m_pcache->GetEvictionCounter();
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::RecordLookup
+//
+//	@doc:
+// 		Count a lookup of an object of the given type
+//
+//---------------------------------------------------------------------------
+void
+CMDCache::RecordLookup(IMDCacheObject::Emdtype mdtype, BOOL fHit)
+{
+	GPOS_ASSERT(IMDCacheObject::EmdtSentinel > mdtype);
+
+	if (fHit)
+	{
+		m_rgullHits[mdtype]++;
+	}
+	else
+	{
+		m_rgullMisses[mdtype]++;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::RecordEviction
+//
+//	@doc:
+// 		Count an object evicted from the cache
+//
+//---------------------------------------------------------------------------
+void
+CMDCache::RecordEviction(IMDCacheObject *pmdobj)
+{
+	m_rgullEvictions[pmdobj->MDType()]++;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::ULLGetHits
+//
+//	@doc:
+// 		Get the number of lookups of the given object type that hit the cache
+//
+//---------------------------------------------------------------------------
+ULLONG
+CMDCache::ULLGetHits(IMDCacheObject::Emdtype mdtype)
+{
+	GPOS_ASSERT(IMDCacheObject::EmdtSentinel > mdtype);
+
+	return m_rgullHits[mdtype];
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::ULLGetMisses
+//
+//	@doc:
+// 		Get the number of lookups of the given object type that missed the
+//		cache
+//
+//---------------------------------------------------------------------------
+ULLONG
+CMDCache::ULLGetMisses(IMDCacheObject::Emdtype mdtype)
+{
+	GPOS_ASSERT(IMDCacheObject::EmdtSentinel > mdtype);
+
+	return m_rgullMisses[mdtype];
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::ULLGetEvictions
+//
+//	@doc:
+// 		Get the number of evicted objects of the given type
+//
+//---------------------------------------------------------------------------
+ULLONG
+CMDCache::ULLGetEvictions(IMDCacheObject::Emdtype mdtype)
+{
+	GPOS_ASSERT(IMDCacheObject::EmdtSentinel > mdtype);
+
+	return m_rgullEvictions[mdtype];
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::SzMDType
+//
+//	@doc:
+// 		Get the name of the given object type
+//
+//---------------------------------------------------------------------------
+const CHAR *
+CMDCache::SzMDType(IMDCacheObject::Emdtype mdtype)
+{
+	GPOS_ASSERT(IMDCacheObject::EmdtSentinel > mdtype);
+
+	return rgszMDTypes[mdtype];
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDCache::Reset
@@ -129,4 +365,33 @@ CMDCache::Reset()
 	Init();
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::InvalidateRelations
+//
+//	@doc:
+//		Remove the given relations, their statistics, indexes, triggers and
+//		check constraints from the cache
+//
+//---------------------------------------------------------------------------
+void
+CMDCache::InvalidateRelations(CMemoryPool *mp, IMdIdArray *rel_mdids)
+{
+	GPOS_ASSERT(NULL != m_pcache && "Metadata cache was not created");
+	GPOS_ASSERT(NULL != rel_mdids);
+
+	SInvalidateRelationsCtxt ctxt;
+	ctxt.m_rel_mdids = rel_mdids;
+	ctxt.m_dependent_mdids = GPOS_NEW(mp) IMdIdArray(mp);
+
+	(void) m_pcache->DeleteEntries(FDerivedFromRelation, &ctxt);
+
+	if (0 < ctxt.m_dependent_mdids->Size())
+	{
+		(void) m_pcache->DeleteEntries(FReferencedByRelation, &ctxt);
+	}
+
+	ctxt.m_dependent_mdids->Release();
+}
+
 // EOF
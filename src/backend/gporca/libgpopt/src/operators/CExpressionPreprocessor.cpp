@@ -53,6 +53,7 @@
 #include "gpopt/operators/CScalarSubqueryQuantified.h"
 #include "gpopt/optimizer/COptimizerConfig.h"
 #include "gpopt/xforms/CXform.h"
+#include "naucrates/md/IMDFunction.h"
 #include "naucrates/md/IMDScalarOp.h"
 #include "naucrates/md/IMDType.h"
 #include "naucrates/statistics/CStatistics.h"
@@ -3072,6 +3073,152 @@ CExpressionPreprocessor::PexprTransposeSelectAndProject(CMemoryPool *mp,
 	}
 }
 
+// Check if the given left outer join produces exactly one row for each row
+// of its outer side while none of the inner side's columns are required.
+// This holds when the join predicate equates a key of the inner side to
+// expressions not depending on the inner side, since then each outer row
+// either finds a single match or is null-extended.
+BOOL
+CExpressionPreprocessor::FRedundantLeftOuterJoin(CMemoryPool *mp,
+												 CExpression *pexpr,
+												 CColRefSet *pcrsReqd)
+{
+	GPOS_ASSERT(COperator::EopLogicalLeftOuterJoin == pexpr->Pop()->Eopid());
+
+	CExpression *pexprInner = (*pexpr)[1];
+	CExpression *pexprPred = (*pexpr)[2];
+	CColRefSet *pcrsInner = pexprInner->DeriveOutputColumns();
+	CKeyCollection *pkc = pexprInner->DeriveKeyCollection();
+	if (!pcrsReqd->IsDisjoint(pcrsInner) || NULL == pkc ||
+		IMDFunction::EfsVolatile ==
+			pexprInner->DeriveFunctionProperties()->Efs() ||
+		pexprPred->DeriveHasSubquery())
+	{
+		return false;
+	}
+
+	// collect the inner columns that each outer row determines
+	CColRefSet *pcrsEquated = GPOS_NEW(mp) CColRefSet(mp);
+	CExpressionArray *pdrgpexprConjuncts =
+		CPredicateUtils::PdrgpexprConjuncts(mp, pexprPred);
+	const ULONG ulConjuncts = pdrgpexprConjuncts->Size();
+	for (ULONG ul = 0; ul < ulConjuncts; ul++)
+	{
+		CExpression *pexprConj = (*pdrgpexprConjuncts)[ul];
+		if (!CPredicateUtils::IsEqualityOp(pexprConj))
+		{
+			continue;
+		}
+
+		for (ULONG ulSide = 0; ulSide < 2; ulSide++)
+		{
+			CExpression *pexprIdent = (*pexprConj)[ulSide];
+			CExpression *pexprOther = (*pexprConj)[1 - ulSide];
+			if (COperator::EopScalarIdent != pexprIdent->Pop()->Eopid() ||
+				!pcrsInner->IsDisjoint(pexprOther->DeriveUsedColumns()))
+			{
+				continue;
+			}
+
+			const CColRef *colref =
+				CScalarIdent::PopConvert(pexprIdent->Pop())->Pcr();
+			if (pcrsInner->FMember(colref))
+			{
+				pcrsEquated->Include(colref);
+			}
+		}
+	}
+
+	BOOL fRedundant = pkc->FKey(pcrsEquated, false /*fExactMatch*/);
+	pdrgpexprConjuncts->Release();
+	pcrsEquated->Release();
+
+	return fRedundant;
+}
+
+// Remove left outer joins that neither add nor drop rows of their outer
+// side and whose inner side's columns are not used above the join, e.g.
+// star-join views joining dimension tables on their primary key when the
+// query only references columns of the fact table
+CExpression *
+CExpressionPreprocessor::PexprRemoveRedundantLeftOuterJoins(
+	CMemoryPool *mp, CExpression *pexpr, CColRefSet *pcrsReqd)
+{
+	GPOS_ASSERT(NULL != pexpr);
+
+	if (NULL == pcrsReqd)
+	{
+		pexpr->AddRef();
+		return pexpr;
+	}
+
+	CColRefSet *pcrsReqdNew = GPOS_NEW(mp) CColRefSet(mp);
+	pcrsReqdNew->Include(pcrsReqd);
+
+	CExpression *pexprNew =
+		PexprRemoveRedundantLeftOuterJoinsRecursive(mp, pexpr, pcrsReqdNew);
+	pcrsReqdNew->Release();
+
+	return pexprNew;
+}
+
+// Workhorse for removing redundant left outer joins; the given set collects
+// the columns used by the operators visited so far
+CExpression *
+CExpressionPreprocessor::PexprRemoveRedundantLeftOuterJoinsRecursive(
+	CMemoryPool *mp, CExpression *pexpr, CColRefSet *pcrsReqd)
+{
+	// protect against stack overflow during recursion
+	GPOS_CHECK_STACK_SIZE;
+	GPOS_ASSERT(NULL != pexpr);
+
+	COperator *pop = pexpr->Pop();
+
+	// leave scalar expressions, including subqueries, alone
+	if (!pop->FLogical())
+	{
+		pexpr->AddRef();
+		return pexpr;
+	}
+
+	if (COperator::EopLogicalLeftOuterJoin == pop->Eopid() &&
+		FRedundantLeftOuterJoin(mp, pexpr, pcrsReqd))
+	{
+		return PexprRemoveRedundantLeftOuterJoinsRecursive(mp, (*pexpr)[0],
+														   pcrsReqd);
+	}
+
+	// collect the columns used by the operator itself and its scalar children
+	CExpressionHandle exprhdl(mp);
+	exprhdl.Attach(pexpr);
+	CColRefSet *pcrsLogicalUsed = exprhdl.PcrsUsedColumns(mp);
+	pcrsReqd->Include(pcrsLogicalUsed);
+	pcrsLogicalUsed->Release();
+
+	// a child may reference columns of its siblings, e.g. the correlated
+	// inner side of an apply
+	const ULONG arity = pexpr->Arity();
+	for (ULONG ul = 0; ul < arity; ul++)
+	{
+		if ((*pexpr)[ul]->Pop()->FLogical())
+		{
+			pcrsReqd->Include((*pexpr)[ul]->DeriveOuterReferences());
+		}
+	}
+
+	// process children
+	CExpressionArray *pdrgpexpr = GPOS_NEW(mp) CExpressionArray(mp);
+	for (ULONG ul = 0; ul < arity; ul++)
+	{
+		pdrgpexpr->Append(PexprRemoveRedundantLeftOuterJoinsRecursive(
+			mp, (*pexpr)[ul], pcrsReqd));
+	}
+
+	pop->AddRef();
+
+	return GPOS_NEW(mp) CExpression(mp, pop, pdrgpexpr);
+}
+
 // main driver, pre-processing of input logical expression
 CExpression *
 CExpressionPreprocessor::PexprPreprocess(
@@ -3226,10 +3373,20 @@ CExpressionPreprocessor::PexprPreprocess(
 	GPOS_CHECK_ABORT;
 	pexprNormalized1->Release();
 
+	// remove outer joins to tables none of whose columns are used
+	CExpression *pexprLOJRemoved = pexprLOJToIJ;
+	if (GPOS_FTRACE(EopttraceEnableOuterJoinElimination))
+	{
+		pexprLOJRemoved = PexprRemoveRedundantLeftOuterJoins(
+			mp, pexprLOJToIJ, pcrsOutputAndOrderCols);
+		GPOS_CHECK_ABORT;
+		pexprLOJToIJ->Release();
+	}
+
 	// collapse cascaded inner and left outer joins
-	CExpression *pexprCollapsed = PexprCollapseJoins(mp, pexprLOJToIJ);
+	CExpression *pexprCollapsed = PexprCollapseJoins(mp, pexprLOJRemoved);
 	GPOS_CHECK_ABORT;
-	pexprLOJToIJ->Release();
+	pexprLOJRemoved->Release();
 
 	// after transforming outer joins to inner joins, we may be able to generate more predicates from constraints
 	CExpression *pexprWithPreds =
@@ -80,6 +80,7 @@ CLogicalFullOuterJoin::PxfsCandidates(CMemoryPool *mp) const
 	CXformSet *xform_set = GPOS_NEW(mp) CXformSet(mp);
 	(void) xform_set->ExchangeSet(CXform::ExfExpandFullOuterJoin);
 	(void) xform_set->ExchangeSet(CXform::ExfImplementFullOuterMergeJoin);
+	(void) xform_set->ExchangeSet(CXform::ExfFullOuterJoin2HashJoin);
 	return xform_set;
 }
 
@@ -18,8 +18,18 @@
 #include "gpopt/base/CDistributionSpecHashed.h"
 #include "gpopt/base/CDistributionSpecSingleton.h"
 #include "gpopt/base/CKeyCollection.h"
+#include "gpopt/base/COptCtxt.h"
+#include "gpopt/base/CUtils.h"
 #include "gpopt/operators/CExpression.h"
 #include "gpopt/operators/CExpressionHandle.h"
+#include "gpopt/operators/CScalarProjectElement.h"
+#include "gpopt/operators/CScalarWindowFunc.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
+#include "naucrates/base/IDatumInt8.h"
+#include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/md/IMDTypeInt8.h"
+#include "naucrates/statistics/CStatistics.h"
+#include "naucrates/statistics/CStatisticsUtils.h"
 
 using namespace gpopt;
 
@@ -34,11 +44,13 @@ using namespace gpopt;
 CLogicalSequenceProject::CLogicalSequenceProject(CMemoryPool *mp,
 												 CDistributionSpec *pds,
 												 COrderSpecArray *pdrgpos,
-												 CWindowFrameArray *pdrgpwf)
+												 CWindowFrameArray *pdrgpwf,
+												 COperator::ESPType esptype)
 	: CLogicalUnary(mp),
 	  m_pds(pds),
 	  m_pdrgpos(pdrgpos),
 	  m_pdrgpwf(pdrgpwf),
+	  m_esptype(esptype),
 	  m_fHasOrderSpecs(false),
 	  m_fHasFrameSpecs(false)
 {
@@ -89,6 +101,7 @@ CLogicalSequenceProject::CLogicalSequenceProject(CMemoryPool *mp)
 	  m_pds(NULL),
 	  m_pdrgpos(NULL),
 	  m_pdrgpwf(NULL),
+	  m_esptype(COperator::EsptypeGlobal),
 	  m_fHasOrderSpecs(false),
 	  m_fHasFrameSpecs(false)
 {
@@ -146,7 +159,8 @@ CLogicalSequenceProject::PopCopyWithRemappedColumns(
 		pdrgpwf->Append(pwf);
 	}
 
-	return GPOS_NEW(mp) CLogicalSequenceProject(mp, pds, pdrgpos, pdrgpwf);
+	return GPOS_NEW(mp)
+		CLogicalSequenceProject(mp, pds, pdrgpos, pdrgpwf, m_esptype);
 }
 
 
@@ -317,7 +331,8 @@ CLogicalSequenceProject::Matches(COperator *pop) const
 	{
 		CLogicalSequenceProject *popLogicalSequenceProject =
 			CLogicalSequenceProject::PopConvert(pop);
-		return m_pds->Matches(popLogicalSequenceProject->Pds()) &&
+		return m_esptype == popLogicalSequenceProject->Esptype() &&
+			   m_pds->Matches(popLogicalSequenceProject->Pds()) &&
 			   CWindowFrame::Equals(m_pdrgpwf,
 									popLogicalSequenceProject->Pdrgpwf()) &&
 			   COrderSpec::Equals(m_pdrgpos,
@@ -340,6 +355,7 @@ ULONG
 CLogicalSequenceProject::HashValue() const
 {
 	ULONG ulHash = 0;
+	ulHash = gpos::CombineHashes(ulHash, m_esptype);
 	ulHash = gpos::CombineHashes(ulHash, m_pds->HashValue());
 	ulHash = gpos::CombineHashes(
 		ulHash, CWindowFrame::HashValue(m_pdrgpwf, 3 /*ulMaxSize*/));
@@ -383,7 +399,120 @@ CLogicalSequenceProject::PstatsDerive(CMemoryPool *mp,
 									  IStatisticsArray *  // stats_ctxt
 ) const
 {
-	return PstatsDeriveProject(mp, exprhdl);
+	IStatistics *stats = PstatsDeriveProject(mp, exprhdl);
+	if (COperator::EsptypeLocal != m_esptype)
+	{
+		return stats;
+	}
+
+	return PstatsBoundLocalRanks(mp, exprhdl, stats);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CLogicalSequenceProject::PstatsBoundLocalRanks
+//
+//	@doc:
+//		A local sequence project ranks the rows of each partition on each
+//		segment separately, so its row_number() and rank() values range
+//		from 1 to the number of rows of a partition on one segment. Give
+//		these columns a histogram over that range, so that a top-N filter
+//		above the local stage is estimated to keep about N rows of each
+//		partition on each segment, rather than a fixed fraction of its
+//		input; takes ownership of the given stats
+//
+//---------------------------------------------------------------------------
+IStatistics *
+CLogicalSequenceProject::PstatsBoundLocalRanks(CMemoryPool *mp,
+											   CExpressionHandle &exprhdl,
+											   IStatistics *stats) const
+{
+	CStatistics *pstats = dynamic_cast<CStatistics *>(stats);
+	GPOS_ASSERT(NULL != pstats);
+
+	COptCtxt *poctxt = COptCtxt::PoctxtFromTLS();
+	COptimizerConfig *optimizer_config = poctxt->GetOptimizerConfig();
+	CWindowOids *window_oids = optimizer_config->GetWindowOids();
+
+	// estimate the number of partitions from the partition by keys
+	IStatistics *child_stats = exprhdl.Pstats(0);
+	CDouble dPartitions(1.0);
+	if (CDistributionSpec::EdtHashed == m_pds->Edt())
+	{
+		CColRefSet *pcrsKeys = CUtils::PcrsExtractColumns(
+			mp, CDistributionSpecHashed::PdsConvert(m_pds)->Pdrgpexpr());
+		ULongPtrArray *pdrgpulKeys = GPOS_NEW(mp) ULongPtrArray(mp);
+		pcrsKeys->ExtractColIds(mp, pdrgpulKeys);
+		dPartitions = CStatisticsUtils::Groups(
+			mp, child_stats, optimizer_config->GetStatsConf(), pdrgpulKeys,
+			NULL /*keys*/);
+		pdrgpulKeys->Release();
+		pcrsKeys->Release();
+	}
+
+	const ULONG ulHosts = poctxt->GetCostModel()->UlHosts();
+	CDouble dMaxRank = std::max(
+		1.0, (child_stats->Rows() / (dPartitions * CDouble(ulHosts))).Get());
+
+	CMDAccessor *md_accessor = poctxt->Pmda();
+	const IMDTypeInt8 *pmdtypeint8 = md_accessor->PtMDType<IMDTypeInt8>();
+
+	UlongToHistogramMap *col_histogram_mapping = pstats->CopyHistograms(mp);
+	CExpression *pexprPrList = exprhdl.PexprScalarRepChild(1 /*child_index*/);
+	const ULONG arity = pexprPrList->Arity();
+	for (ULONG ul = 0; ul < arity; ul++)
+	{
+		CExpression *pexprPrElem = (*pexprPrList)[ul];
+		CExpression *pexprFunc = (*pexprPrElem)[0];
+		if (COperator::EopScalarWindowFunc != pexprFunc->Pop()->Eopid())
+		{
+			continue;
+		}
+
+		OID oid = CMDIdGPDB::CastMdid(
+					  CScalarWindowFunc::PopConvert(pexprFunc->Pop())
+						  ->FuncMdId())
+					  ->Oid();
+		ULONG colid =
+			CScalarProjectElement::PopConvert(pexprPrElem->Pop())->Pcr()->Id();
+		if ((oid != window_oids->OidRowNumber() &&
+			 oid != window_oids->OidRank()) ||
+			NULL == col_histogram_mapping->Find(&colid))
+		{
+			continue;
+		}
+
+		CPoint *ppointLower = GPOS_NEW(mp)
+			CPoint(pmdtypeint8->CreateInt8Datum(mp, 1, false /*is_null*/));
+		CPoint *ppointUpper = GPOS_NEW(mp) CPoint(pmdtypeint8->CreateInt8Datum(
+			mp, (LINT) dMaxRank.Get(), false /*is_null*/));
+		CBucketArray *pdrgpbucket = GPOS_NEW(mp) CBucketArray(mp);
+		pdrgpbucket->Append(GPOS_NEW(mp) CBucket(
+			ppointLower, ppointUpper, true /*is_lower_closed*/,
+			true /*is_upper_closed*/, CDouble(1.0), dMaxRank));
+
+#ifdef GPOS_DEBUG
+		BOOL fReplaced =
+#endif
+			col_histogram_mapping->Replace(
+				&colid, GPOS_NEW(mp) CHistogram(mp, pdrgpbucket));
+		GPOS_ASSERT(fReplaced);
+	}
+
+	CStatistics *pstatsBounded = GPOS_NEW(mp) CStatistics(
+		mp, col_histogram_mapping, pstats->CopyWidths(mp), pstats->Rows(),
+		pstats->IsEmpty(), pstats->GetNumberOfPredicates());
+
+	CUpperBoundNDVPtrArray *pdrgpubndv = pstats->GetUpperBoundNDVs();
+	const ULONG ulUpperBounds = pdrgpubndv->Size();
+	for (ULONG ul = 0; ul < ulUpperBounds; ul++)
+	{
+		pstatsBounded->AddCardUpperBound(
+			(*pdrgpubndv)[ul]->CopyUpperBoundNDVs(mp));
+	}
+	stats->Release();
+
+	return pstatsBounded;
 }
 
 //---------------------------------------------------------------------------
@@ -398,6 +527,10 @@ IOstream &
 CLogicalSequenceProject::OsPrint(IOstream &os) const
 {
 	os << SzId() << " (";
+	if (COperator::EsptypeLocal == m_esptype)
+	{
+		os << "Local, ";
+	}
 	os << "Partition By Keys:";
 	(void) m_pds->OsPrint(os);
 	os << ", ";
@@ -452,7 +585,8 @@ CLogicalSequenceProject::PopRemoveLocalOuterRefs(CMemoryPool *mp,
 	// we re-use the frame edges without changing here
 	m_pdrgpwf->AddRef();
 
-	return GPOS_NEW(mp) CLogicalSequenceProject(mp, pds, pdrgpos, m_pdrgpwf);
+	return GPOS_NEW(mp)
+		CLogicalSequenceProject(mp, pds, pdrgpos, m_pdrgpwf, m_esptype);
 }
 
 // EOF
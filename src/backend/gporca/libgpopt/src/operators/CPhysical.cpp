@@ -1198,6 +1198,59 @@ CPhysical::GetSkew(IStatistics *stats, CDistributionSpec *pds)
 	return CDouble(dSkew);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CPhysical::GetMaxKeyFreq
+//
+//	@doc:
+//		Helper to estimate the fraction of rows that share the most common
+//		value of the hashed distribution key. All such rows are sent to the
+//		same segment. For a single-column key this is the frequency of the
+//		column's most common value. For a multi-column key the most common
+//		combination cannot be more frequent than the most common value of any
+//		of its columns, so the minimum over the columns is used; it is an
+//		upper bound on the true frequency and may overstate the skew.
+//		Returns zero if nothing can be said about the key
+//
+//---------------------------------------------------------------------------
+CDouble
+CPhysical::GetMaxKeyFreq(IStatistics *stats, CDistributionSpec *pds)
+{
+	if (CDistributionSpec::EdtHashed != pds->Edt())
+	{
+		return CDouble(0.0);
+	}
+
+	CDistributionSpecHashed *pdshashed =
+		CDistributionSpecHashed::PdsConvert(pds);
+	const CExpressionArray *pdrgpexpr = pdshashed->Pdrgpexpr();
+	const ULONG size = pdrgpexpr->Size();
+	CDouble dFreq = 1.0;
+	BOOL fFound = false;
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		CExpression *pexpr = (*pdrgpexpr)[ul];
+		if (COperator::EopScalarIdent == pexpr->Pop()->Eopid())
+		{
+			// consider only hashed distribution direct columns for now
+			CScalarIdent *popScId = CScalarIdent::PopConvert(pexpr->Pop());
+			CDouble dFreqCol = stats->GetMaxValueFreq(popScId->Pcr()->Id());
+			if (dFreqCol < dFreq)
+			{
+				dFreq = dFreqCol;
+			}
+			fFound = true;
+		}
+	}
+
+	if (!fFound)
+	{
+		return CDouble(0.0);
+	}
+
+	return dFreq;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CPhysical::FChildrenHaveCompatibleDistributions
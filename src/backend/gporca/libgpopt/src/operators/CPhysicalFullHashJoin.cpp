@@ -0,0 +1,189 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CPhysicalFullHashJoin.cpp
+//
+//	@doc:
+//		Implementation of full outer hash join operator
+//---------------------------------------------------------------------------
+
+#include "gpopt/operators/CPhysicalFullHashJoin.h"
+
+#include "gpos/base.h"
+
+#include "gpopt/base/CDistributionSpecHashed.h"
+#include "gpopt/operators/CExpressionHandle.h"
+
+using namespace gpopt;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPhysicalFullHashJoin::CPhysicalFullHashJoin
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CPhysicalFullHashJoin::CPhysicalFullHashJoin(
+	CMemoryPool *mp, CExpressionArray *pdrgpexprOuterKeys,
+	CExpressionArray *pdrgpexprInnerKeys, IMdIdArray *hash_opfamilies,
+	BOOL is_null_aware, CXform::EXformId origin_xform)
+	: CPhysicalHashJoin(mp, pdrgpexprOuterKeys, pdrgpexprInnerKeys,
+						hash_opfamilies, is_null_aware, origin_xform)
+{
+	// the base class ctor has created the hash redistribute requests; Full
+	// Hash Join creates the following optimization requests to enforce
+	// distribution of its children:
+	// Req(1 to N) (redistribute, redistribute), where we request the first
+	//		hash join child to be distributed on single hash join keys
+	//		separately, as well as the set of all hash join keys, the second
+	//		hash join child is always required to match the distribution
+	//		returned by first child
+	// Req(N + 1) (singleton, singleton)
+	ULONG ulDistrReqs = 1 + NumDistrReq();
+	SetDistrRequests(ulDistrReqs);
+
+	// both sides are preserved, so the join predicate cannot be used
+	// for partition elimination on either of them
+	SetPartPropagateRequests(1);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPhysicalFullHashJoin::~CPhysicalFullHashJoin
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CPhysicalFullHashJoin::~CPhysicalFullHashJoin()
+{
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPhysicalFullHashJoin::Ped
+//
+//	@doc:
+//		Compute required distribution of the n-th child
+//
+//---------------------------------------------------------------------------
+CEnfdDistribution *
+CPhysicalFullHashJoin::Ped(CMemoryPool *mp, CExpressionHandle &exprhdl,
+						   CReqdPropPlan *prppInput, ULONG child_index,
+						   CDrvdPropArray *pdrgpdpCtxt, ULONG ulOptReq)
+{
+	// create the following requests:
+	// 1) hash-hash (provided by CPhysicalHashJoin::PdsRequiredRedistribute)
+	// 2) singleton-singleton
+	//
+	// Unlike the other hash joins, we never create a replicated request:
+	// every segment would emit the unmatched rows of the replicated side,
+	// producing duplicates.
+	CDistributionSpec *const pdsInput = prppInput->Ped()->PdsRequired();
+	CEnfdDistribution::EDistributionMatching dmatch =
+		Edm(prppInput, child_index, pdrgpdpCtxt, ulOptReq);
+
+	if (exprhdl.NeedsSingletonExecution() || exprhdl.HasOuterRefs())
+	{
+		return GPOS_NEW(mp) CEnfdDistribution(
+			PdsRequireSingleton(mp, exprhdl, pdsInput, child_index), dmatch);
+	}
+
+	const ULONG ulHashDistributeRequests = NumDistrReq();
+	if (ulOptReq < ulHashDistributeRequests)
+	{
+		// requests 1 .. N are (redistribute, redistribute)
+		CDistributionSpec *pds = PdsRequiredRedistribute(
+			mp, exprhdl, pdsInput, child_index, pdrgpdpCtxt, ulOptReq);
+		if (CDistributionSpec::EdtHashed == pds->Edt())
+		{
+			CDistributionSpecHashed *pdsHashed =
+				CDistributionSpecHashed::PdsConvert(pds);
+			pdsHashed->ComputeEquivHashExprs(mp, exprhdl);
+		}
+		return GPOS_NEW(mp) CEnfdDistribution(pds, dmatch);
+	}
+
+	GPOS_ASSERT(ulOptReq == NumDistrReq());
+	return GPOS_NEW(mp) CEnfdDistribution(
+		PdsRequiredSingleton(mp, exprhdl, pdsInput, child_index, pdrgpdpCtxt),
+		dmatch);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPhysicalFullHashJoin::Edm
+//
+//	@doc:
+//		Distribution matching type; a replicated or universal child
+//		satisfies a hashed request, but cannot be full-joined locally,
+//		so always require an exact match
+//
+//---------------------------------------------------------------------------
+CEnfdDistribution::EDistributionMatching
+CPhysicalFullHashJoin::Edm(CReqdPropPlan *,	  // prppInput
+						   ULONG,			  // child_index
+						   CDrvdPropArray *,  // pdrgpdpCtxt
+						   ULONG			  // ulOptReq
+)
+{
+	return CEnfdDistribution::EdmExact;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPhysicalFullHashJoin::PdsDerive
+//
+//	@doc:
+//		Derive distribution
+//
+//---------------------------------------------------------------------------
+CDistributionSpec *
+CPhysicalFullHashJoin::PdsDerive(CMemoryPool *mp,
+								 CExpressionHandle &exprhdl) const
+{
+	CDistributionSpec *pdsOuter = exprhdl.Pdpplan(0 /*child_index*/)->Pds();
+	CDistributionSpec *pdsInner = exprhdl.Pdpplan(1 /*child_index*/)->Pds();
+
+	if (CDistributionSpec::EdtHashed == pdsOuter->Edt() &&
+		CDistributionSpec::EdtHashed == pdsInner->Edt())
+	{
+		CDistributionSpecHashed *pdshashedOuter =
+			CDistributionSpecHashed::PdsConvert(pdsOuter);
+		CDistributionSpecHashed *pdshashedInner =
+			CDistributionSpecHashed::PdsConvert(pdsInner);
+
+		// either side may be null-extended, so nulls are not colocated
+		CDistributionSpecHashed *pdsDeriveOuter =
+			pdshashedOuter->Copy(mp, false /* fNullsCollocated*/);
+
+		// NB: Logic is similar to CPhysicalFullMergeJoin::PdsDerive()
+		if (pdshashedOuter->IsCoveredBy(PdrgpexprOuterKeys()) &&
+			pdshashedInner->IsCoveredBy(PdrgpexprInnerKeys()))
+		{
+			CDistributionSpecHashed *pdsDeriveInner =
+				pdshashedInner->Copy(mp, false /* fNullsCollocated*/);
+			CDistributionSpecHashed *pdsCombined =
+				pdsDeriveOuter->Combine(mp, pdsDeriveInner);
+			pdsDeriveOuter->Release();
+			pdsDeriveInner->Release();
+			return pdsCombined;
+		}
+
+		return pdsDeriveOuter;
+	}
+
+	// ... or both sides to be singleton/universal
+	GPOS_ASSERT(CDistributionSpec::EdtSingleton == pdsOuter->Edt() ||
+				CDistributionSpec::EdtStrictSingleton == pdsOuter->Edt() ||
+				CDistributionSpec::EdtUniversal == pdsOuter->Edt());
+
+	// otherwise, pass through outer distribution
+	pdsOuter->AddRef();
+	return pdsOuter;
+}
+
+// EOF
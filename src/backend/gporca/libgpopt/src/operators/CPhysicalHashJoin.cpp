@@ -378,7 +378,8 @@ CPhysicalHashJoin::PdshashedMatching(
 
 	if (!m_is_null_aware &&
 		(COperator::EopPhysicalLeftOuterHashJoin == Eopid() ||
-		 COperator::EopPhysicalRightOuterHashJoin == Eopid()))
+		 COperator::EopPhysicalRightOuterHashJoin == Eopid() ||
+		 COperator::EopPhysicalFullHashJoin == Eopid()))
 	{
 		fNullsColocated = false;
 	}
@@ -37,11 +37,13 @@ using namespace gpopt;
 CPhysicalSequenceProject::CPhysicalSequenceProject(CMemoryPool *mp,
 												   CDistributionSpec *pds,
 												   COrderSpecArray *pdrgpos,
-												   CWindowFrameArray *pdrgpwf)
+												   CWindowFrameArray *pdrgpwf,
+												   COperator::ESPType esptype)
 	: CPhysical(mp),
 	  m_pds(pds),
 	  m_pdrgpos(pdrgpos),
 	  m_pdrgpwf(pdrgpwf),
+	  m_esptype(esptype),
 	  m_pos(NULL),
 	  m_pcrsRequiredLocal(NULL)
 {
@@ -209,7 +211,8 @@ CPhysicalSequenceProject::Matches(COperator *pop) const
 	{
 		CPhysicalSequenceProject *popPhysicalSequenceProject =
 			CPhysicalSequenceProject::PopConvert(pop);
-		return m_pds->Matches(popPhysicalSequenceProject->Pds()) &&
+		return m_esptype == popPhysicalSequenceProject->Esptype() &&
+			   m_pds->Matches(popPhysicalSequenceProject->Pds()) &&
 			   CWindowFrame::Equals(m_pdrgpwf,
 									popPhysicalSequenceProject->Pdrgpwf()) &&
 			   COrderSpec::Equals(m_pdrgpos,
@@ -232,6 +235,7 @@ ULONG
 CPhysicalSequenceProject::HashValue() const
 {
 	ULONG ulHash = 0;
+	ulHash = gpos::CombineHashes(ulHash, m_esptype);
 	ulHash = gpos::CombineHashes(ulHash, m_pds->HashValue());
 	ulHash = gpos::CombineHashes(
 		ulHash, CWindowFrame::HashValue(m_pdrgpwf, 3 /*ulMaxSize*/));
@@ -341,6 +345,13 @@ CPhysicalSequenceProject::PdsRequired(CMemoryPool *mp,
 			CDistributionSpecReplicated(CDistributionSpec::EdtStrictReplicated);
 	}
 
+	// a local window operator only pre-filters the rows of each segment
+	// for a global one above it, so it runs wherever its input is
+	if (COperator::EsptypeLocal == m_esptype)
+	{
+		return GPOS_NEW(mp) CDistributionSpecAny(this->Eopid());
+	}
+
 	// if the window operator has a partition by clause, then always
 	// request hashed distribution on the partition column
 	if (CDistributionSpec::EdtHashed == m_pds->Edt())
@@ -601,6 +612,10 @@ IOstream &
 CPhysicalSequenceProject::OsPrint(IOstream &os) const
 {
 	os << SzId() << " (";
+	if (COperator::EsptypeLocal == m_esptype)
+	{
+		os << "Local, ";
+	}
 	(void) m_pds->OsPrint(os);
 	os << ", ";
 	(void) COrderSpec::OsPrint(os, m_pdrgpos);
@@ -312,6 +312,10 @@ COptimizer::PdxlnOptimize(
 				COptCtxt::PoctxtFromTLS()->Pcteinfo()->DisableInlining();
 			}
 
+			// the query context holds the preprocessed query from here on,
+			// do not keep the translated tree alive during search
+			pexprTranslated->Release();
+
 			GPOS_CHECK_ABORT;
 			// optimize logical expression tree into physical expression tree.
 			CExpression *pexprPlan = PexprOptimize(mp, pqc, search_stage_array);
@@ -322,6 +326,11 @@ COptimizer::PdxlnOptimize(
 									  pqc->PdrgPcr(), pdrgpmdname, ulHosts);
 			GPOS_CHECK_ABORT;
 
+			// the physical expression tree is not needed once it has been
+			// translated, release it before serializing the plan
+			pexprPlan->Release();
+			GPOS_DELETE(pqc);
+
 			if (fMinidump)
 			{
 				CSerializablePlan serPlan(
@@ -338,11 +347,6 @@ COptimizer::PdxlnOptimize(
 							ulSessionId, ulCmdId);
 				GPOS_CHECK_ABORT;
 			}
-
-			// cleanup
-			pexprTranslated->Release();
-			pexprPlan->Release();
-			GPOS_DELETE(pqc);
 		}
 	}
 	GPOS_CATCH_EX(ex)
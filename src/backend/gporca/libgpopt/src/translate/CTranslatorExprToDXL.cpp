@@ -278,6 +278,8 @@ CTranslatorExprToDXL::InitPhysicalTranslators()
 		 &gpopt::CTranslatorExprToDXL::PdxlnHashJoin},
 		{COperator::EopPhysicalRightOuterHashJoin,
 		 &gpopt::CTranslatorExprToDXL::PdxlnHashJoin},
+		{COperator::EopPhysicalFullHashJoin,
+		 &gpopt::CTranslatorExprToDXL::PdxlnHashJoin},
 		{COperator::EopPhysicalMotionGather,
 		 &gpopt::CTranslatorExprToDXL::PdxlnMotion},
 		{COperator::EopPhysicalMotionBroadcast,
@@ -4257,6 +4259,9 @@ CTranslatorExprToDXL::EdxljtHashJoin(CPhysicalHashJoin *popHJ)
 		case COperator::EopPhysicalRightOuterHashJoin:
 			return EdxljtRight;
 
+		case COperator::EopPhysicalFullHashJoin:
+			return EdxljtFull;
+
 		case COperator::EopPhysicalLeftSemiHashJoin:
 			return EdxljtIn;
 
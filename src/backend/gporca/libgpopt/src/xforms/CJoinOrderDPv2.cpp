@@ -70,7 +70,10 @@ CJoinOrderDPv2::CJoinOrderDPv2(CMemoryPool *mp,
 	  m_child_pred_indexes(childPredIndexes),
 	  m_non_inner_join_dependencies(NULL),
 	  m_cross_prod_penalty(GPOPT_DPV2_CROSS_JOIN_DEFAULT_PENALTY),
-	  m_outer_refs(outerRefs)
+	  m_outer_refs(outerRefs),
+	  m_search_strategy(EJoinOrderSearchTopK),
+	  m_skip_cross_products(false),
+	  m_num_join_pairs(0)
 {
 	m_join_levels = GPOS_NEW(mp) DPv2Levels(mp, m_ulComps + 1);
 	// populate levels array with n+1 levels for an n-way join
@@ -330,6 +333,8 @@ CJoinOrderDPv2::GetJoinExpr(const SGroupAndExpression &left_child_expr,
 {
 	SGroupInfo *left_group_info = left_child_expr.m_group_info;
 
+	m_num_join_pairs++;
+
 	if (IsRightChildOfNIJ(left_group_info))
 	{
 		// can't use the right child of an NIJ on the left side
@@ -985,6 +990,13 @@ CJoinOrderDPv2::SearchJoinOrders(ULONG left_level, ULONG right_level)
 				continue;
 			}
 
+			if (m_skip_cross_products &&
+				!AreConnected(left_bitset, right_bitset))
+			{
+				// an unnecessary cross product
+				continue;
+			}
+
 			SExpressionProperties reqd_properties(EJoinOrderDP);
 			SExpressionInfo *join_expr_info = GetJoinExprForProperties(
 				left_group_info, right_group_info, reqd_properties);
@@ -1408,12 +1420,298 @@ CJoinOrderDPv2::PexprExpand()
 		atom_expr_info->Release();
 	}
 
+	ChooseSearchStrategy();
+
 	// call all the enumeration strategies, start with DP, as it builds some needed data structures
 	// for MinCard and GreedyAvoidXProd
 	EnumerateDP();
 	EnumerateQuery();
 	EnumerateMinCard();
 	EnumerateGreedyAvoidXProd();
+
+	// the linearized DP builds on the GreedyAvoidXProd join order
+	EnumerateLinearizedDP();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPv2::AreConnected
+//
+//	@doc:
+//		Is there an edge of the join graph that is covered by the union
+//		of the two given, disjoint sets of atoms and that spans both of them
+//
+//---------------------------------------------------------------------------
+BOOL
+CJoinOrderDPv2::AreConnected(CBitSet *left_atoms, CBitSet *right_atoms) const
+{
+	for (ULONG ul = 0; ul < m_ulEdges; ul++)
+	{
+		CBitSet *edge_atoms = m_rgpedge[ul]->m_pbs;
+
+		if (edge_atoms->IsDisjoint(left_atoms) ||
+			edge_atoms->IsDisjoint(right_atoms))
+		{
+			continue;
+		}
+
+		BOOL is_covered = true;
+		CBitSetIter iter(*edge_atoms);
+		while (is_covered && iter.Advance())
+		{
+			is_covered =
+				left_atoms->Get(iter.Bit()) || right_atoms->Get(iter.Bit());
+		}
+
+		if (is_covered)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPv2::ChooseSearchStrategy
+//
+//	@doc:
+//		With adaptive join ordering, classify the join graph as a chain,
+//		cycle, star, tree or a general cyclic graph and estimate the
+//		number of joins an exhaustive DP enumerates for it, i.e. the number
+//		of pairs of connected sets of atoms that are connected to each
+//		other. The budget for this is what an exhaustive DP of a clique of
+//		<DP threshold> atoms costs. Within that budget we use an
+//		exhaustive DP, otherwise a DP limited to the top groups of each
+//		level if that fits into the budget, otherwise a DP over the
+//		intervals of a linear join order, which is cubic in the number of
+//		atoms.
+//
+//---------------------------------------------------------------------------
+void
+CJoinOrderDPv2::ChooseSearchStrategy()
+{
+	if (!GPOS_FTRACE(EopttraceEnableAdaptiveJoinOrder) ||
+		GPOS_FTRACE(EopttraceGreedyOnlyInDPv2) ||
+		GPOS_FTRACE(EopttraceMinCardOnlyInDPv2) ||
+		GPOS_FTRACE(EopttraceQueryOnlyInDPv2))
+	{
+		return;
+	}
+
+	const ULONG n = m_ulComps;
+	const DOUBLE dn = (DOUBLE) n;
+
+	// compute the degree of each atom in the join graph and check whether
+	// all atoms are reachable from the first one
+	ULONG *degrees = GPOS_NEW_ARRAY(m_mp, ULONG, n);
+	CBitSetArray *neighbors = GPOS_NEW(m_mp) CBitSetArray(m_mp, n);
+	for (ULONG ul = 0; ul < n; ul++)
+	{
+		degrees[ul] = 0;
+		neighbors->Append(GPOS_NEW(m_mp) CBitSet(m_mp));
+	}
+
+	BOOL has_hyper_edges = false;
+	ULONG num_adjacent_pairs = 0;
+	for (ULONG ul = 0; ul < m_ulEdges; ul++)
+	{
+		CBitSet *edge_atoms = m_rgpedge[ul]->m_pbs;
+		if (2 != edge_atoms->Size())
+		{
+			has_hyper_edges = has_hyper_edges || 2 < edge_atoms->Size();
+			continue;
+		}
+
+		CBitSetIter iter(*edge_atoms);
+		(void) iter.Advance();
+		ULONG first = iter.Bit();
+		(void) iter.Advance();
+		ULONG second = iter.Bit();
+
+		if (!(*neighbors)[first]->ExchangeSet(second))
+		{
+			(void) (*neighbors)[second]->ExchangeSet(first);
+			degrees[first]++;
+			degrees[second]++;
+			num_adjacent_pairs++;
+		}
+	}
+
+	CBitSet *reached = GPOS_NEW(m_mp) CBitSet(m_mp);
+	(void) reached->ExchangeSet(0);
+	BOOL reached_more = true;
+	while (reached_more)
+	{
+		ULONG num_reached = reached->Size();
+		for (ULONG ul = 0; ul < m_ulEdges; ul++)
+		{
+			if (!m_rgpedge[ul]->m_pbs->IsDisjoint(reached))
+			{
+				reached->Union(m_rgpedge[ul]->m_pbs);
+			}
+		}
+		reached_more = reached->Size() > num_reached;
+	}
+	BOOL is_connected = reached->Size() == n;
+
+	ULONG max_degree = 0;
+	for (ULONG ul = 0; ul < n; ul++)
+	{
+		max_degree = std::max(max_degree, degrees[ul]);
+	}
+
+	reached->Release();
+	neighbors->Release();
+	GPOS_DELETE_ARRAY(degrees);
+
+	// estimate the number of joins enumerated by an exhaustive DP
+	const CHAR *shape = NULL;
+	DOUBLE num_dp_joins = 0.0;
+	if (!is_connected || has_hyper_edges)
+	{
+		// cross products or complex predicates, assume the worst
+		shape = "cyclic";
+	}
+	else if (num_adjacent_pairs == n - 1 && max_degree <= 2)
+	{
+		shape = "chain";
+		num_dp_joins = (dn * dn * dn - dn) / 6;
+	}
+	else if (num_adjacent_pairs == n && max_degree == 2)
+	{
+		shape = "cycle";
+		num_dp_joins = (dn * dn * dn - 2 * dn * dn + dn) / 2;
+	}
+	else if (num_adjacent_pairs == n - 1)
+	{
+		// a star is the most expensive tree
+		shape = max_degree == n - 1 ? "star" : "tree";
+		num_dp_joins = (dn - 1) * CDouble(2.0).Pow(dn - 2).Get();
+	}
+	else
+	{
+		shape = "cyclic";
+	}
+
+	if (0.0 == num_dp_joins)
+	{
+		// a clique is the most expensive graph
+		num_dp_joins = (CDouble(3.0).Pow(dn).Get() -
+						CDouble(2.0).Pow(dn + 1).Get() + 1) /
+					   2;
+	}
+
+	COptimizerConfig *optimizer_config =
+		COptCtxt::PoctxtFromTLS()->GetOptimizerConfig();
+	const ULONG dp_limit = optimizer_config->GetHint()->UlJoinOrderDPLimit();
+	const DOUBLE dl = (DOUBLE) dp_limit;
+	const DOUBLE budget =
+		(CDouble(3.0).Pow(dl).Get() - CDouble(2.0).Pow(dl + 1).Get() + 1) / 2;
+
+	// a DP limited to the top groups of each level joins the groups of
+	// each level with all the atoms
+	DOUBLE num_top_k_joins = 0.0;
+	for (ULONG l = 1; l < n; l++)
+	{
+		num_top_k_joins +=
+			dn * (l < dp_limit ? (DOUBLE) NChooseK(dp_limit, l) : 1.0);
+	}
+
+	const CHAR *strategy = NULL;
+	if (n <= dp_limit || num_dp_joins <= budget)
+	{
+		m_search_strategy = EJoinOrderSearchExhaustive;
+		strategy = "exhaustive DP";
+	}
+	else if (num_top_k_joins <= budget)
+	{
+		m_search_strategy = EJoinOrderSearchTopK;
+		strategy = "top-k DP";
+	}
+	else
+	{
+		m_search_strategy = EJoinOrderSearchLinearized;
+		strategy = "linearized DP";
+	}
+
+	// a DP over a connected join graph never needs a cross product; we
+	// keep them with non-inner joins, whose placement is restricted, and
+	// with hyperedges: AreConnected() only accepts an edge covered by both
+	// sides together, so a graph connected through a hyperedge still needs
+	// cross products to get all of the hyperedge's atoms on one side
+	m_skip_cross_products = is_connected && !has_hyper_edges &&
+							0 == m_on_pred_conjuncts->Size();
+
+	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
+	{
+		CAutoTrace at(m_mp);
+		at.Os() << "Adaptive join order for " << n << " relations, " << shape
+				<< " join graph, " << num_dp_joins
+				<< " estimated DP joins, budget " << budget << ", using "
+				<< strategy;
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPv2::LimitLevelsToGreedy
+//
+//	@doc:
+//		Keep only the best group in each level above the given level, this
+//		turns the remaining DP enumeration into a greedy one
+//
+//---------------------------------------------------------------------------
+void
+CJoinOrderDPv2::LimitLevelsToGreedy(ULONG level)
+{
+	for (ULONG l = level + 1; l <= m_ulComps; l++)
+	{
+		SLevelInfo *level_info = Level(l);
+
+		// these levels have not been built yet, so the heaps are empty
+		GPOS_ASSERT(0 == level_info->m_groups->Size());
+		CRefCount::SafeRelease(level_info->m_top_k_groups);
+		level_info->m_top_k_groups =
+			GPOS_NEW(m_mp) CKHeap<SGroupInfoArray, SGroupInfo>(m_mp, 1);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPv2::GetIntervalGroup
+//
+//	@doc:
+//		Return the group of the atoms atom_order[start] ... atom_order[end-1]
+//		or NULL, if no such group exists
+//
+//---------------------------------------------------------------------------
+CJoinOrderDPv2::SGroupInfo *
+CJoinOrderDPv2::GetIntervalGroup(const ULONG *atom_order, ULONG start,
+								 ULONG end)
+{
+	GPOS_ASSERT(start < end && end <= m_ulComps);
+
+	if (1 == end - start)
+	{
+		// atoms are stored at their index in level 1
+		return (*GetGroupsForLevel(1))[atom_order[start]];
+	}
+
+	CBitSet *atoms = GPOS_NEW(m_mp) CBitSet(m_mp);
+	for (ULONG ul = start; ul < end; ul++)
+	{
+		(void) atoms->ExchangeSet(atom_order[ul]);
+	}
+	SGroupInfo *group_info = m_bitset_to_group_info_map->Find(atoms);
+	atoms->Release();
+
+	return group_info;
 }
 
 
@@ -1445,9 +1743,29 @@ CJoinOrderDPv2::EnumerateDP()
 	const CHint *phint = optimizer_config->GetHint();
 	ULONG join_order_exhaustive_limit = phint->UlJoinOrderDPLimit();
 
+	if (EJoinOrderSearchLinearized == m_search_strategy)
+	{
+		// build only the 2-way joins, needed for the greedy join order that
+		// EnumerateLinearizedDP() then improves
+		SearchJoinOrders(1, 1);
+		FinalizeDPLevel(2);
+		return;
+	}
+
+	// with adaptive join ordering, the DP may build a limited number of
+	// join pairs; counting them rather than timing the search keeps the
+	// chosen join order independent of the load on the host
+	ULLONG join_pair_budget = 0;
+	if (GPOS_FTRACE(EopttraceEnableAdaptiveJoinOrder))
+	{
+		join_pair_budget = phint->UlJoinOrderBudget();
+	}
+	const ULLONG start_join_pairs = m_num_join_pairs;
+
 	// for larger joins, compute the limit for the number of groups at each level, this
 	// follows the number of groups for the largest join for which we do exhaustive search
-	if (join_order_exhaustive_limit < m_ulComps)
+	if (join_order_exhaustive_limit < m_ulComps &&
+		EJoinOrderSearchExhaustive != m_search_strategy)
 	{
 		for (ULONG l = 2; l <= m_ulComps; l++)
 		{
@@ -1488,6 +1806,23 @@ CJoinOrderDPv2::EnumerateDP()
 
 		// finalize level, enforce limit for groups
 		FinalizeDPLevel(current_join_level);
+
+		if (0 < join_pair_budget && current_join_level < m_ulComps &&
+			m_num_join_pairs - start_join_pairs > join_pair_budget)
+		{
+			// over budget, complete the remaining levels greedily
+			LimitLevelsToGreedy(current_join_level);
+			join_pair_budget = 0;
+
+			if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
+			{
+				CAutoTrace at(m_mp);
+				at.Os() << "Join order budget exceeded after "
+						<< m_num_join_pairs - start_join_pairs
+						<< " join pairs, using greedy enumeration above level "
+						<< current_join_level;
+			}
+		}
 	}
 }
 
@@ -1642,6 +1977,125 @@ CJoinOrderDPv2::EnumerateGreedyAvoidXProd()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPv2::AddAtomsInJoinOrder
+//
+//	@doc:
+//		Append the atoms of a join tree to the given array, from left to
+//		right
+//
+//---------------------------------------------------------------------------
+void
+CJoinOrderDPv2::AddAtomsInJoinOrder(const SGroupAndExpression &group_and_expr,
+									ULONG *atom_order, ULONG *num_atoms)
+{
+	SGroupInfo *group_info = group_and_expr.m_group_info;
+
+	if (group_info->IsAnAtom())
+	{
+		CBitSetIter iter(*group_info->m_atoms);
+		(void) iter.Advance();
+		atom_order[(*num_atoms)++] = iter.Bit();
+		return;
+	}
+
+	SExpressionInfo *expr_info = group_and_expr.GetExprInfo();
+	AddAtomsInJoinOrder(expr_info->m_left_child_expr, atom_order, num_atoms);
+	AddAtomsInJoinOrder(expr_info->m_right_child_expr, atom_order, num_atoms);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderDPv2::EnumerateLinearizedDP
+//
+//	@doc:
+//		For joins too large for the other DP enumerations, take the atoms
+//		in the order of the GreedyAvoidXProd solution and find the best
+//		bushy join tree that keeps this order, i.e. joins only adjacent
+//		intervals of atoms. This is O(n^3) in the number of atoms.
+//
+//---------------------------------------------------------------------------
+void
+CJoinOrderDPv2::EnumerateLinearizedDP()
+{
+	if (EJoinOrderSearchLinearized != m_search_strategy)
+	{
+		return;
+	}
+
+	SGroupInfoArray *top_groups = GetGroupsForLevel(m_ulComps);
+	if (0 == top_groups->Size())
+	{
+		return;
+	}
+
+	SExpressionProperties greedy_props(EJoinOrderGreedyAvoidXProd);
+	SGroupAndExpression greedy_expr =
+		GetBestExprForProperties((*top_groups)[0], greedy_props);
+	if (!greedy_expr.IsValid())
+	{
+		return;
+	}
+
+	ULONG *atom_order = GPOS_NEW_ARRAY(m_mp, ULONG, m_ulComps);
+	ULONG num_atoms = 0;
+	AddAtomsInJoinOrder(greedy_expr, atom_order, &num_atoms);
+	GPOS_ASSERT(m_ulComps == num_atoms);
+
+	SExpressionProperties any_props(EJoinOrderAny);
+
+	// the 2-way joins already exist, build the longer intervals bottom-up
+	for (ULONG length = 3; length <= m_ulComps; length++)
+	{
+		for (ULONG start = 0; start + length <= m_ulComps; start++)
+		{
+			ULONG end = start + length;
+
+			for (ULONG split = start + 1; split < end; split++)
+			{
+				SGroupInfo *left_group_info =
+					GetIntervalGroup(atom_order, start, split);
+				SGroupInfo *right_group_info =
+					GetIntervalGroup(atom_order, split, end);
+
+				if (NULL == left_group_info || NULL == right_group_info ||
+					(m_skip_cross_products &&
+					 !AreConnected(left_group_info->m_atoms,
+								   right_group_info->m_atoms)))
+				{
+					continue;
+				}
+
+				SExpressionInfo *join_expr_info = GetJoinExprForProperties(
+					left_group_info, right_group_info, any_props);
+				if (NULL == join_expr_info)
+				{
+					// try the other join direction, e.g. for an LOJ
+					join_expr_info = GetJoinExprForProperties(
+						right_group_info, left_group_info, any_props);
+				}
+
+				if (NULL != join_expr_info)
+				{
+					CBitSet *join_bitset =
+						GPOS_NEW(m_mp) CBitSet(m_mp, *left_group_info->m_atoms);
+
+					join_bitset->Union(right_group_info->m_atoms);
+
+					SGroupInfo *group_info = LookupOrCreateGroupInfo(
+						Level(length), join_bitset, join_expr_info);
+					AddExprToGroupIfNecessary(group_info, join_expr_info);
+				}
+			}
+		}
+	}
+
+	GPOS_DELETE_ARRAY(atom_order);
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CJoinOrderDPv2::GetNextOfTopK
@@ -217,6 +217,8 @@ CXform::PbsHashJoinXforms(CMemoryPool *mp)
 		GPOPT_DISABLE_XFORM_TF(CXform::ExfLeftAntiSemiJoinNotIn2HashJoinNotIn));
 	(void) pbs->ExchangeSet(
 		GPOPT_DISABLE_XFORM_TF(CXform::ExfRightOuterJoin2HashJoin));
+	(void) pbs->ExchangeSet(
+		GPOPT_DISABLE_XFORM_TF(CXform::ExfFullOuterJoin2HashJoin));
 	(void) pbs->ExchangeSet(GPOPT_DISABLE_XFORM_TF(
 		CXform::
 			ExfLeftJoin2RightJoin));  // Right joins are only used with hash joins, so disable this too
@@ -291,6 +293,16 @@ CXform::PbsJoinOrderOnExhaustive2Xforms(CMemoryPool *mp)
 	return pbs;
 }
 
+CBitSet *
+CXform::PbsJoinOrderOnAdaptiveXforms(CMemoryPool *mp)
+{
+	// same xforms as exhaustive2, DPv2 picks its enumeration per join
+	CBitSet *pbs = PbsJoinOrderOnExhaustive2Xforms(mp);
+	(void) pbs->ExchangeSet(EopttraceEnableAdaptiveJoinOrder);
+
+	return pbs;
+}
+
 BOOL
 CXform::IsApplyOnce()
 {
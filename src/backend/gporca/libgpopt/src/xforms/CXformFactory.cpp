@@ -296,6 +296,9 @@ CXformFactory::Instantiate()
 	Add(GPOS_NEW(m_mp) CXformLeftJoin2RightJoin(m_mp));
 	Add(GPOS_NEW(m_mp) CXformRightOuterJoin2HashJoin(m_mp));
 	Add(GPOS_NEW(m_mp) CXformImplementInnerJoin(m_mp));
+	Add(GPOS_NEW(m_mp) CXformFullOuterJoin2HashJoin(m_mp));
+	Add(GPOS_NEW(m_mp) CXformInnerJoinSemiJoinReduction(m_mp));
+	Add(GPOS_NEW(m_mp) CXformSplitWindowTopN(m_mp));
 
 	GPOS_ASSERT(NULL != m_rgpxf[CXform::ExfSentinel - 1] &&
 				"Not all xforms have been instantiated");
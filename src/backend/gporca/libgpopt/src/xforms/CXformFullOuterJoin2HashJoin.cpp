@@ -0,0 +1,85 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CXformFullOuterJoin2HashJoin.cpp
+//
+//	@doc:
+//		Implementation of transform
+//---------------------------------------------------------------------------
+
+#include "gpopt/xforms/CXformFullOuterJoin2HashJoin.h"
+
+#include "gpos/base.h"
+
+#include "gpopt/operators/CLogicalFullOuterJoin.h"
+#include "gpopt/operators/CPatternLeaf.h"
+#include "gpopt/operators/CPhysicalFullHashJoin.h"
+#include "gpopt/xforms/CXformUtils.h"
+
+
+using namespace gpopt;
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformFullOuterJoin2HashJoin::CXformFullOuterJoin2HashJoin
+//
+//	@doc:
+//		ctor
+//
+//---------------------------------------------------------------------------
+CXformFullOuterJoin2HashJoin::CXformFullOuterJoin2HashJoin(CMemoryPool *mp)
+	:  // pattern
+	  CXformImplementation(GPOS_NEW(mp) CExpression(
+		  mp, GPOS_NEW(mp) CLogicalFullOuterJoin(mp),
+		  GPOS_NEW(mp)
+			  CExpression(mp, GPOS_NEW(mp) CPatternLeaf(mp)),  // left child
+		  GPOS_NEW(mp)
+			  CExpression(mp, GPOS_NEW(mp) CPatternLeaf(mp)),  // right child
+		  GPOS_NEW(mp)
+			  CExpression(mp, GPOS_NEW(mp) CPatternTree(mp))  // predicate
+		  ))
+{
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformFullOuterJoin2HashJoin::Exfp
+//
+//	@doc:
+//		Compute xform promise for a given expression handle;
+//
+//---------------------------------------------------------------------------
+CXform::EXformPromise
+CXformFullOuterJoin2HashJoin::Exfp(CExpressionHandle &exprhdl) const
+{
+	return CXformUtils::ExfpLogicalJoin2PhysicalJoin(exprhdl);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformFullOuterJoin2HashJoin::Transform
+//
+//	@doc:
+//		actual transformation
+//
+//---------------------------------------------------------------------------
+void
+CXformFullOuterJoin2HashJoin::Transform(CXformContext *pxfctxt,
+										CXformResult *pxfres,
+										CExpression *pexpr) const
+{
+	GPOS_ASSERT(NULL != pxfctxt);
+	GPOS_ASSERT(FPromising(pxfctxt->Pmp(), this, pexpr));
+	GPOS_ASSERT(FCheckPattern(pexpr));
+
+	CXformUtils::ImplementHashJoin<CPhysicalFullHashJoin>(pxfctxt, pxfres,
+														  pexpr);
+}
+
+
+// EOF
@@ -0,0 +1,297 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CXformInnerJoinSemiJoinReduction.cpp
+//
+//	@doc:
+//		Implementation of semi join reduction of inner joins
+//---------------------------------------------------------------------------
+
+#include "gpopt/xforms/CXformInnerJoinSemiJoinReduction.h"
+
+#include "gpos/base.h"
+#include "gpos/memory/CAutoMemoryPool.h"
+
+#include "gpopt/base/CUtils.h"
+#include "gpopt/operators/CLogicalCTEAnchor.h"
+#include "gpopt/operators/CLogicalGbAgg.h"
+#include "gpopt/operators/CLogicalInnerJoin.h"
+#include "gpopt/operators/CLogicalLeftSemiJoin.h"
+#include "gpopt/operators/CPatternTree.h"
+#include "gpopt/operators/CPredicateUtils.h"
+#include "gpopt/operators/CScalarIdent.h"
+#include "gpopt/operators/CScalarProjectList.h"
+#include "gpopt/search/CGroupProxy.h"
+#include "gpopt/xforms/CXformUtils.h"
+
+using namespace gpopt;
+
+// the larger side must be at least this many times larger than the smaller side
+const DOUBLE CXformInnerJoinSemiJoinReduction::m_dLargeSmallRatioThreshold =
+	10.0;
+
+// the join must keep at most this fraction of the rows of the larger side
+const DOUBLE CXformInnerJoinSemiJoinReduction::m_dReductionThreshold = 0.5;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformInnerJoinSemiJoinReduction::CXformInnerJoinSemiJoinReduction
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CXformInnerJoinSemiJoinReduction::CXformInnerJoinSemiJoinReduction(
+	CMemoryPool *mp)
+	: CXformExploration(
+		  // pattern
+		  GPOS_NEW(mp) CExpression(
+			  mp, GPOS_NEW(mp) CLogicalInnerJoin(mp),
+			  GPOS_NEW(mp) CExpression(
+				  mp, GPOS_NEW(mp) CPatternTree(mp)),  // left child
+			  GPOS_NEW(mp) CExpression(
+				  mp, GPOS_NEW(mp) CPatternTree(mp)),  // right child
+			  GPOS_NEW(mp) CExpression(
+				  mp, GPOS_NEW(mp) CPatternTree(mp))  // predicate
+			  ))
+{
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformInnerJoinSemiJoinReduction::Exfp
+//
+//	@doc:
+//		Compute xform promise for a given expression handle
+//
+//---------------------------------------------------------------------------
+CXform::EXformPromise
+CXformInnerJoinSemiJoinReduction::Exfp(CExpressionHandle &exprhdl) const
+{
+	// the smaller side is turned into a CTE, which cannot have outer
+	// references; subqueries are unnested by other xforms first
+	if (exprhdl.HasOuterRefs() || exprhdl.DeriveHasSubquery(2))
+	{
+		return CXform::ExfpNone;
+	}
+
+	if (NULL == exprhdl.Pgexpr())
+	{
+		return CXform::ExfpHigh;
+	}
+
+	// check if stats are derivable on child groups
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+	const ULONG arity = exprhdl.Arity();
+	for (ULONG ul = 0; ul < arity; ul++)
+	{
+		CGroup *pgroupChild = (*exprhdl.Pgexpr())[ul];
+		if (!pgroupChild->FScalar() && !pgroupChild->FStatsDerivable(mp))
+		{
+			// stats must be derivable on every child
+			return CXform::ExfpNone;
+		}
+	}
+
+	return CXform::ExfpHigh;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformInnerJoinSemiJoinReduction::FReducedChild
+//
+//	@doc:
+//		Was the given join child produced by this xform; the group of the
+//		semi join this xform creates always has it as its first group
+//		expression, whereas alternatives found later may bind instead
+//
+//---------------------------------------------------------------------------
+BOOL
+CXformInnerJoinSemiJoinReduction::FReducedChild(CExpression *pexprChild)
+{
+	CGroupExpression *pgexpr = pexprChild->Pgexpr();
+	if (NULL == pgexpr)
+	{
+		return false;
+	}
+
+	CGroupProxy gp(pgexpr->Pgroup());
+	CGroupExpression *pgexprFirst = gp.PgexprFirst();
+
+	return NULL != pgexprFirst &&
+		   CXform::ExfInnerJoinSemiJoinReduction == pgexprFirst->ExfidOrigin();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformInnerJoinSemiJoinReduction::PdrgpexprEquiJoinConjuncts
+//
+//	@doc:
+//		Extract the conjuncts of the join predicate that equate a column of
+//		the larger side to a column of the smaller side
+//
+//---------------------------------------------------------------------------
+CExpressionArray *
+CXformInnerJoinSemiJoinReduction::PdrgpexprEquiJoinConjuncts(
+	CMemoryPool *mp, CExpression *pexprScalar, CColRefSet *pcrsBig,
+	CColRefSet *pcrsSmall)
+{
+	CExpressionArray *pdrgpexprEquiJoin = GPOS_NEW(mp) CExpressionArray(mp);
+
+	CExpressionArray *pdrgpexprConjuncts =
+		CPredicateUtils::PdrgpexprConjuncts(mp, pexprScalar);
+	const ULONG size = pdrgpexprConjuncts->Size();
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		CExpression *pexprConj = (*pdrgpexprConjuncts)[ul];
+		if (!CPredicateUtils::FPlainEquality(pexprConj))
+		{
+			continue;
+		}
+
+		const CColRef *pcrLeft =
+			CScalarIdent::PopConvert((*pexprConj)[0]->Pop())->Pcr();
+		const CColRef *pcrRight =
+			CScalarIdent::PopConvert((*pexprConj)[1]->Pop())->Pcr();
+		if ((pcrsBig->FMember(pcrLeft) && pcrsSmall->FMember(pcrRight)) ||
+			(pcrsSmall->FMember(pcrLeft) && pcrsBig->FMember(pcrRight)))
+		{
+			pexprConj->AddRef();
+			pdrgpexprEquiJoin->Append(pexprConj);
+		}
+	}
+	pdrgpexprConjuncts->Release();
+
+	return pdrgpexprEquiJoin;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformInnerJoinSemiJoinReduction::Transform
+//
+//	@doc:
+//		Actual transformation
+//
+//---------------------------------------------------------------------------
+void
+CXformInnerJoinSemiJoinReduction::Transform(CXformContext *pxfctxt,
+											CXformResult *pxfres,
+											CExpression *pexpr) const
+{
+	GPOS_ASSERT(NULL != pxfctxt);
+	GPOS_ASSERT(FPromising(pxfctxt->Pmp(), this, pexpr));
+	GPOS_ASSERT(FCheckPattern(pexpr));
+
+	CMemoryPool *mp = pxfctxt->Pmp();
+
+	CExpression *pexprOuter = (*pexpr)[0];
+	CExpression *pexprInner = (*pexpr)[1];
+	CExpression *pexprScalar = (*pexpr)[2];
+
+	// do not reduce a join whose side has already been reduced, e.g. after
+	// the join produced by this xform has been commuted
+	if (FReducedChild(pexprOuter) || FReducedChild(pexprInner))
+	{
+		return;
+	}
+
+	const IStatistics *outer_stats = pexprOuter->Pstats();
+	const IStatistics *inner_stats = pexprInner->Pstats();
+	const IStatistics *join_stats = pexpr->Pstats();
+	if (NULL == outer_stats || NULL == inner_stats || NULL == join_stats)
+	{
+		return;
+	}
+
+	// reduce the larger side only if the join discards most of it; if the
+	// semi join cannot filter many rows, shipping the keys is wasted effort
+	const BOOL fReduceOuter = outer_stats->Rows() >= inner_stats->Rows();
+	DOUBLE dRowsBig = fReduceOuter ? outer_stats->Rows().Get()
+								   : inner_stats->Rows().Get();
+	DOUBLE dRowsSmall = fReduceOuter ? inner_stats->Rows().Get()
+									 : outer_stats->Rows().Get();
+	if (dRowsBig < dRowsSmall * m_dLargeSmallRatioThreshold ||
+		join_stats->Rows().Get() > dRowsBig * m_dReductionThreshold)
+	{
+		return;
+	}
+
+	CExpression *pexprBig = fReduceOuter ? pexprOuter : pexprInner;
+	CExpression *pexprSmall = fReduceOuter ? pexprInner : pexprOuter;
+	CColRefSet *pcrsSmall = pexprSmall->DeriveOutputColumns();
+
+	CExpressionArray *pdrgpexprEquiJoin = PdrgpexprEquiJoinConjuncts(
+		mp, pexprScalar, pexprBig->DeriveOutputColumns(), pcrsSmall);
+	if (0 == pdrgpexprEquiJoin->Size())
+	{
+		pdrgpexprEquiJoin->Release();
+		return;
+	}
+
+	// 1. create the CTE producer of the smaller side
+	const ULONG ulCTEId = COptCtxt::PoctxtFromTLS()->Pcteinfo()->next_id();
+	CColRefArray *pdrgpcrSmall = pcrsSmall->Pdrgpcr(mp);
+	(void) CXformUtils::PexprAddCTEProducer(mp, ulCTEId, pdrgpcrSmall,
+											pexprSmall);
+
+	// 2. create the distinct keys of the smaller side over a second consumer
+	CColRefArray *pdrgpcrSmallCopy = CUtils::PdrgpcrCopy(mp, pdrgpcrSmall);
+	UlongToColRefMap *colref_mapping =
+		CUtils::PhmulcrMapping(mp, pdrgpcrSmall, pdrgpcrSmallCopy);
+	CExpression *pexprEquiJoin =
+		CPredicateUtils::PexprConjunction(mp, pdrgpexprEquiJoin);
+	CExpression *pexprSemiJoinPred = pexprEquiJoin->PexprCopyWithRemappedColumns(
+		mp, colref_mapping, false /*must_exist*/);
+	pexprEquiJoin->Release();
+	colref_mapping->Release();
+
+	CColRefSet *pcrsKeys = GPOS_NEW(mp) CColRefSet(mp, pdrgpcrSmallCopy);
+	pcrsKeys->Intersection(pexprSemiJoinPred->DeriveUsedColumns());
+	CColRefArray *pdrgpcrKeys = pcrsKeys->Pdrgpcr(mp);
+	pcrsKeys->Release();
+
+	CExpression *pexprGbAgg = GPOS_NEW(mp) CExpression(
+		mp,
+		GPOS_NEW(mp)
+			CLogicalGbAgg(mp, pdrgpcrKeys, COperator::EgbaggtypeGlobal),
+		CXformUtils::PexprCTEConsumer(mp, ulCTEId, pdrgpcrSmallCopy),
+		GPOS_NEW(mp) CExpression(mp, GPOS_NEW(mp) CScalarProjectList(mp)));
+
+	// 3. semi join the larger side with the distinct keys
+	pexprBig->AddRef();
+	CExpression *pexprSemiJoin = GPOS_NEW(mp) CExpression(
+		mp,
+		GPOS_NEW(mp)
+			CLogicalLeftSemiJoin(mp, CXform::ExfInnerJoinSemiJoinReduction),
+		pexprBig, pexprGbAgg, pexprSemiJoinPred);
+
+	// 4. join the reduced side with the smaller side, keeping the original
+	//    order of the children, output columns and predicate
+	CExpression *pexprConsumer =
+		CXformUtils::PexprCTEConsumer(mp, ulCTEId, pdrgpcrSmall);
+	pexprScalar->AddRef();
+	CExpression *pexprJoin = NULL;
+	if (fReduceOuter)
+	{
+		pexprJoin = GPOS_NEW(mp) CExpression(
+			mp, GPOS_NEW(mp) CLogicalInnerJoin(mp), pexprSemiJoin,
+			pexprConsumer, pexprScalar);
+	}
+	else
+	{
+		pexprJoin = GPOS_NEW(mp) CExpression(
+			mp, GPOS_NEW(mp) CLogicalInnerJoin(mp), pexprConsumer,
+			pexprSemiJoin, pexprScalar);
+	}
+
+	// 5. add the CTE anchor
+	CExpression *pexprAnchor = GPOS_NEW(mp) CExpression(
+		mp, GPOS_NEW(mp) CLogicalCTEAnchor(mp, ulCTEId), pexprJoin);
+
+	pxfres->Add(pexprAnchor);
+}
+
+// EOF
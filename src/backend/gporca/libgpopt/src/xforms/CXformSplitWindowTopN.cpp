@@ -0,0 +1,256 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2020 VMware, Inc.
+//
+//	@filename:
+//		CXformSplitWindowTopN.cpp
+//
+//	@doc:
+//		Implementation of the local pre-filter of windows followed by a
+//		top-N filter
+//---------------------------------------------------------------------------
+
+#include "gpopt/xforms/CXformSplitWindowTopN.h"
+
+#include "gpos/base.h"
+
+#include "gpopt/base/CUtils.h"
+#include "gpopt/operators/CLogicalSelect.h"
+#include "gpopt/operators/CLogicalSequenceProject.h"
+#include "gpopt/operators/CPatternLeaf.h"
+#include "gpopt/operators/CPatternTree.h"
+#include "gpopt/operators/CPredicateUtils.h"
+#include "gpopt/operators/CScalarCmp.h"
+#include "gpopt/operators/CScalarIdent.h"
+#include "gpopt/operators/CScalarProjectElement.h"
+#include "gpopt/operators/CScalarProjectList.h"
+#include "gpopt/operators/CScalarWindowFunc.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
+#include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/traceflags/traceflags.h"
+
+using namespace gpopt;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformSplitWindowTopN::CXformSplitWindowTopN
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CXformSplitWindowTopN::CXformSplitWindowTopN(CMemoryPool *mp)
+	:  // pattern
+	  CXformExploration(GPOS_NEW(mp) CExpression(
+		  mp, GPOS_NEW(mp) CLogicalSelect(mp),
+		  GPOS_NEW(mp) CExpression(
+			  mp, GPOS_NEW(mp) CLogicalSequenceProject(mp),
+			  GPOS_NEW(mp) CExpression(
+				  mp, GPOS_NEW(mp) CPatternLeaf(mp)),  // window child
+			  GPOS_NEW(mp) CExpression(
+				  mp, GPOS_NEW(mp) CPatternTree(mp))  // project list
+			  ),
+		  GPOS_NEW(mp)
+			  CExpression(mp, GPOS_NEW(mp) CPatternTree(mp))  // predicate
+		  ))
+{
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformSplitWindowTopN::Exfp
+//
+//	@doc:
+//		Compute xform promise for a given expression handle
+//
+//---------------------------------------------------------------------------
+CXform::EXformPromise
+CXformSplitWindowTopN::Exfp(CExpressionHandle &exprhdl) const
+{
+	if (!GPOS_FTRACE(EopttraceEnableWindowTopNPushdown) ||
+		exprhdl.HasOuterRefs())
+	{
+		return CXform::ExfpNone;
+	}
+
+	return CXform::ExfpHigh;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformSplitWindowTopN::PexprTopNFunc
+//
+//	@doc:
+//		Return the window function of the given sequence project whose
+//		output column the given predicate bounds from above, i.e. a
+//		predicate of the form "rn < const" or "rn <= const" where rn is
+//		computed by row_number() or rank(). Returns NULL if there is no
+//		such function, or if the sequence project computes anything other
+//		than row_number() and rank(): any other window function would see
+//		only the rows left by the local filter.
+//
+//---------------------------------------------------------------------------
+CExpression *
+CXformSplitWindowTopN::PexprTopNFunc(CExpression *pexprSeqPrj,
+									 CExpression *pexprPred)
+{
+	if (COperator::EopScalarCmp != pexprPred->Pop()->Eopid() ||
+		COperator::EopScalarIdent != (*pexprPred)[0]->Pop()->Eopid() ||
+		COperator::EopScalarConst != (*pexprPred)[1]->Pop()->Eopid())
+	{
+		return NULL;
+	}
+
+	IMDType::ECmpType cmp_type =
+		CScalarCmp::PopConvert(pexprPred->Pop())->ParseCmpType();
+	if (IMDType::EcmptL != cmp_type && IMDType::EcmptLEq != cmp_type)
+	{
+		return NULL;
+	}
+
+	const CColRef *colref =
+		CScalarIdent::PopConvert((*pexprPred)[0]->Pop())->Pcr();
+	CWindowOids *window_oids =
+		COptCtxt::PoctxtFromTLS()->GetOptimizerConfig()->GetWindowOids();
+
+	CExpression *pexprTopNFunc = NULL;
+	CExpression *pexprPrL = (*pexprSeqPrj)[1];
+	const ULONG arity = pexprPrL->Arity();
+	for (ULONG ul = 0; ul < arity; ul++)
+	{
+		CExpression *pexprPrEl = (*pexprPrL)[ul];
+		CExpression *pexprFunc = (*pexprPrEl)[0];
+		if (COperator::EopScalarWindowFunc != pexprFunc->Pop()->Eopid() ||
+			0 != pexprFunc->Arity())
+		{
+			return NULL;
+		}
+
+		OID oid = CMDIdGPDB::CastMdid(
+					  CScalarWindowFunc::PopConvert(pexprFunc->Pop())
+						  ->FuncMdId())
+					  ->Oid();
+		if (oid != window_oids->OidRowNumber() &&
+			oid != window_oids->OidRank())
+		{
+			return NULL;
+		}
+
+		if (CScalarProjectElement::PopConvert(pexprPrEl->Pop())->Pcr() ==
+			colref)
+		{
+			pexprTopNFunc = pexprFunc;
+		}
+	}
+
+	return pexprTopNFunc;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformSplitWindowTopN::Transform
+//
+//	@doc:
+//		A row whose row_number() or rank() within the rows of one segment
+//		is beyond N cannot be within N over the whole partition either,
+//		since the rows ranked ahead of it on its segment are ranked ahead
+//		of it globally as well. So the same window and filter can be
+//		evaluated locally on each segment first.
+//
+//		The rows that pass the outer filter keep their global row_number()
+//		and rank() values, since every row ranked ahead of them survives
+//		the local filter too. That does not hold for any other window
+//		function, e.g. a sum() or lag() over the same window, so the
+//		alternative is only generated when the sequence project computes
+//		nothing but row_number() and rank() over a single order spec.
+//
+//---------------------------------------------------------------------------
+void
+CXformSplitWindowTopN::Transform(CXformContext *pxfctxt, CXformResult *pxfres,
+								 CExpression *pexpr) const
+{
+	GPOS_ASSERT(NULL != pxfctxt);
+	GPOS_ASSERT(FPromising(pxfctxt->Pmp(), this, pexpr));
+	GPOS_ASSERT(FCheckPattern(pexpr));
+
+	CMemoryPool *mp = pxfctxt->Pmp();
+
+	CExpression *pexprSeqPrj = (*pexpr)[0];
+	CExpression *pexprScalar = (*pexpr)[1];
+	CLogicalSequenceProject *popSeqPrj =
+		CLogicalSequenceProject::PopConvert(pexprSeqPrj->Pop());
+	if (COperator::EsptypeGlobal != popSeqPrj->Esptype() ||
+		!popSeqPrj->FHasOrderSpecs() || 1 != popSeqPrj->Pdrgpos()->Size() ||
+		0 < pexprSeqPrj->DeriveOuterReferences()->Size())
+	{
+		return;
+	}
+
+	// look for a conjunct bounding a row_number()/rank() output from above
+	CExpression *pexprPred = NULL;
+	CExpression *pexprFunc = NULL;
+	CExpressionArray *pdrgpexprConjuncts =
+		CPredicateUtils::PdrgpexprConjuncts(mp, pexprScalar);
+	const ULONG ulConjuncts = pdrgpexprConjuncts->Size();
+	for (ULONG ul = 0; ul < ulConjuncts && NULL == pexprFunc; ul++)
+	{
+		pexprPred = (*pdrgpexprConjuncts)[ul];
+		pexprFunc = PexprTopNFunc(pexprSeqPrj, pexprPred);
+	}
+
+	if (NULL == pexprFunc)
+	{
+		pdrgpexprConjuncts->Release();
+		return;
+	}
+
+	// compute the same function into a new column over each segment's rows
+	const CColRef *pcrTopN =
+		CScalarIdent::PopConvert((*pexprPred)[0]->Pop())->Pcr();
+	CColRef *pcrLocal = COptCtxt::PoctxtFromTLS()->Pcf()->PcrCreate(pcrTopN);
+
+	pexprFunc->AddRef();
+	CExpression *pexprPrL = GPOS_NEW(mp) CExpression(
+		mp, GPOS_NEW(mp) CScalarProjectList(mp),
+		GPOS_NEW(mp) CExpression(
+			mp, GPOS_NEW(mp) CScalarProjectElement(mp, pcrLocal), pexprFunc));
+
+	CDistributionSpec *pds = popSeqPrj->Pds();
+	COrderSpecArray *pdrgpos = popSeqPrj->Pdrgpos();
+	CWindowFrameArray *pdrgpwf = popSeqPrj->Pdrgpwf();
+	pds->AddRef();
+	pdrgpos->AddRef();
+	pdrgpwf->AddRef();
+	(*pexprSeqPrj)[0]->AddRef();
+	CExpression *pexprLocalSeqPrj = GPOS_NEW(mp)
+		CExpression(mp,
+					GPOS_NEW(mp) CLogicalSequenceProject(
+						mp, pds, pdrgpos, pdrgpwf, COperator::EsptypeLocal),
+					(*pexprSeqPrj)[0], pexprPrL);
+
+	// apply the same bound to the local column
+	pexprPred->Pop()->AddRef();
+	(*pexprPred)[1]->AddRef();
+	CExpression *pexprLocalPred = GPOS_NEW(mp)
+		CExpression(mp, pexprPred->Pop(), CUtils::PexprScalarIdent(mp, pcrLocal),
+					(*pexprPred)[1]);
+	pdrgpexprConjuncts->Release();
+
+	CExpression *pexprLocalSelect =
+		CUtils::PexprLogicalSelect(mp, pexprLocalSeqPrj, pexprLocalPred);
+
+	// stack the original window and filter on top
+	popSeqPrj->AddRef();
+	(*pexprSeqPrj)[1]->AddRef();
+	CExpression *pexprGlobalSeqPrj = GPOS_NEW(mp)
+		CExpression(mp, popSeqPrj, pexprLocalSelect, (*pexprSeqPrj)[1]);
+
+	pexpr->Pop()->AddRef();
+	pexprScalar->AddRef();
+	CExpression *pexprResult = GPOS_NEW(mp)
+		CExpression(mp, pexpr->Pop(), pexprGlobalSeqPrj, pexprScalar);
+
+	pxfres->Add(pexprResult);
+}
+
+// EOF
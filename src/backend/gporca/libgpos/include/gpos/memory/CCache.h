@@ -65,6 +65,9 @@ class CCacheAccessor;
 //
 //		Cache can only be accessed through the CCacheAccessor friend class.
 //		The current implementation has a fixed gclock based eviction policy.
+//		Entries larger than the average cached entry get a gclock counter
+//		proportionally smaller than the initial one, so a few big objects
+//		are evicted before many small and frequently used ones.
 //
 //---------------------------------------------------------------------------
 template <class T, class K>
@@ -77,6 +80,12 @@ public:
 	typedef ULONG (*HashFuncPtr)(const K &);
 	typedef BOOL (*EqualFuncPtr)(const K &, const K &);
 
+	// type definition of function selecting the objects to delete
+	typedef BOOL (*MatchFuncPtr)(T, void *);
+
+	// type definition of function notified about evicted objects
+	typedef void (*EvictFuncPtr)(T);
+
 private:
 	typedef CCacheEntry<T, K> CCacheHashTableEntry;
 
@@ -118,6 +127,9 @@ private:
 	// a pointer to key equality function
 	EqualFuncPtr m_equal_func;
 
+	// a pointer to function called for every evicted object; may be NULL
+	EvictFuncPtr m_evict_func;
+
 	// synchronized hash table; used to store and lookup entries
 	CCacheHashtable m_hash_table;
 
@@ -196,12 +208,35 @@ private:
 			ret = found;
 		}
 
-		ret->SetGClockCounter(m_gclock_init_counter);
+		ret->SetGClockCounter(GClockInitCounter(ret));
 		ret->IncRefCount();
 
 		return ret;
 	}
 
+	// returns the gclock counter for a newly inserted or accessed entry;
+	// entries larger than the average entry get a proportionally smaller
+	// counter, but always survive at least one pass of the clock hand
+	ULONG
+	GClockInitCounter(CCacheHashTableEntry *entry)
+	{
+		ULONG_PTR num_entries = m_hash_table.Size();
+		if (0 == m_cache_quota || 0 == num_entries)
+		{
+			return m_gclock_init_counter;
+		}
+
+		ULLONG avg_size = m_cache_size / num_entries;
+		ULLONG entry_size = entry->Pmp()->TotalAllocatedSize();
+		if (entry_size <= avg_size)
+		{
+			return m_gclock_init_counter;
+		}
+
+		return std::max((ULONG) 1,
+						(ULONG)(m_gclock_init_counter * avg_size / entry_size));
+	}
+
 	// returns the first object matching the given key
 	CCacheHashTableEntry *
 	Get(const K key)
@@ -217,7 +252,7 @@ private:
 
 		if (NULL != entry)
 		{
-			entry->SetGClockCounter(m_gclock_init_counter);
+			entry->SetGClockCounter(GClockInitCounter(entry));
 			// increase ref count, since CCacheHashtableAccessor points to the obj
 			// ref count will be decreased when CCacheHashtableAccessor will be destroyed
 			entry->IncRefCount();
@@ -252,6 +287,7 @@ private:
 				// remove entry from hash table
 				acc.Remove(entry);
 				deleted = true;
+				m_cache_size -= entry->Pmp()->TotalAllocatedSize();
 			}
 		}
 
@@ -417,6 +453,10 @@ private:
 			if (deleted)
 			{
 				GPOS_ASSERT(NULL != entry);
+				if (NULL != m_evict_func)
+				{
+					m_evict_func(entry->Val());
+				}
 				DestroyCacheEntry(entry);
 			}
 		}
@@ -437,7 +477,8 @@ public:
 		  m_eviction_counter(0),
 		  m_clock_hand_advanced(false),
 		  m_hash_func(hash_func),
-		  m_equal_func(equal_func)
+		  m_equal_func(equal_func),
+		  m_evict_func(NULL)
 	{
 		GPOS_ASSERT(NULL != m_mp &&
 					"Cache memory pool could not be initialized");
@@ -507,6 +548,62 @@ public:
 		}
 	}
 
+	// sets the function notified about objects evicted from the cache
+	void
+	SetEvictFunc(EvictFuncPtr evict_func)
+	{
+		m_evict_func = evict_func;
+	}
+
+	// deletes all objects for which the given function returns true;
+	// objects that are still in use are marked for deletion and removed
+	// once they are released; returns the number of matching objects
+	ULONG
+	DeleteEntries(MatchFuncPtr match_func, void *arg)
+	{
+		GPOS_ASSERT(NULL != match_func);
+
+		ULONG num_matched = 0;
+		CCacheHashtableIter iter(m_hash_table);
+		BOOL advanced = false;
+		while (advanced || iter.Advance())
+		{
+			advanced = false;
+			CCacheHashTableEntry *entry = NULL;
+			BOOL deleted = false;
+			// Scope for CCacheHashtableIterAccessor
+			{
+				CCacheHashtableIterAccessor acc(iter);
+
+				entry = acc.Value();
+				if (NULL != entry && !entry->IsMarkedForDeletion() &&
+					match_func(entry->Val(), arg))
+				{
+					num_matched++;
+					if (EXPECTED_REF_COUNT_FOR_DELETE == entry->RefCount())
+					{
+						// remove advances iterator automatically
+						acc.Remove(entry);
+						deleted = true;
+						advanced = true;
+						m_cache_size -= entry->Pmp()->TotalAllocatedSize();
+					}
+					else
+					{
+						entry->MarkForDeletion();
+					}
+				}
+			}
+
+			if (deleted)
+			{
+				DestroyCacheEntry(entry);
+			}
+		}
+
+		return num_matched;
+	}
+
 	// return eviction factor (what percentage of cache size to evict)
 	float
 	GetEvictionFactor()
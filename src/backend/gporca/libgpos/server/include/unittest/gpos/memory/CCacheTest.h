@@ -50,6 +50,12 @@ private:
 		//key equality function
 		static BOOL FMyEqual(ULONG *const &pvKey, ULONG *const &pvKeySecond);
 
+		// selects objects with an odd key
+		static BOOL FOddKey(SSimpleObject *pso, void *pvArg);
+
+		// counts evicted objects
+		static void CountEviction(SSimpleObject *pso);
+
 		// equality for object-based comparison
 		BOOL
 		operator==(const SSimpleObject &obj) const
@@ -157,6 +163,8 @@ public:
 	static GPOS_RESULT EresUnittest_DeepObject();
 	static GPOS_RESULT EresUnittest_Iteration();
 	static GPOS_RESULT EresUnittest_IterativeDeletion();
+	static GPOS_RESULT EresUnittest_DeleteEntries();
+	static GPOS_RESULT EresUnittest_SizeAwareEviction();
 
 
 };	// class CCacheTest
@@ -30,6 +30,9 @@ using namespace gpos;
 // static variable
 static BOOL fUnique = true;
 
+// number of objects reported by the eviction callback
+static ULONG ulEvicted = 0;
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CCacheTest::EresUnittest
@@ -47,7 +50,9 @@ CCacheTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_Eviction),
 		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_Iteration),
 		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_DeepObject),
-		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_IterativeDeletion)};
+		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_IterativeDeletion),
+		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_DeleteEntries),
+		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_SizeAwareEviction)};
 
 	fUnique = true;
 	GPOS_RESULT eres = CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -998,4 +1003,160 @@ CCacheTest::EresUnittest_IterativeDeletion()
 	return GPOS_OK;
 }
 
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCacheTest::SSimpleObject::FOddKey
+//
+//	@doc:
+//		Selects objects with an odd key
+//
+//---------------------------------------------------------------------------
+BOOL
+CCacheTest::SSimpleObject::FOddKey(SSimpleObject *pso, void *  // pvArg
+)
+{
+	return 1 == pso->m_ulKey % 2;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCacheTest::EresUnittest_DeleteEntries
+//
+//	@doc:
+//		Deleting all entries matching a function
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CCacheTest::EresUnittest_DeleteEntries()
+{
+	CAutoP<CCache<SSimpleObject *, ULONG *> > apcache;
+	apcache = CCacheFactory::CreateCache<SSimpleObject *, ULONG *>(
+		fUnique, UNLIMITED_CACHE_QUOTA, SSimpleObject::UlMyHash,
+		SSimpleObject::FMyEqual);
+
+	CCache<SSimpleObject *, ULONG *> *pcache = apcache.Value();
+
+	ULLONG ullOneElemSize = 0;
+	for (ULONG ul = 0; ul < GPOS_CACHE_ELEMENTS; ul++)
+	{
+		ullOneElemSize = InsertOneElement(pcache, ul);
+	}
+
+	// pin one of the odd entries, it must survive until released
+	ULONG ulPinnedKey = 1;
+	{
+		CSimpleObjectCacheAccessor caPinned(pcache);
+		caPinned.Lookup(&ulPinnedKey);
+		SSimpleObject *psoPinned = caPinned.Val();
+		GPOS_RTL_ASSERT(NULL != psoPinned);
+
+		// release object since there is no customer to release it
+		psoPinned->Release();
+
+		ULONG ulMatched = pcache->DeleteEntries(SSimpleObject::FOddKey, NULL);
+		GPOS_RTL_ASSERT(GPOS_CACHE_ELEMENTS / 2 == ulMatched);
+		GPOS_RTL_ASSERT(GPOS_CACHE_ELEMENTS / 2 + 1 == pcache->Size());
+		GPOS_RTL_ASSERT(1 == psoPinned->m_ulKey);
+	}
+
+	GPOS_RTL_ASSERT(GPOS_CACHE_ELEMENTS / 2 == pcache->Size());
+	GPOS_RTL_ASSERT(GPOS_CACHE_ELEMENTS / 2 * ullOneElemSize ==
+					pcache->TotalAllocatedSize());
+
+	for (ULONG ul = 0; ul < GPOS_CACHE_ELEMENTS; ul++)
+	{
+		CSimpleObjectCacheAccessor ca(pcache);
+		ca.Lookup(&ul);
+		SSimpleObject *pso = ca.Val();
+		GPOS_RTL_ASSERT((NULL == pso) == (1 == ul % 2));
+
+		if (NULL != pso)
+		{
+			// release object since there is no customer to release it
+			pso->Release();
+		}
+	}
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCacheTest::SSimpleObject::CountEviction
+//
+//	@doc:
+//		Counts evicted objects
+//
+//---------------------------------------------------------------------------
+void
+CCacheTest::SSimpleObject::CountEviction(SSimpleObject *  // pso
+)
+{
+	ulEvicted++;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCacheTest::EresUnittest_SizeAwareEviction
+//
+//	@doc:
+//		Test that a large entry is evicted before small entries that were
+//		inserted before it
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CCacheTest::EresUnittest_SizeAwareEviction()
+{
+	CAutoP<CCache<SSimpleObject *, ULONG *> > apcache;
+	apcache = CCacheFactory::CreateCache<SSimpleObject *, ULONG *>(
+		fUnique, UNLIMITED_CACHE_QUOTA, SSimpleObject::UlMyHash,
+		SSimpleObject::FMyEqual);
+
+	CCache<SSimpleObject *, ULONG *> *pcache = apcache.Value();
+	pcache->SetEvictFunc(SSimpleObject::CountEviction);
+	ulEvicted = 0;
+
+	ULONG ulKey = 0;
+	ULLONG ullOneElemSize = InsertOneElement(pcache, ulKey++);
+	pcache->SetCacheQuota(GPOS_CACHE_ELEMENTS * ullOneElemSize);
+
+	// insert an entry ten times larger than the others, hashed to the
+	// last bucket so that the clock hand reaches it after all small entries
+	ULONG ulLargeKey = CACHE_HT_NUM_OF_BUCKETS - 1;
+	{
+		CSimpleObjectCacheAccessor ca(pcache);
+		CMemoryPool *mp = ca.Pmp();
+		SSimpleObject *pso = GPOS_NEW(mp) SSimpleObject(ulLargeKey, ulLargeKey);
+		(void) GPOS_NEW_ARRAY(mp, BYTE, 10 * ullOneElemSize);
+		ca.Insert(&(pso->m_ulKey), pso);
+		pso->Release();
+	}
+
+	// fill the cache with small entries until the first eviction
+	while (0 == pcache->GetEvictionCounter())
+	{
+		InsertOneElement(pcache, ulKey++);
+	}
+
+	GPOS_RTL_ASSERT(1 == ulEvicted);
+	for (ULONG ul = 0; ul < ulKey; ul++)
+	{
+		CSimpleObjectCacheAccessor ca(pcache);
+		ca.Lookup(&ul);
+		SSimpleObject *pso = ca.Val();
+		GPOS_RTL_ASSERT(NULL != pso);
+
+		// release object since there is no customer to release it
+		pso->Release();
+	}
+
+	CSimpleObjectCacheAccessor ca(pcache);
+	ca.Lookup(&ulLargeKey);
+	GPOS_RTL_ASSERT(NULL == ca.Val());
+
+	return GPOS_OK;
+}
+
 // EOF
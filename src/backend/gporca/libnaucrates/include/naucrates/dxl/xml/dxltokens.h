@@ -66,6 +66,7 @@ enum Edxltoken
 	EdxltokenPushGroupByBelowSetopThreshold,
 	EdxltokenXformBindThreshold,
 	EdxltokenSkewFactor,
+	EdxltokenJoinOrderBudget,
 	EdxltokenMaxStatsBuckets,
 	EdxltokenWindowOids,
 	EdxltokenOidRowNumber,
@@ -394,6 +394,9 @@ public:
 		return m_skew;
 	}
 
+	// estimated frequency of the most common single value, including NULL
+	CDouble GetMaxValueFreq() const;
+
 	// accessor of null fraction
 	CDouble
 	GetNullFreq() const
@@ -185,6 +185,9 @@ public:
 	// skew estimate for given column
 	virtual CDouble GetSkew(ULONG colid) const;
 
+	// frequency of the most common value of given column
+	virtual CDouble GetMaxValueFreq(ULONG colid) const;
+
 	// what is the width in bytes of set of column id's
 	virtual CDouble Width(ULongPtrArray *colids) const;
 
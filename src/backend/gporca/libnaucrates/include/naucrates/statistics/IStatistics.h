@@ -125,6 +125,9 @@ public:
 	// skew estimate for given column
 	virtual CDouble GetSkew(ULONG colid) const = 0;
 
+	// frequency of the most common value of given column
+	virtual CDouble GetMaxValueFreq(ULONG colid) const = 0;
+
 	// what is the width in bytes
 	virtual CDouble Width() const = 0;
 
@@ -231,6 +231,15 @@ enum EOptTraceFlag
 	// Keep locks on partition children during planning
 	EopttraceKeepPartitionChildrenLocks = 103045,
 
+	// Pre-filter windows followed by a row_number()/rank() top-N filter on each segment
+	EopttraceEnableWindowTopNPushdown = 103046,
+
+	// Remove left outer joins to a unique key whose inner columns are unused
+	EopttraceEnableOuterJoinElimination = 103047,
+
+	// Choose the DPv2 join order enumeration from the shape of the join graph
+	EopttraceEnableAdaptiveJoinOrder = 103048,
+
 	///////////////////////////////////////////////////////
 	///////////////////// statistics flags ////////////////
 	//////////////////////////////////////////////////////
@@ -256,6 +265,9 @@ enum EOptTraceFlag
 	// Penalize HashJoins with a skewed hash distribute under them
 	EopttracePenalizeSkewedHashJoin = 104006,
 
+	// Penalize HashJoins whose hash distribute sends a frequent value to one segment
+	EopttracePenalizeSkewMCV = 104007,
+
 	// Use legacy cost model
 	EopttraceLegacyCostModel = 104008,
 
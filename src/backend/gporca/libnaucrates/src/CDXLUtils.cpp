@@ -52,7 +52,9 @@ using namespace gpopt;
 
 XERCES_CPP_NAMESPACE_USE
 
-
+// size of the stack buffer used to widen short ASCII names without going
+// through a dynamic string
+#define GPDXL_MDNAME_BUFFER_SIZE 128
 
 //---------------------------------------------------------------------------
 //	@function:
@@ -1528,6 +1530,24 @@ CDXLUtils::CreateMDNameFromCharArray(CMemoryPool *mp, const CHAR *c)
 {
 	GPOS_ASSERT(NULL != c);
 
+	// relation and column names are almost always short ASCII identifiers,
+	// widen those in place so that the name is copied exactly once
+	WCHAR w_str_buffer[GPDXL_MDNAME_BUFFER_SIZE];
+	ULONG ul = 0;
+	while (ul < GPDXL_MDNAME_BUFFER_SIZE - 1 && '\0' != c[ul] &&
+		   0 == (c[ul] & 0x80))
+	{
+		w_str_buffer[ul] = (WCHAR) c[ul];
+		ul++;
+	}
+
+	if ('\0' == c[ul])
+	{
+		w_str_buffer[ul] = WCHAR_EOS;
+		CWStringConst str(w_str_buffer);
+		return GPOS_NEW(mp) CMDName(mp, &str);
+	}
+
 	CWStringDynamic *dxl_string =
 		CDXLUtils::CreateDynamicStringFromCharArray(mp, c);
 	CMDName *md_name = GPOS_NEW(mp) CMDName(mp, dxl_string);
@@ -2176,6 +2176,36 @@ CHistogram::ComputeSkew()
 	}
 }
 
+// estimate the frequency of the most common value of the column
+//
+// MCVs are merged into the histogram as singleton buckets, so a singleton's
+// frequency is exact; for a range bucket the values are assumed to share the
+// bucket frequency uniformly. NULLs all hash to the same segment, so the null
+// fraction is treated as one more value
+CDouble
+CHistogram::GetMaxValueFreq() const
+{
+	CDouble max_freq = m_null_freq;
+
+	const ULONG num_buckets = m_histogram_buckets->Size();
+	for (ULONG ul = 0; ul < num_buckets; ul++)
+	{
+		CBucket *bucket = (*m_histogram_buckets)[ul];
+		CDouble distinct = bucket->GetNumDistinct();
+		if (distinct < CDouble(1.0))
+		{
+			distinct = CDouble(1.0);
+		}
+		CDouble freq = bucket->GetFrequency() / distinct;
+		if (freq > max_freq)
+		{
+			max_freq = freq;
+		}
+	}
+
+	return max_freq;
+}
+
 // create the default histogram for a given column reference
 CHistogram *
 CHistogram::MakeDefaultHistogram(CMemoryPool *mp, CColRef *col_ref,
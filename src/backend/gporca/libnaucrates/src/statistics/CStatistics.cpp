@@ -201,6 +201,20 @@ CStatistics::GetSkew(ULONG colid) const
 	return histogram->GetSkew();
 }
 
+// return the estimated frequency of the most common value of the given
+// column, or zero if there is no histogram for it
+CDouble
+CStatistics::GetMaxValueFreq(ULONG colid) const
+{
+	CHistogram *histogram = m_colid_histogram_mapping->Find(&colid);
+	if (NULL == histogram)
+	{
+		return CDouble(0.0);
+	}
+
+	return histogram->GetMaxValueFreq();
+}
+
 // return total width in bytes
 CDouble
 CStatistics::Width() const
@@ -46,6 +46,9 @@ public:
 	// skew basic tests
 	static GPOS_RESULT EresUnittest_Skew();
 
+	// most common value frequency tests
+	static GPOS_RESULT EresUnittest_MaxValueFreq();
+
 	// merge basic tests
 	static GPOS_RESULT EresUnittest_MergeUnion();
 
@@ -75,6 +75,7 @@ public:
 	static GPOS_RESULT EresUnittest_IndexPartConstraint();
 	static GPOS_RESULT EresUnittest_Cast();
 	static GPOS_RESULT EresUnittest_ScCmp();
+	static GPOS_RESULT EresUnittest_PrefetchRelStats();
 	static GPOS_RESULT EresUnittest_PrematureMDIdRelease();
 
 };	// class CMDAccessorTest
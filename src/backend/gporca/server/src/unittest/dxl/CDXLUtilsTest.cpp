@@ -50,6 +50,7 @@ CDXLUtilsTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_SerializeQuery),
 		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_SerializePlan),
 		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_Encoding),
+		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_MDNameFromCharArray),
 	};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -231,4 +232,48 @@ CDXLUtilsTest::EresUnittest_Encoding()
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtilsTest::EresUnittest_MDNameFromCharArray
+//
+//	@doc:
+//		Testing creation of metadata names from short and long strings
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CDXLUtilsTest::EresUnittest_MDNameFromCharArray()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	// short name taking the inline path
+	CMDName *mdname = CDXLUtils::CreateMDNameFromCharArray(mp, "l_orderkey");
+	CWStringConst strShort(GPOS_WSZ_LIT("l_orderkey"));
+	GPOS_RTL_ASSERT(mdname->GetMDName()->Equals(&strShort));
+	GPOS_DELETE(mdname);
+
+	// empty name
+	mdname = CDXLUtils::CreateMDNameFromCharArray(mp, "");
+	GPOS_RTL_ASSERT(0 == mdname->GetMDName()->Length());
+	GPOS_DELETE(mdname);
+
+	// name longer than the inline buffer
+	CHAR szLong[301];
+	WCHAR wszLong[301];
+	for (ULONG ul = 0; ul < 300; ul++)
+	{
+		szLong[ul] = 'a' + (ul % 26);
+		wszLong[ul] = GPOS_WSZ_LIT('a') + (ul % 26);
+	}
+	szLong[300] = '\0';
+	wszLong[300] = WCHAR_EOS;
+
+	mdname = CDXLUtils::CreateMDNameFromCharArray(mp, szLong);
+	CWStringConst strLong(wszLong);
+	GPOS_RTL_ASSERT(mdname->GetMDName()->Equals(&strLong));
+	GPOS_DELETE(mdname);
+
+	return GPOS_OK;
+}
+
 // EOF
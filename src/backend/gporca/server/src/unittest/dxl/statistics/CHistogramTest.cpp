@@ -39,6 +39,7 @@ CHistogramTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_CHistogramInt4),
 		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_CHistogramBool),
 		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_Skew),
+		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_MaxValueFreq),
 		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_CHistogramValid),
 		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_MergeUnion),
 		GPOS_UNITTEST_FUNC(
@@ -323,6 +324,61 @@ CHistogramTest::EresUnittest_Skew()
 	return GPOS_OK;
 }
 
+// most common value frequency of singleton, range and null values
+GPOS_RESULT
+CHistogramTest::EresUnittest_MaxValueFreq()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	// an MCV holding 30% of the rows between two wide range buckets
+	CBucketArray *pdrgppbucket1 = GPOS_NEW(mp) CBucketArray(mp);
+	pdrgppbucket1->Append(CCardinalityTestUtils::PbucketIntegerClosedLowerBound(
+		mp, 1, 40, CDouble(0.35), CDouble(39.0)));
+	pdrgppbucket1->Append(CCardinalityTestUtils::PbucketInteger(
+		mp, 50, 50, true, true, CDouble(0.3), CDouble(1.0)));
+	pdrgppbucket1->Append(CCardinalityTestUtils::PbucketIntegerClosedLowerBound(
+		mp, 60, 100, CDouble(0.35), CDouble(40.0)));
+	CHistogram *histogram1 = GPOS_NEW(mp) CHistogram(mp, pdrgppbucket1);
+	GPOS_RTL_ASSERT(histogram1->GetMaxValueFreq() == CDouble(0.3));
+
+	// a range bucket with a single distinct value is as hot as an MCV
+	CBucketArray *pdrgppbucket2 = GPOS_NEW(mp) CBucketArray(mp);
+	pdrgppbucket2->Append(CCardinalityTestUtils::PbucketIntegerClosedLowerBound(
+		mp, 1, 10, CDouble(0.5), CDouble(0.5)));
+	pdrgppbucket2->Append(CCardinalityTestUtils::PbucketIntegerClosedLowerBound(
+		mp, 10, 100, CDouble(0.4), CDouble(90.0)));
+	CHistogram *histogram2 =
+		GPOS_NEW(mp) CHistogram(mp, pdrgppbucket2, true /* is_well_defined */,
+								CDouble(0.1) /* null_freq */,
+								CDouble(0.0) /* distinct_remaining */,
+								CDouble(0.0) /* freq_remaining */);
+	GPOS_RTL_ASSERT(histogram2->GetMaxValueFreq() == CDouble(0.5));
+
+	// NULLs all go to the same segment
+	CBucketArray *pdrgppbucket3 = GPOS_NEW(mp) CBucketArray(mp);
+	pdrgppbucket3->Append(CCardinalityTestUtils::PbucketIntegerClosedLowerBound(
+		mp, 1, 100, CDouble(0.4), CDouble(99.0)));
+	CHistogram *histogram3 =
+		GPOS_NEW(mp) CHistogram(mp, pdrgppbucket3, true /* is_well_defined */,
+								CDouble(0.6) /* null_freq */,
+								CDouble(0.0) /* distinct_remaining */,
+								CDouble(0.0) /* freq_remaining */);
+	GPOS_RTL_ASSERT(histogram3->GetMaxValueFreq() == CDouble(0.6));
+
+	// nothing is known about a column without buckets
+	CHistogram *histogram4 = GPOS_NEW(mp) CHistogram(mp);
+	GPOS_RTL_ASSERT(histogram4->GetMaxValueFreq() == CDouble(0.0));
+
+	GPOS_DELETE(histogram1);
+	GPOS_DELETE(histogram2);
+	GPOS_DELETE(histogram3);
+	GPOS_DELETE(histogram4);
+
+	return GPOS_OK;
+}
+
 // basic merge commutativity test
 GPOS_RESULT
 CHistogramTest::EresUnittest_MergeUnion()
@@ -24,6 +24,7 @@
 #include "naucrates/base/IDatumOid.h"
 #include "naucrates/exception.h"
 #include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/md/CMDIdRelStats.h"
 #include "naucrates/md/CMDProviderMemory.h"
 #include "naucrates/md/IMDAggregate.h"
 #include "naucrates/md/IMDCast.h"
@@ -32,6 +33,7 @@
 #include "naucrates/md/IMDFunction.h"
 #include "naucrates/md/IMDIndex.h"
 #include "naucrates/md/IMDPartConstraint.h"
+#include "naucrates/md/IMDRelStats.h"
 #include "naucrates/md/IMDRelation.h"
 #include "naucrates/md/IMDScCmp.h"
 #include "naucrates/md/IMDScalarOp.h"
@@ -77,7 +79,8 @@ CMDAccessorTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_CheckConstraint),
 		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_IndexPartConstraint),
 		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_Cast),
-		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_ScCmp)};
+		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_ScCmp),
+		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_PrefetchRelStats)};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
 }
@@ -707,6 +710,58 @@ CMDAccessorTest::EresUnittest_ScCmp()
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessorTest::EresUnittest_PrefetchRelStats
+//
+//	@doc:
+//		Test prefetching relation statistics into the MD accessor
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMDAccessorTest::EresUnittest_PrefetchRelStats()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(mp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	CMDIdGPDB *rel_mdid = GPOS_NEW(mp)
+		CMDIdGPDB(IMDId::EmdidRel, GPOPT_MDCACHE_TEST_OID /* OID */,
+				  1 /* major version */, 1 /* minor version */);
+
+	MdidHashSet *rel_mdids = GPOS_NEW(mp) MdidHashSet(mp);
+	rel_mdid->AddRef();
+	rel_mdids->Insert(rel_mdid);
+
+	ULLONG ullMisses = CMDCache::ULLGetMisses(IMDCacheObject::EmdtRelStats);
+	ULLONG ullHits = CMDCache::ULLGetHits(IMDCacheObject::EmdtRelStats);
+	mda.PrefetchRelStats(rel_mdids);
+	GPOS_RTL_ASSERT(
+		ullMisses + ullHits + 1 ==
+		CMDCache::ULLGetMisses(IMDCacheObject::EmdtRelStats) +
+			CMDCache::ULLGetHits(IMDCacheObject::EmdtRelStats));
+
+	// the statistics are now served by the accessor without a cache lookup
+	ullMisses = CMDCache::ULLGetMisses(IMDCacheObject::EmdtRelStats);
+	ullHits = CMDCache::ULLGetHits(IMDCacheObject::EmdtRelStats);
+	CMDIdRelStats *rel_stats_mdid = GPOS_NEW(mp) CMDIdRelStats(rel_mdid);
+	const IMDRelStats *pmdrelstats = mda.Pmdrelstats(rel_stats_mdid);
+	GPOS_RTL_ASSERT(ullMisses ==
+					CMDCache::ULLGetMisses(IMDCacheObject::EmdtRelStats));
+	GPOS_RTL_ASSERT(ullHits ==
+					CMDCache::ULLGetHits(IMDCacheObject::EmdtRelStats));
+	GPOS_RTL_ASSERT(CDouble(1234.0) == pmdrelstats->Rows());
+
+	rel_stats_mdid->Release();
+	rel_mdids->Release();
+
+	return GPOS_OK;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDAccessorTest::EresUnittest_Negative
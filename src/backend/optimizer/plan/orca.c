@@ -21,6 +21,8 @@
 
 #include "postgres.h"
 
+#include "access/hash.h"
+#include "catalog/namespace.h"
 #include "cdb/cdbmutate.h"		/* apply_shareinput */
 #include "cdb/cdbvars.h"
 #include "nodes/makefuncs.h"
@@ -30,12 +32,314 @@
 #include "optimizer/planner.h"
 #include "optimizer/transform.h"
 #include "portability/instr_time.h"
+#include "utils/builtins.h"
 #include "utils/guc.h"
+#include "utils/guc_tables.h"
+#include "utils/hsearch.h"
+#include "utils/inval.h"
 #include "utils/lsyscache.h"
+#include "utils/queryjumble.h"
 
 /* GPORCA entry point */
 extern PlannedStmt * GPOPTOptimizedPlan(Query *parse, bool *had_unexpected_failure);
 
+/*
+ * Statements that GPORCA recently rejected for an expected reason, such as
+ * an unsupported feature, are remembered by their query fingerprint (see
+ * JumbleQuery()), and repeats of them are handed straight to the Postgres
+ * planner without paying for GPORCA's setup. The cache is per backend and
+ * holds up to optimizer_fallback_cache_size entries.
+ *
+ * Whether GPORCA supports a statement may also depend on the optimizer_*
+ * GUCs and the search path, so a hash of those is part of the key. An entry
+ * is dropped when one of the relations the statement references changes,
+ * and the whole cache is flushed on a full relcache invalidation. To not
+ * stick with a stale decision for other reasons, every
+ * FALLBACK_CACHE_RETRY_INTERVAL'th repeat of a remembered statement is
+ * given to GPORCA again.
+ */
+#define FALLBACK_CACHE_RETRY_INTERVAL	1000
+
+/* max # of relations remembered per entry */
+#define FALLBACK_CACHE_MAX_RELIDS		8
+
+typedef struct FallbackCacheKey
+{
+	uint32		fingerprint;	/* query fingerprint */
+	uint32		settings;		/* hash of the optimizer settings */
+} FallbackCacheKey;
+
+typedef struct FallbackCacheEntry
+{
+	FallbackCacheKey key;		/* hash key, must be first */
+	uint64		repeats;		/* # of times the statement was seen again */
+	int			nrelids;		/* # of relids, -1 if there were too many */
+	Oid			relids[FALLBACK_CACHE_MAX_RELIDS];	/* relations used */
+} FallbackCacheEntry;
+
+static HTAB *fallback_cache = NULL;
+static bool fallback_cache_invalid = false;
+static bool fallback_cache_callback_registered = false;
+
+/* optimizer_settings_hash() result, valid while the GUCs are unchanged */
+static uint32 settings_hash = 0;
+static uint64 settings_hash_version = 0;
+static bool settings_hash_valid = false;
+
+/* counters, reported by gp_opt_fallback_cache_stats() */
+static uint64 fallback_cache_avoided = 0;	/* GPORCA invocations avoided */
+static uint64 fallback_cache_retries = 0;	/* remembered statements retried */
+static uint64 fallback_cache_inserts = 0;	/* statements remembered */
+static uint64 fallback_cache_resets = 0;	/* cache flushes */
+
+/*
+ * Does a cache entry depend on the given relation?
+ */
+static bool
+fallback_entry_uses_relation(FallbackCacheEntry *entry, Oid relid)
+{
+	int			i;
+
+	if (entry->nrelids < 0)
+		return true;
+
+	for (i = 0; i < entry->nrelids; i++)
+	{
+		if (entry->relids[i] == relid)
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * Relcache invalidation callback: a changed relation may change whether
+ * GPORCA supports the statements that use it, so forget those. On a full
+ * invalidation, forget everything.
+ */
+static void
+fallback_cache_relcache_callback(Datum arg, Oid relid)
+{
+	HASH_SEQ_STATUS status;
+	FallbackCacheEntry *entry;
+
+	if (fallback_cache == NULL)
+		return;
+
+	if (!OidIsValid(relid))
+	{
+		fallback_cache_invalid = true;
+		return;
+	}
+
+	hash_seq_init(&status, fallback_cache);
+	while ((entry = (FallbackCacheEntry *) hash_seq_search(&status)) != NULL)
+	{
+		/* removing the entry just returned is fine during the scan */
+		if (fallback_entry_uses_relation(entry, relid))
+			hash_search(fallback_cache, &entry->key, HASH_REMOVE, NULL);
+	}
+}
+
+static void
+fallback_cache_reset(void)
+{
+	if (fallback_cache != NULL)
+	{
+		hash_destroy(fallback_cache);
+		fallback_cache = NULL;
+		fallback_cache_resets++;
+	}
+	fallback_cache_invalid = false;
+}
+
+/*
+ * Return the fallback cache, creating it if needed, or NULL if it is
+ * disabled.
+ */
+static HTAB *
+fallback_cache_get(void)
+{
+	HASHCTL		ctl;
+
+	if (optimizer_fallback_cache_size <= 0)
+	{
+		fallback_cache_reset();
+		return NULL;
+	}
+
+	if (fallback_cache_invalid)
+		fallback_cache_reset();
+
+	if (fallback_cache != NULL)
+		return fallback_cache;
+
+	if (!fallback_cache_callback_registered)
+	{
+		CacheRegisterRelcacheCallback(fallback_cache_relcache_callback,
+									  (Datum) 0);
+		fallback_cache_callback_registered = true;
+	}
+
+	MemSet(&ctl, 0, sizeof(ctl));
+	ctl.keysize = sizeof(FallbackCacheKey);
+	ctl.entrysize = sizeof(FallbackCacheEntry);
+	ctl.hash = tag_hash;
+	fallback_cache = hash_create("GPORCA fallback cache",
+								 Min(optimizer_fallback_cache_size, 256),
+								 &ctl, HASH_ELEM | HASH_FUNCTION);
+
+	return fallback_cache;
+}
+
+/*
+ * Remember the relations a statement uses in its cache entry.
+ */
+static void
+fallback_entry_set_relations(FallbackCacheEntry *entry, Query *parse)
+{
+	List	   *relationOids = NIL;
+	List	   *invalItems = NIL;
+	ListCell   *lc;
+
+	extract_query_dependencies((Node *) parse, &relationOids, &invalItems);
+
+	entry->nrelids = 0;
+	foreach(lc, relationOids)
+	{
+		if (entry->nrelids == FALLBACK_CACHE_MAX_RELIDS)
+		{
+			entry->nrelids = -1;
+			break;
+		}
+		entry->relids[entry->nrelids++] = lfirst_oid(lc);
+	}
+
+	list_free(relationOids);
+	list_free_deep(invalItems);
+}
+
+/*
+ * Hash the settings that GPORCA's decision to fall back may depend on: the
+ * values of all optimizer_* GUCs, and the search path. The hash is cached
+ * until the GUC version counter moves, so that statements planned under the
+ * same settings do not walk all the GUCs again.
+ */
+static uint32
+optimizer_settings_hash(void)
+{
+	struct config_generic **gucs;
+	int			nguc;
+	uint64		version = GetConfigOptionsVersion();
+	uint32		hash = 0;
+	int			i;
+
+	if (settings_hash_valid && settings_hash_version == version)
+		return settings_hash;
+
+	gucs = get_guc_variables();
+	nguc = GetNumConfigOptions();
+	for (i = 0; i < nguc; i++)
+	{
+		struct config_generic *conf = gucs[i];
+		uint32		valhash = 0;
+
+		if (strncmp(conf->name, "optimizer", strlen("optimizer")) != 0)
+			continue;
+
+		switch (conf->vartype)
+		{
+			case PGC_BOOL:
+				valhash = (uint32) *((struct config_bool *) conf)->variable;
+				break;
+			case PGC_INT:
+				valhash = (uint32) *((struct config_int *) conf)->variable;
+				break;
+			case PGC_REAL:
+				{
+					double		val = *((struct config_real *) conf)->variable;
+
+					valhash = DatumGetUInt32(hash_any((unsigned char *) &val,
+													  sizeof(val)));
+				}
+				break;
+			case PGC_STRING:
+				{
+					char	   *val = *((struct config_string *) conf)->variable;
+
+					if (val != NULL)
+						valhash = DatumGetUInt32(hash_any((unsigned char *) val,
+														  strlen(val)));
+				}
+				break;
+			case PGC_ENUM:
+				valhash = (uint32) *((struct config_enum *) conf)->variable;
+				break;
+		}
+
+		hash = DatumGetUInt32(hash_uint32(hash ^ valhash));
+	}
+
+	if (namespace_search_path != NULL)
+		hash ^= DatumGetUInt32(hash_any((unsigned char *) namespace_search_path,
+										strlen(namespace_search_path)));
+
+	settings_hash = hash;
+	settings_hash_version = version;
+	settings_hash_valid = true;
+
+	return hash;
+}
+
+/*
+ * Compute the fingerprint of a query, leaving its queryId untouched.
+ */
+static uint32
+query_fingerprint(Query *parse)
+{
+	uint32		savedQueryId = parse->queryId;
+	uint32		fingerprint;
+	JumbleState *jstate;
+
+	jstate = JumbleQuery(parse);
+	fingerprint = parse->queryId;
+	parse->queryId = savedQueryId;
+	freeJumbleState(jstate);
+
+	return fingerprint;
+}
+
+/*
+ * Build the fallback cache key of a statement.
+ */
+static void
+fallback_key_init(FallbackCacheKey *key, Query *parse)
+{
+	MemSet(key, 0, sizeof(*key));
+	key->fingerprint = query_fingerprint(parse);
+	key->settings = optimizer_settings_hash();
+}
+
+/*
+ * Report the fallback cache counters.
+ */
+Datum
+OptimizerFallbackCacheStats(void)
+{
+	StringInfoData str;
+
+	initStringInfo(&str);
+	appendStringInfo(&str,
+					 "entries: " UINT64_FORMAT ", avoided: " UINT64_FORMAT
+					 ", retries: " UINT64_FORMAT ", inserts: " UINT64_FORMAT
+					 ", resets: " UINT64_FORMAT,
+					 fallback_cache ? (uint64) hash_get_num_entries(fallback_cache) : 0,
+					 fallback_cache_avoided, fallback_cache_retries,
+					 fallback_cache_inserts, fallback_cache_resets);
+
+	return CStringGetTextDatum(str.data);
+}
+
 /*
  * Logging of optimization outcome
  */
@@ -89,6 +393,43 @@ optimize_query(Query *parse, ParamListInfo boundParams)
 	List		   *invalItems;
 	ListCell	   *lc;
 	ListCell	   *lp;
+	HTAB		   *fallbackCache;
+	FallbackCacheEntry *fallbackEntry;
+	bool			fingerprinted = false;
+	bool			remembered = false;
+	FallbackCacheKey fallbackKey;
+
+	/*
+	 * Skip GPORCA for statements that recently fell back to the Postgres
+	 * planner. While the cache is empty, there is nothing to look up, and
+	 * the statement is only fingerprinted if GPORCA falls back.
+	 */
+	fallbackCache = fallback_cache_get();
+	if (fallbackCache != NULL && parse->utilityStmt == NULL &&
+		hash_get_num_entries(fallbackCache) > 0)
+	{
+		fallback_key_init(&fallbackKey, parse);
+		fingerprinted = true;
+		fallbackEntry = (FallbackCacheEntry *)
+			hash_search(fallbackCache, &fallbackKey, HASH_FIND, NULL);
+
+		if (fallbackEntry != NULL)
+		{
+			remembered = true;
+			if (++fallbackEntry->repeats % FALLBACK_CACHE_RETRY_INTERVAL != 0)
+			{
+				fallback_cache_avoided++;
+
+				if (optimizer_trace_fallback)
+					ereport(INFO,
+							(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+							 errmsg("GPORCA failed to produce a plan, falling back to planner"),
+							 errdetail("GPORCA was not invoked, the statement fell back recently.")));
+				return NULL;
+			}
+			fallback_cache_retries++;
+		}
+	}
 
 	/*
 	 * Initialize a dummy PlannerGlobal struct. ORCA doesn't use it, but the
@@ -141,6 +482,41 @@ optimize_query(Query *parse, ParamListInfo boundParams)
 
 	CHECK_FOR_INTERRUPTS();
 
+	/*
+	 * Remember statements that fell back for an expected reason, and forget
+	 * remembered ones that GPORCA now supports. Look the cache up again, as
+	 * it may have been flushed while GPORCA was running.
+	 */
+	fallbackCache = parse->utilityStmt == NULL ? fallback_cache_get() : NULL;
+	if (fallbackCache != NULL)
+	{
+		if (result == NULL && !fUnexpectedFailure && !remembered)
+		{
+			bool		found;
+
+			if (!fingerprinted)
+				fallback_key_init(&fallbackKey, parse);
+
+			/* full; start over rather than tracking recency */
+			if (hash_get_num_entries(fallbackCache) >= optimizer_fallback_cache_size)
+			{
+				fallback_cache_reset();
+				fallbackCache = fallback_cache_get();
+			}
+
+			fallbackEntry = (FallbackCacheEntry *)
+				hash_search(fallbackCache, &fallbackKey, HASH_ENTER, &found);
+			if (!found)
+			{
+				fallbackEntry->repeats = 0;
+				fallback_entry_set_relations(fallbackEntry, parse);
+				fallback_cache_inserts++;
+			}
+		}
+		else if (result != NULL && remembered)
+			hash_search(fallbackCache, &fallbackKey, HASH_REMOVE, NULL);
+	}
+
 	/*
 	 * If ORCA didn't produce a plan, bail out and fall back to the Postgres
 	 * planner.
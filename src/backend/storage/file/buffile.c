@@ -63,6 +63,9 @@
 #define ZSTD_STATIC_LINKING_ONLY
 #include <zstd.h>
 #endif
+#ifdef HAVE_LIBLZ4
+#include <lz4.h>
+#endif
 
 #include "commands/tablespace.h"
 #include "executor/instrument.h"
@@ -121,9 +124,8 @@ struct BufFile
 		BFS_COMPRESSED_READING
 	} state;
 
-	/* ZStandard compression support */
-#ifdef HAVE_LIBZSTD
-	zstd_context *zstd_context;	/* ZStandard library handles. */
+	/* Compression support */
+	int			compression_type;	/* WORKFILE_COMPRESSION_* */
 
 	/*
 	 * During compression, tracks of the original, uncompressed size. (maxoffset
@@ -131,12 +133,24 @@ struct BufFile
 	 */
 	size_t		uncompressed_bytes;
 
+	/* Memory usage by the compression buffers */
+	size_t      compressed_buffer_size;
+
+	/* ZStandard compression support */
+#ifdef HAVE_LIBZSTD
+	zstd_context *zstd_context;	/* ZStandard library handles. */
+
 	/* This holds holds compressed input, during decompression. */
 	ZSTD_inBuffer compressed_buffer;
 	bool		decompression_finished;
+#endif
 
-	/* Memory usage by ZSTD compression buffer */
-	size_t      compressed_buffer_size;
+	/*
+	 * LZ4 compression support. The data is staged in 'buffer' and written
+	 * as frames of up to BLCKSZ bytes, see BufFileDumpLz4Frame().
+	 */
+#ifdef HAVE_LIBLZ4
+	char	   *lz4_frame;		/* compressed frame, during decompression */
 #endif
 
 	/*
@@ -164,6 +178,16 @@ static void BufFileDumpCompressedBuffer(BufFile *file, const void *buffer, Size
 static void BufFileEndCompression(BufFile *file);
 static int BufFileLoadCompressedBuffer(BufFile *file, void *buffer, size_t bufsize);
 
+static void BufFileStartZstdCompression(BufFile *file);
+static void BufFileDumpZstdBuffer(BufFile *file, const void *buffer, Size nbytes);
+static void BufFileEndZstdCompression(BufFile *file);
+static int BufFileLoadZstdBuffer(BufFile *file, void *buffer, size_t bufsize);
+
+static void BufFileStartLz4Compression(BufFile *file);
+static void BufFileDumpLz4Buffer(BufFile *file, const void *buffer, Size nbytes);
+static void BufFileEndLz4Compression(BufFile *file);
+static int BufFileLoadLz4Buffer(BufFile *file, void *buffer, size_t bufsize);
+
 #ifdef HAVE_LIBZSTD
 static void *customAlloc(void *opaque, size_t size);
 static void customFree(void *opaque, void *address);
@@ -194,9 +218,7 @@ makeBufFile(File firstfile)
 	file->maxoffset = 0L;
 	file->buffer = palloc(BLCKSZ);
 
-#ifdef HAVE_LIBZSTD
 	file->compressed_buffer_size = 0;
-#endif
 
 	return file;
 }
@@ -390,6 +412,10 @@ BufFileClose(BufFile *file)
 	if (file->zstd_context)
 		zstd_free_context(file->zstd_context);
 #endif
+#ifdef HAVE_LIBLZ4
+	if (file->lz4_frame)
+		pfree(file->lz4_frame);
+#endif
 
 	pfree(file);
 }
@@ -910,12 +936,7 @@ BufFileGetSize(BufFile *buffile)
 			break;
 		case BFS_COMPRESSED_WRITING:
 		case BFS_COMPRESSED_READING:
-#ifdef HAVE_LIBZSTD
 			return buffile->uncompressed_bytes;
-#else
-			Assert(false);
-			break;
-#endif
 	}
 
 	BufFileUpdateSize(buffile);
@@ -977,10 +998,11 @@ BufFileResume(BufFile *buffile)
 
 
 /*
- * ZStandard Compression support
+ * Compression support
  */
 
 bool gp_workfile_compression;		/* GUC */
+int			gp_workfile_compression_type = WORKFILE_COMPRESSION_DEFAULT;	/* GUC */
 
 /*
  * BufFilePledgeSequential
@@ -1031,6 +1053,50 @@ BufFilePledgeSequential(BufFile *buffile)
 	}
 }
 
+/*
+ * Initialize the compressor chosen by gp_workfile_compression_type.
+ */
+static void
+BufFileStartCompression(BufFile *file)
+{
+	file->compression_type = gp_workfile_compression_type;
+
+	if (file->compression_type == WORKFILE_COMPRESSION_LZ4)
+		BufFileStartLz4Compression(file);
+	else
+		BufFileStartZstdCompression(file);
+}
+
+static void
+BufFileDumpCompressedBuffer(BufFile *file, const void *buffer, Size nbytes)
+{
+	if (file->compression_type == WORKFILE_COMPRESSION_LZ4)
+		BufFileDumpLz4Buffer(file, buffer, nbytes);
+	else
+		BufFileDumpZstdBuffer(file, buffer, nbytes);
+}
+
+/*
+ * End compression stage. Rewind and prepare the BufFile for decompression.
+ */
+static void
+BufFileEndCompression(BufFile *file)
+{
+	if (file->compression_type == WORKFILE_COMPRESSION_LZ4)
+		BufFileEndLz4Compression(file);
+	else
+		BufFileEndZstdCompression(file);
+}
+
+static int
+BufFileLoadCompressedBuffer(BufFile *file, void *buffer, size_t bufsize)
+{
+	if (file->compression_type == WORKFILE_COMPRESSION_LZ4)
+		return BufFileLoadLz4Buffer(file, buffer, bufsize);
+	else
+		return BufFileLoadZstdBuffer(file, buffer, bufsize);
+}
+
 /*
  * The rest of the code is only needed when compression support is compiled in.
  */
@@ -1060,7 +1126,7 @@ static char *compression_buffer;
  * Initialize the compressor.
  */
 static void
-BufFileStartCompression(BufFile *file)
+BufFileStartZstdCompression(BufFile *file)
 {
 	ResourceOwner oldowner;
 	size_t ret;
@@ -1107,7 +1173,7 @@ BufFileStartCompression(BufFile *file)
 }
 
 static void
-BufFileDumpCompressedBuffer(BufFile *file, const void *buffer, Size nbytes)
+BufFileDumpZstdBuffer(BufFile *file, const void *buffer, Size nbytes)
 {
 	ZSTD_inBuffer input;
 	size_t compressed_buffer_size = 0;
@@ -1171,11 +1237,8 @@ BufFileDumpCompressedBuffer(BufFile *file, const void *buffer, Size nbytes)
 	file->compressed_buffer_size = compressed_buffer_size;
 }
 
-/*
- * End compression stage. Rewind and prepare the BufFile for decompression.
- */
 static void
-BufFileEndCompression(BufFile *file)
+BufFileEndZstdCompression(BufFile *file)
 {
 	ZSTD_outBuffer output;
 	size_t		ret;
@@ -1227,7 +1290,7 @@ BufFileEndCompression(BufFile *file)
 }
 
 static int
-BufFileLoadCompressedBuffer(BufFile *file, void *buffer, size_t bufsize)
+BufFileLoadZstdBuffer(BufFile *file, void *buffer, size_t bufsize)
 {
 	ZSTD_outBuffer output;
 	size_t		ret;
@@ -1290,34 +1353,247 @@ BufFileLoadCompressedBuffer(BufFile *file, void *buffer, size_t bufsize)
 
 /*
  * Dummy versions of the compression functions, when the server is built
- * without libzstd. gp_workfile_compression cannot be enabled without
- * libzstd - there's a GUC assign hook to check that - so these should
+ * without libzstd. gp_workfile_compression_type cannot be set to zstd
+ * without libzstd - there's a GUC check hook for that - so these should
  * never be called. They exists just to avoid having so many #ifdefs in
  * the code.
  */
 static void
-BufFileStartCompression(BufFile *file)
+BufFileStartZstdCompression(BufFile *file)
 {
 	elog(ERROR, "zstandard compression not supported by this build");
 }
 static void
-BufFileDumpCompressedBuffer(BufFile *file, const void *buffer, Size nbytes)
+BufFileDumpZstdBuffer(BufFile *file, const void *buffer, Size nbytes)
 {
 	elog(ERROR, "zstandard compression not supported by this build");
 }
 static void
-BufFileEndCompression(BufFile *file)
+BufFileEndZstdCompression(BufFile *file)
 {
 	elog(ERROR, "zstandard compression not supported by this build");
 }
 static int
-BufFileLoadCompressedBuffer(BufFile *file, void *buffer, size_t bufsize)
+BufFileLoadZstdBuffer(BufFile *file, void *buffer, size_t bufsize)
 {
 	elog(ERROR, "zstandard compression not supported by this build");
 }
 
 #endif		/* HAVE_ZSTD */
 
+#ifdef HAVE_LIBLZ4
+
+/*
+ * An LZ4-compressed BufFile is a sequence of frames. Each frame is a
+ * header followed by up to BLCKSZ bytes of data compressed as one LZ4
+ * block. The data is staged in the BufFile's own buffer, so the only extra
+ * memory is a compression state and one frame, shared by all files.
+ */
+typedef struct BufFileLz4FrameHeader
+{
+	uint32		rawlen;			/* uncompressed length */
+	uint32		complen;		/* compressed length */
+} BufFileLz4FrameHeader;
+
+#define BUFFILE_LZ4_FRAME_SIZE \
+	(sizeof(BufFileLz4FrameHeader) + LZ4_COMPRESSBOUND(BLCKSZ))
+
+/* Compression state and output frame, used only within the functions */
+static void *lz4_state;
+static char *lz4_compression_frame;
+
+static void
+BufFileStartLz4Compression(BufFile *file)
+{
+	if (lz4_state == NULL)
+		lz4_state = MemoryContextAlloc(TopMemoryContext, LZ4_sizeofState());
+	if (lz4_compression_frame == NULL)
+		lz4_compression_frame = MemoryContextAlloc(TopMemoryContext,
+												   BUFFILE_LZ4_FRAME_SIZE);
+
+	/* Unlike with zstd, the BufFile's own buffer holds the staged data. */
+	if (file->buffer == NULL)
+		file->buffer = palloc(BLCKSZ);
+	file->pos = 0;
+	file->nbytes = 0;
+
+	/* The frame buffer for reading is all the memory this file adds. */
+	file->compressed_buffer_size = BUFFILE_LZ4_FRAME_SIZE;
+	file->work_set->compression_buf_total += file->compressed_buffer_size;
+
+	file->state = BFS_COMPRESSED_WRITING;
+}
+
+/*
+ * Compress the staged data as one frame, and write it out.
+ */
+static void
+BufFileDumpLz4Frame(BufFile *file)
+{
+	BufFileLz4FrameHeader *hdr = (BufFileLz4FrameHeader *) lz4_compression_frame;
+	char	   *data = lz4_compression_frame + sizeof(BufFileLz4FrameHeader);
+	int			complen;
+	int			framelen;
+	int			wrote;
+
+	Assert(file->pos > 0 && file->pos <= BLCKSZ);
+
+	complen = LZ4_compress_fast_extState(lz4_state,
+										 file->buffer, data,
+										 (int) file->pos,
+										 LZ4_COMPRESSBOUND(BLCKSZ),
+										 1);
+	if (complen <= 0)
+		elog(ERROR, "lz4 compression of temporary file failed");
+
+	hdr->rawlen = (uint32) file->pos;
+	hdr->complen = (uint32) complen;
+	framelen = sizeof(BufFileLz4FrameHeader) + complen;
+
+	wrote = FileWrite(file->file, lz4_compression_frame, framelen);
+	if (wrote != framelen)
+		elog(ERROR, "could not write %d bytes to compressed temporary file: %m", framelen);
+	file->maxoffset += wrote;
+
+	file->pos = 0;
+}
+
+static void
+BufFileDumpLz4Buffer(BufFile *file, const void *buffer, Size nbytes)
+{
+	const char *src = (const char *) buffer;
+
+	file->uncompressed_bytes += nbytes;
+
+	while (nbytes > 0)
+	{
+		Size		nthistime = BLCKSZ - file->pos;
+
+		if (nthistime > nbytes)
+			nthistime = nbytes;
+
+		memcpy(file->buffer + file->pos, src, nthistime);
+		file->pos += nthistime;
+		src += nthistime;
+		nbytes -= nthistime;
+
+		if (file->pos == BLCKSZ)
+			BufFileDumpLz4Frame(file);
+	}
+}
+
+static void
+BufFileEndLz4Compression(BufFile *file)
+{
+	Assert(file->state == BFS_COMPRESSED_WRITING);
+
+	if (file->pos > 0)
+		BufFileDumpLz4Frame(file);
+
+	/* Done writing. Initialize for reading */
+	file->lz4_frame = palloc(BUFFILE_LZ4_FRAME_SIZE);
+	file->pos = 0;
+	file->nbytes = 0;
+	file->offset = 0;
+	file->state = BFS_COMPRESSED_READING;
+
+	if (FileSeek(file->file, 0, SEEK_SET) != 0)
+		elog(ERROR, "could not seek in temporary file: %m");
+}
+
+/*
+ * Read and decompress the next frame into the BufFile's buffer. Returns
+ * false at the end of the file.
+ */
+static bool
+BufFileLoadLz4Frame(BufFile *file)
+{
+	BufFileLz4FrameHeader hdr;
+	int			nb;
+	int			rawlen;
+
+	nb = FileRead(file->file, (char *) &hdr, sizeof(hdr));
+	if (nb < 0)
+		elog(ERROR, "could not read from temporary file: %m");
+	if (nb == 0)
+		return false;
+	if (nb != sizeof(hdr) ||
+		hdr.rawlen == 0 || hdr.rawlen > BLCKSZ ||
+		hdr.complen == 0 || hdr.complen > LZ4_COMPRESSBOUND(BLCKSZ))
+		elog(ERROR, "unexpected end of compressed temporary file");
+
+	nb = FileRead(file->file, file->lz4_frame, hdr.complen);
+	if (nb < 0)
+		elog(ERROR, "could not read from temporary file: %m");
+	if (nb != hdr.complen)
+		elog(ERROR, "unexpected end of compressed temporary file");
+
+	rawlen = LZ4_decompress_safe(file->lz4_frame, file->buffer,
+								 (int) hdr.complen, BLCKSZ);
+	if (rawlen != hdr.rawlen)
+		elog(ERROR, "lz4 decompression of temporary file failed");
+
+	file->pos = 0;
+	file->nbytes = rawlen;
+
+	return true;
+}
+
+static int
+BufFileLoadLz4Buffer(BufFile *file, void *buffer, size_t bufsize)
+{
+	char	   *dst = (char *) buffer;
+	size_t		nread = 0;
+
+	while (nread < bufsize)
+	{
+		size_t		nthistime;
+
+		if (file->pos >= file->nbytes && !BufFileLoadLz4Frame(file))
+			break;
+
+		nthistime = file->nbytes - file->pos;
+		if (nthistime > bufsize - nread)
+			nthistime = bufsize - nread;
+
+		memcpy(dst + nread, file->buffer + file->pos, nthistime);
+		file->pos += nthistime;
+		nread += nthistime;
+	}
+
+	return nread;
+}
+
+#else		/* HAVE_LIBLZ4 */
+
+/*
+ * Dummy versions of the LZ4 compression functions, when the server is
+ * built without liblz4. gp_workfile_compression_type cannot be set to lz4
+ * without liblz4, so these should never be called.
+ */
+static void
+BufFileStartLz4Compression(BufFile *file)
+{
+	elog(ERROR, "lz4 compression not supported by this build");
+}
+static void
+BufFileDumpLz4Buffer(BufFile *file, const void *buffer, Size nbytes)
+{
+	elog(ERROR, "lz4 compression not supported by this build");
+}
+static void
+BufFileEndLz4Compression(BufFile *file)
+{
+	elog(ERROR, "lz4 compression not supported by this build");
+}
+static int
+BufFileLoadLz4Buffer(BufFile *file, void *buffer, size_t bufsize)
+{
+	elog(ERROR, "lz4 compression not supported by this build");
+}
+
+#endif		/* HAVE_LIBLZ4 */
+
 void
 SetForceDefaultTableSpaceVal(bool val)
 {
@@ -16,6 +16,7 @@
  */
 #include "postgres.h"
 
+#include "access/appendonly_zonemap.h"
 #include "access/htup_details.h"
 #include "access/reloptions.h"
 #include "access/twophase.h"
@@ -1260,6 +1261,15 @@ ProcessUtilitySlow(Node *parsetree,
 															cstmt->is_part_child,
 															cstmt->is_part_parent);
 
+								/*
+								 * Zone maps are kept in the block directory,
+								 * so create it right away if they are to be
+								 * maintained. The flag is dispatched to the
+								 * QEs along with the statement.
+								 */
+								if (Gp_role != GP_ROLE_EXECUTE && gp_appendonly_zone_maps)
+									cstmt->buildAoBlkdir = true;
+
 								if (cstmt->buildAoBlkdir)
 									AlterTableCreateAoBlkdirTable(relOid,
 																   cstmt->is_part_child,
@@ -8,12 +8,17 @@
  *
  * gp_opt_version: This function wraps LibraryVersion. 
  *
+ * gp_opt_mdcache_stats: This function wraps MDCacheStats.
+ *
+ * gp_opt_fallback_cache_stats: This function wraps OptimizerFallbackCacheStats.
+ *
  * Copyright(c) 2012 - present, EMC/Greenplum
  */
 
 #include "postgres.h"
 
 #include "funcapi.h"
+#include "optimizer/orca.h"
 #include "utils/builtins.h"
 
 extern Datum EnableXform(PG_FUNCTION_ARGS);
@@ -60,3 +65,32 @@ gp_opt_version(PG_FUNCTION_ARGS __attribute__((unused)))
 	return CStringGetTextDatum("Server has been compiled without ORCA");
 #endif
 }
+
+extern Datum MDCacheStats();
+
+/*
+* Returns the statistics of the optimizer's metadata cache.
+*/
+Datum
+gp_opt_mdcache_stats(PG_FUNCTION_ARGS __attribute__((unused)))
+{
+#ifdef USE_ORCA
+	return MDCacheStats();
+#else
+	return CStringGetTextDatum("Server has been compiled without ORCA");
+#endif
+}
+
+/*
+* Returns the statistics of the cache of statements that fell back to the
+* Postgres planner.
+*/
+Datum
+gp_opt_fallback_cache_stats(PG_FUNCTION_ARGS __attribute__((unused)))
+{
+#ifdef USE_ORCA
+	return OptimizerFallbackCacheStats();
+#else
+	return CStringGetTextDatum("Server has been compiled without ORCA");
+#endif
+}
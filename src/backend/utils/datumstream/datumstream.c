@@ -20,6 +20,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 
+#include "access/nbtree.h"
 #include "access/tupmacs.h"
 #include "access/tuptoaster.h"
 
@@ -41,6 +42,8 @@ typedef enum AOCSBK
 	AOCSBK_BLOB,
 }	AOCSBK;
 
+bool		gp_aocs_dictionary_encoding = false;
+
 
 static void
 datumstreamread_check_large_varlena_integrity(
@@ -533,6 +536,21 @@ create_datumstreamwrite(
 						  maxsz,
 						  attr);
 
+	/*
+	 * Dictionary encode the blocks of compressed variable-length columns,
+	 * with RLE_TYPE or a generic compression type alike.  They are written
+	 * in the Dense_Dictionary format, whose datum area can carry the
+	 * dictionary, and whose version tells the readers to look for it.
+	 * Whether a block is actually encoded depends on its number of distinct
+	 * values.
+	 */
+	acc->dict_want_encoding = (gp_aocs_dictionary_encoding &&
+							   (acc->rle_want_compression ||
+								acc->ao_attr.compress) &&
+							   acc->typeInfo.datumlen == -1);
+	if (acc->dict_want_encoding)
+		acc->datumStreamVersion = DatumStreamVersion_Dense_Dictionary;
+
 	compressionFunctions = NULL;
 	compressionState = NULL;
 	verifyBlockCompressionState = NULL;
@@ -603,6 +621,7 @@ create_datumstreamwrite(
 
 		case DatumStreamVersion_Dense:
 		case DatumStreamVersion_Dense_Enhanced:
+		case DatumStreamVersion_Dense_Dictionary:
 			initialMaxDatumPerBlock = INITIALDATUM_PER_AOCS_DENSE_BLOCK;
 			maxDatumPerBlock = MAXDATUM_PER_AOCS_DENSE_BLOCK;
 
@@ -629,6 +648,7 @@ create_datumstreamwrite(
 							   acc->datumStreamVersion,
 							   acc->rle_want_compression,
 							   acc->delta_want_compression,
+							   acc->dict_want_encoding,
 							   initialMaxDatumPerBlock,
 							   maxDatumPerBlock,
 							   acc->maxAoBlockSize - acc->maxAoHeaderSize,
@@ -1001,6 +1021,7 @@ datumstreamwrite_block(DatumStreamWrite *acc,
 
 		case DatumStreamVersion_Dense:
 		case DatumStreamVersion_Dense_Enhanced:
+		case DatumStreamVersion_Dense_Dictionary:
 			writesz = datumstreamwrite_block_dense(acc);
 			break;
 
@@ -1012,13 +1033,25 @@ datumstreamwrite_block(DatumStreamWrite *acc,
 	}
 
 	/* Insert an entry to the block directory */
-	AppendOnlyBlockDirectory_InsertEntry(
-		blockDirectory,
-		columnGroupNo,
-		acc->blockFirstRowNum,
-		AppendOnlyStorageWrite_LogicalBlockStartOffset(&acc->ao_write),
-		itemCount,
-		addColAction);
+	if (addColAction)
+		AppendOnlyBlockDirectory_InsertEntry(
+			blockDirectory,
+			columnGroupNo,
+			acc->blockFirstRowNum,
+			AppendOnlyStorageWrite_LogicalBlockStartOffset(&acc->ao_write),
+			itemCount,
+			addColAction);
+	else
+		AppendOnlyBlockDirectory_InsertEntryWithZoneMap(
+			blockDirectory,
+			columnGroupNo,
+			acc->blockFirstRowNum,
+			AppendOnlyStorageWrite_LogicalBlockStartOffset(&acc->ao_write),
+			itemCount,
+			acc->zoneMapBuilder);
+
+	if (acc->zoneMapBuilder)
+		AppendOnlyZoneMapBuilder_Reset(acc->zoneMapBuilder);
 
 	return writesz;
 }
@@ -1045,7 +1078,8 @@ datumstreamwrite_lob(DatumStreamWrite * acc,
 	Assert(acc);
 	Assert(acc->datumStreamVersion == DatumStreamVersion_Original ||
 		   acc->datumStreamVersion == DatumStreamVersion_Dense ||
-		   acc->datumStreamVersion == DatumStreamVersion_Dense_Enhanced);
+		   acc->datumStreamVersion == DatumStreamVersion_Dense_Enhanced ||
+		   acc->datumStreamVersion == DatumStreamVersion_Dense_Dictionary);
 
 	if (acc->typeInfo.datumlen >= 0)
 	{
@@ -1144,6 +1178,73 @@ datumstreamread_block_info(DatumStreamRead * acc)
 	return true;
 }
 
+/*
+ * Evaluate the dictionary scan keys on every value of the dictionary of the
+ * current block.
+ */
+static void
+datumstreamread_eval_dictionary_keys(DatumStreamRead * acc)
+{
+	DatumStreamBlockRead *dsr = &acc->blockRead;
+	int			code;
+
+	if (dsr->dict_match == NULL)
+		dsr->dict_match = (bool *)
+			MemoryContextAlloc(acc->memctxt,
+							   DATUMSTREAM_DICTIONARY_MAX_ENTRIES * sizeof(bool));
+
+	dsr->dict_match_count = 0;
+	for (code = 0; code < dsr->dict_count; code++)
+	{
+		Datum		value = PointerGetDatum(dsr->dict_entries[code]);
+		bool		match = true;
+		int			keyNo;
+
+		for (keyNo = 0; keyNo < acc->num_dict_keys && match; keyNo++)
+		{
+			DatumStreamDictionaryKey *key = &acc->dict_keys[keyNo];
+			int			i;
+
+			match = false;
+			for (i = 0; i < key->nvalues && !match; i++)
+			{
+				int32		cmp;
+
+				cmp = DatumGetInt32(FunctionCall2Coll(&key->cmpProc,
+													  key->collation,
+													  value,
+													  key->values[i]));
+				switch (key->strategy)
+				{
+					case BTLessStrategyNumber:
+						match = (cmp < 0);
+						break;
+					case BTLessEqualStrategyNumber:
+						match = (cmp <= 0);
+						break;
+					case BTEqualStrategyNumber:
+						match = (cmp == 0);
+						break;
+					case BTGreaterEqualStrategyNumber:
+						match = (cmp >= 0);
+						break;
+					case BTGreaterStrategyNumber:
+						match = (cmp > 0);
+						break;
+					default:
+						elog(ERROR, "unrecognized dictionary scan key strategy: %d",
+							 key->strategy);
+				}
+			}
+		}
+
+		dsr->dict_match[code] = match;
+		if (match)
+			dsr->dict_match_count++;
+	}
+	dsr->dict_filter = true;
+}
+
 static void
 datumstreamread_block_get_ready(DatumStreamRead * acc)
 {
@@ -1167,6 +1268,9 @@ datumstreamread_block_get_ready(DatumStreamRead * acc)
 		{
 			acc->blockRowCount = adjustedRowCount;
 		}
+
+		if (acc->num_dict_keys > 0 && acc->blockRead.dict_block_was_encoded)
+			datumstreamread_eval_dictionary_keys(acc);
 	}
 	else if (acc->getBlockInfo.execBlockKind == AOCSBK_BLOB)
 	{
@@ -1380,6 +1484,82 @@ datumstreamread_block(DatumStreamRead * acc,
 	return 0;
 }
 
+/*
+ * Skip the rows of the segment file up to and including lastRowNum, which
+ * must not be before the current row. The blocks that only contain skipped
+ * rows are not read in. After this, datumstreamread_advance() or
+ * datumstreamread_block() moves to the first row after lastRowNum.
+ *
+ * Returns -1 if the end of the segment file was reached, otherwise the number
+ * of blocks that were skipped without being read in.
+ */
+int
+datumstreamread_skip_rows(DatumStreamRead * acc, int64 lastRowNum)
+{
+	int			nskipped = 0;
+
+	Assert(acc);
+
+	/* Is the target row in the current block? */
+	if (acc->blockFirstRowNum + acc->blockRowCount - 1 > lastRowNum)
+	{
+		datumstreamread_find(acc, (int32) (lastRowNum - acc->blockFirstRowNum));
+		return 0;
+	}
+
+	while (true)
+	{
+		acc->blockFirstRowNum += acc->blockRowCount;
+
+		if (!AppendOnlyStorageRead_GetBlockInfo(&acc->ao_read,
+												&acc->getBlockInfo.contentLen,
+												&acc->getBlockInfo.execBlockKind,
+												&acc->getBlockInfo.firstRow,
+												&acc->getBlockInfo.rowCnt,
+												&acc->getBlockInfo.isLarge,
+												&acc->getBlockInfo.isCompressed))
+			return -1;
+
+		/* See datumstreamread_block() */
+		if (acc->getBlockInfo.firstRow >= 0)
+		{
+			acc->blockFirstRowNum = acc->getBlockInfo.firstRow;
+		}
+		acc->blockFileOffset = acc->ao_read.current.headerOffsetInFile;
+		acc->blockRowCount = acc->getBlockInfo.rowCnt;
+
+		if (acc->blockFirstRowNum + acc->blockRowCount - 1 <= lastRowNum)
+		{
+			AppendOnlyStorageRead_SkipCurrentBlock(&acc->ao_read);
+			nskipped++;
+			continue;
+		}
+
+		datumstreamread_block_content(acc);
+
+		if (acc->blockFirstRowNum <= lastRowNum)
+			datumstreamread_find(acc, (int32) (lastRowNum - acc->blockFirstRowNum));
+
+		return nskipped;
+	}
+}
+
+/*
+ * Set the dictionary scan keys of the datum stream.  For the rows of the
+ * dictionary encoded blocks, the keys are evaluated only once per distinct
+ * value of the block; datumstreamread_dictionary_excludes_row() and
+ * datumstreamread_dictionary_excludes_block() then tell the rows that do
+ * not satisfy all of them.  Must be called before the first block is read.
+ */
+void
+datumstreamread_set_dictionary_keys(DatumStreamRead * datumStream,
+									int nkeys,
+									DatumStreamDictionaryKey *keys)
+{
+	datumStream->num_dict_keys = nkeys;
+	datumStream->dict_keys = keys;
+}
+
 void
 datumstreamread_rewind_block(DatumStreamRead * datumStream)
 {
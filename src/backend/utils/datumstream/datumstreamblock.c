@@ -13,6 +13,7 @@
  */
 
 #include "postgres.h"
+#include "access/hash.h"
 #include "access/tupmacs.h"
 #include "access/tuptoaster.h"
 #include "utils/datumstreamblock.h"
@@ -357,6 +358,7 @@ DatumStreamBlockRead_Init(
 	memcpy(&dsr->typeInfo, typeInfo, sizeof(DatumStreamTypeInfo));
 
 	dsr->datumStreamVersion = datumStreamVersion;
+	dsr->columnDatumStreamVersion = datumStreamVersion;
 
 	dsr->rle_can_have_compression = rle_can_have_compression;
 
@@ -397,13 +399,26 @@ DatumStreamBlockRead_Init(
 	Assert(dsr->delta_block_was_compressed == false);
 	Assert(dsr->delta_item == false);
 
+	Assert(!dsr->dict_block_was_encoded);
+	Assert(dsr->dict_entries == NULL);
+	Assert(dsr->dict_match == NULL);
 }
 
 void
 DatumStreamBlockRead_Finish(
 							DatumStreamBlockRead * dsr)
 {
-	/* Place holder. */
+	if (dsr->dict_entries != NULL)
+	{
+		pfree(dsr->dict_entries);
+		dsr->dict_entries = NULL;
+	}
+
+	if (dsr->dict_match != NULL)
+	{
+		pfree(dsr->dict_match);
+		dsr->dict_match = NULL;
+	}
 }
 
 /*
@@ -609,6 +624,69 @@ DatumStreamBlockRead_ResetDense(DatumStreamBlockRead * dsr)
 
 	dsr->delta_block_was_compressed = false;
 	dsr->delta_item = false;
+
+	dsr->dict_block_was_encoded = false;
+	dsr->dict_count = 0;
+	dsr->dict_codesp = NULL;
+	dsr->dict_filter = false;
+	dsr->dict_match_count = 0;
+}
+
+/*
+ * Set up the dictionary of a dictionary encoded Dense block, and position
+ * the reader to the value of the first physical datum.
+ */
+static void
+DatumStreamBlockRead_GetReadyDictionary(DatumStreamBlockRead * dsr)
+{
+	DatumStreamBlock_Dictionary *dictionary;
+	uint8	   *p;
+	int			i;
+
+	Assert(dsr->typeInfo.datumlen == -1);
+	Assert(dsr->physical_datum_count > 0);
+
+	if (dsr->dict_entries == NULL)
+		dsr->dict_entries = (uint8 **)
+			MemoryContextAlloc(dsr->memctxt,
+							   DATUMSTREAM_DICTIONARY_MAX_ENTRIES * sizeof(uint8 *));
+
+	dictionary = (DatumStreamBlock_Dictionary *) dsr->datum_beginp;
+	dsr->dict_count = dictionary->dictionary_count;
+
+	/*
+	 * The values are laid out like those of a datum area without dictionary
+	 * encoding, so skip the zero padding in front of the aligned ones.
+	 */
+	p = dsr->datum_beginp + sizeof(DatumStreamBlock_Dictionary);
+	for (i = 0; i < dsr->dict_count; i++)
+	{
+		if (*p == 0)
+			p = (uint8 *) att_align_nominal(p, dsr->typeInfo.align);
+
+		dsr->dict_entries[i] = p;
+		p += VARSIZE_ANY(p);
+	}
+
+	dsr->dict_codesp = dsr->datum_beginp + sizeof(DatumStreamBlock_Dictionary) +
+		dictionary->dictionary_size;
+	Assert(p == dsr->dict_codesp);
+
+	dsr->datump = dsr->dict_entries[dsr->dict_codesp[0]];
+
+#ifdef USE_ASSERT_CHECKING
+	if (Debug_appendonly_print_scan)
+	{
+		ereport(LOG,
+				(errmsg("Datum stream block read unpack Dense with dictionary encoding "
+						"(physical datum count %d, dictionary count %d, dictionary size %d)",
+						dsr->physical_datum_count,
+						dsr->dict_count,
+						dictionary->dictionary_size),
+				 errdetail_datumstreamblockread(dsr),
+				 errcontext_datumstreamblockread(dsr)));
+	}
+#endif
 }
 
 void
@@ -942,7 +1020,14 @@ DatumStreamBlockRead_GetReadyDense(
 					 errcontext_datumstreamblockread(dsr)));
 		}
 	}
-	dsr->datump = dsr->datum_beginp;
+
+	dsr->dict_block_was_encoded =
+		(blockDense->orig_4_bytes.version == DatumStreamVersion_Dense_Dictionary &&
+		 (blockDense->orig_4_bytes.flags & DSB_HAS_DICTIONARY_ENCODING) != 0);
+	if (dsr->dict_block_was_encoded)
+		DatumStreamBlockRead_GetReadyDictionary(dsr);
+	else
+		dsr->datump = dsr->datum_beginp;
 }
 
 static int
@@ -3525,6 +3610,7 @@ DatumStreamBlockWrite_Put(
 
 		case DatumStreamVersion_Dense:
 		case DatumStreamVersion_Dense_Enhanced:
+		case DatumStreamVersion_Dense_Dictionary:
 			{
 				int			result;
 
@@ -3588,6 +3674,7 @@ DatumStreamBlockWrite_GetReady(
 
 		case DatumStreamVersion_Dense:
 		case DatumStreamVersion_Dense_Enhanced:
+		case DatumStreamVersion_Dense_Dictionary:
 			dsw->datump = dsw->datum_buffer;
 
 			if (dsw->rle_want_compression)
@@ -3763,6 +3850,143 @@ DatumStreamBlockWrite_BlockOrig(
 	return writesz;
 }
 
+/* Open addressing hash table of the dictionary values, a power of 2 */
+#define DICTIONARY_HASH_SLOTS (2 * DATUMSTREAM_DICTIONARY_MAX_ENTRIES)
+
+/*
+ * Dictionary encode the variable-length datum area of the block, into
+ * dict_buffer.  See DatumStreamBlock_Dictionary for the format.
+ *
+ * Returns the size of the encoded datum area, or 0 if the block has too many
+ * distinct values, or the encoding would not make the datum area smaller.
+ */
+static int32
+DatumStreamBlockWrite_DictionaryEncode(
+									   DatumStreamBlockWrite * dsw)
+{
+	uint8	   *entries[DATUMSTREAM_DICTIONARY_MAX_ENTRIES];
+	int32		entrySizes[DATUMSTREAM_DICTIONARY_MAX_ENTRIES];
+	int16		slots[DICTIONARY_HASH_SLOTS];
+	DatumStreamBlock_Dictionary dictionary;
+	int32		dataSize;
+	int32		encodedSize;
+	int32		count;
+	uint8	   *datump;
+	uint8	   *codes;
+	uint8	   *p;
+	int			i;
+
+	Assert(dsw->typeInfo->datumlen == -1);
+
+	dataSize = dsw->datump - dsw->datum_buffer;
+
+	/*
+	 * Even a single distinct value needs the dictionary header and a byte
+	 * per physical datum.
+	 */
+	if (dsw->physical_datum_count == 0 ||
+		(int32) sizeof(DatumStreamBlock_Dictionary) + dsw->physical_datum_count >= dataSize)
+		return 0;
+
+	/*
+	 * Assign the codes, walking the datum area the way the reader does.  The
+	 * codes are put at the beginning of the output buffer for now, and moved
+	 * after the dictionary once its size is known.
+	 */
+	memset(slots, -1, sizeof(slots));
+	codes = dsw->dict_buffer;
+	count = 0;
+	datump = dsw->datum_buffer;
+	for (i = 0; i < dsw->physical_datum_count; i++)
+	{
+		int32		itemSize;
+		uint32		slot;
+
+		if (*datump == 0)
+			datump = (uint8 *) att_align_nominal(datump, dsw->typeInfo->align);
+		itemSize = VARSIZE_ANY(datump);
+
+		slot = DatumGetUInt32(hash_any(datump, itemSize)) & (DICTIONARY_HASH_SLOTS - 1);
+		while (slots[slot] >= 0)
+		{
+			int			entry = slots[slot];
+
+			if (entrySizes[entry] == itemSize &&
+				memcmp(entries[entry], datump, itemSize) == 0)
+				break;
+			slot = (slot + 1) & (DICTIONARY_HASH_SLOTS - 1);
+		}
+
+		if (slots[slot] < 0)
+		{
+			if (count == DATUMSTREAM_DICTIONARY_MAX_ENTRIES)
+				return 0;
+
+			entries[count] = datump;
+			entrySizes[count] = itemSize;
+			slots[slot] = count++;
+		}
+
+		codes[i] = (uint8) slots[slot];
+		datump += itemSize;
+	}
+	Assert(datump == dsw->datump);
+
+	/*
+	 * The dictionary values keep the alignment they had in the datum area,
+	 * so that the reader can return pointers to them.
+	 */
+	dictionary.dictionary_count = count;
+	dictionary.dictionary_size = 0;
+	for (i = 0; i < count; i++)
+	{
+		if (!VARATT_IS_SHORT(entries[i]))
+			dictionary.dictionary_size = att_align_nominal(dictionary.dictionary_size,
+														   dsw->typeInfo->align);
+		dictionary.dictionary_size += entrySizes[i];
+	}
+
+	encodedSize = sizeof(DatumStreamBlock_Dictionary) + dictionary.dictionary_size +
+		dsw->physical_datum_count;
+	if (encodedSize >= dataSize)
+		return 0;
+
+	memmove(dsw->dict_buffer + sizeof(DatumStreamBlock_Dictionary) + dictionary.dictionary_size,
+			codes,
+			dsw->physical_datum_count);
+
+	p = dsw->dict_buffer;
+	memcpy(p, &dictionary, sizeof(DatumStreamBlock_Dictionary));
+	p += sizeof(DatumStreamBlock_Dictionary);
+	for (i = 0; i < count; i++)
+	{
+		if (!VARATT_IS_SHORT(entries[i]))
+			p = (uint8 *) att_align_zero((char *) p, dsw->typeInfo->align);
+		memcpy(p, entries[i], entrySizes[i]);
+		p += entrySizes[i];
+	}
+	Assert(p == dsw->dict_buffer + sizeof(DatumStreamBlock_Dictionary) + dictionary.dictionary_size);
+
+	dsw->savings += dataSize - encodedSize;
+
+	if (Debug_appendonly_print_insert)
+	{
+		ereport(LOG,
+				(errmsg("Datum stream write Dense block dictionary encoded "
+						"(physical datum count %d, dictionary count %d, dictionary size %d, "
+						"physical data size %d, encoded size %d)",
+						dsw->physical_datum_count,
+						dictionary.dictionary_count,
+						dictionary.dictionary_size,
+						dataSize,
+						encodedSize),
+				 errdetail_datumstreamblockwrite(dsw),
+				 errcontext_datumstreamblockwrite(dsw)));
+	}
+
+	return encodedSize;
+}
+
 static int64
 DatumStreamBlockWrite_BlockDense(
 								 DatumStreamBlockWrite * dsw,
@@ -3786,6 +4010,8 @@ DatumStreamBlockWrite_BlockDense(
 	int32		totalDeltasSize;
 	int64		formattedMetadataSize;
 	bool		minimalIntegrityChecks;
+	uint8	   *datumData;
+	int32		dictEncodedSize;
 
 	totalRepeatCountsSize = 0;
 	totalDeltasSize = 0;
@@ -3817,6 +4043,18 @@ DatumStreamBlockWrite_BlockDense(
 	dense.logical_row_count = dsw->nth;
 	dense.physical_datum_count = dsw->physical_datum_count;
 	dense.physical_data_size = dsw->datump - dsw->datum_buffer;
+	datumData = dsw->datum_buffer;
+
+	if (dsw->dict_want_encoding)
+	{
+		dictEncodedSize = DatumStreamBlockWrite_DictionaryEncode(dsw);
+		if (dictEncodedSize > 0)
+		{
+			dense.orig_4_bytes.flags |= DSB_HAS_DICTIONARY_ENCODING;
+			dense.physical_data_size = dictEncodedSize;
+			datumData = dsw->dict_buffer;
+		}
+	}
 
 	headerSize = sizeof(DatumStreamBlock_Dense);
 
@@ -4040,7 +4278,7 @@ DatumStreamBlockWrite_BlockDense(
 				 errcontext_datumstreamblockwrite(dsw)));
 	}
 
-	memcpy(p, dsw->datum_buffer, dense.physical_data_size);
+	memcpy(p, datumData, dense.physical_data_size);
 	p += dense.physical_data_size;
 
 	/* Calculate write size. */
@@ -4214,6 +4452,7 @@ DatumStreamBlockWrite_Block(
 
 		case DatumStreamVersion_Dense:
 		case DatumStreamVersion_Dense_Enhanced:
+		case DatumStreamVersion_Dense_Dictionary:
 			return DatumStreamBlockWrite_BlockDense(dsw, buffer);
 
 		default:
@@ -4234,6 +4473,7 @@ DatumStreamBlockWrite_Init(
 						   DatumStreamVersion datumStreamVersion,
 						   bool rle_want_compression,
 						   bool delta_want_compression,
+						   bool dict_want_encoding,
 						   int32 initialMaxDatumPerBlock,
 						   int32 maxDatumPerBlock,
 						   int32 maxDataBlockSize,
@@ -4250,6 +4490,7 @@ DatumStreamBlockWrite_Init(
 
 	dsw->rle_want_compression = rle_want_compression;
 	dsw->delta_want_compression = delta_want_compression;
+	dsw->dict_want_encoding = dict_want_encoding;
 
 	dsw->initialMaxDatumPerBlock = initialMaxDatumPerBlock;
 	dsw->maxDatumPerBlock = maxDatumPerBlock;
@@ -4306,6 +4547,7 @@ DatumStreamBlockWrite_Init(
 
 		case DatumStreamVersion_Dense:
 		case DatumStreamVersion_Dense_Enhanced:
+		case DatumStreamVersion_Dense_Dictionary:
 			if (Debug_datumstream_write_use_small_initial_buffers)
 			{
 				dsw->null_bitmap_buffer_size = 64;
@@ -4398,6 +4640,17 @@ DatumStreamBlockWrite_Init(
 				Assert(dsw->delta_sign == NULL);
 			}
 
+			if (dsw->dict_want_encoding)
+			{
+				/*
+				 * An encoded datum area is only used if it is smaller than
+				 * the plain one.
+				 */
+				Assert(dsw->typeInfo->datumlen == -1);
+				dsw->dict_buffer_size = dsw->datum_buffer_size;
+				dsw->dict_buffer = palloc(dsw->dict_buffer_size);
+			}
+
 			if (Debug_appendonly_print_insert)
 			{
 				ereport(LOG,
@@ -4481,6 +4734,12 @@ DatumStreamBlockWrite_Finish(
 		dsw->delta_sign = NULL;
 	}
 
+	if (dsw->dict_buffer != NULL)
+	{
+		pfree(dsw->dict_buffer);
+		dsw->dict_buffer = NULL;
+	}
+
 	MemoryContextSwitchTo(oldCtxt);
 }
 
@@ -4897,6 +5156,109 @@ DatumStreamBlock_IntegrityCheckDenseDelta(
 	}
 }
 
+/*
+ * Verify the datum area of a dictionary encoded Dense block.
+ */
+static void
+DatumStreamBlock_IntegrityCheckDictionary(
+										  uint8 * physicalData,
+										  int32 physicalDataSize,
+										  int32 physicalDatumCount,
+										  DatumStreamVersion datumStreamVersion,
+										  DatumStreamTypeInfo * typeInfo,
+							   int (*errdetailCallback) (void *errdetailArg),
+										  void *errdetailArg,
+							 int (*errcontextCallback) (void *errcontextArg),
+										  void *errcontextArg)
+{
+	DatumStreamBlock_Dictionary *dictionary;
+	uint8	   *codes;
+	int32		count;
+	int			i;
+
+	if (typeInfo->datumlen != -1)
+	{
+		ereport(ERROR,
+				(errmsg("Datum stream %s block with dictionary encoding is not of a variable-length type (datum length %d)",
+						DatumStreamVersion_String(datumStreamVersion),
+						typeInfo->datumlen),
+				 errdetailCallback(errdetailArg),
+				 errcontextCallback(errcontextArg)));
+	}
+
+	if (physicalDatumCount <= 0 ||
+		physicalDataSize < (int32) sizeof(DatumStreamBlock_Dictionary) + physicalDatumCount)
+	{
+		ereport(ERROR,
+				(errmsg("Bad datum stream %s block physical data size %d with dictionary encoding (physical datum count %d)",
+						DatumStreamVersion_String(datumStreamVersion),
+						physicalDataSize,
+						physicalDatumCount),
+				 errdetailCallback(errdetailArg),
+				 errcontextCallback(errcontextArg)));
+	}
+
+	dictionary = (DatumStreamBlock_Dictionary *) physicalData;
+
+	if (dictionary->dictionary_count <= 0 ||
+		dictionary->dictionary_count > DATUMSTREAM_DICTIONARY_MAX_ENTRIES ||
+		dictionary->dictionary_size <= 0 ||
+		(int32) sizeof(DatumStreamBlock_Dictionary) + dictionary->dictionary_size + physicalDatumCount != physicalDataSize)
+	{
+		ereport(ERROR,
+				(errmsg("Bad datum stream %s block dictionary (dictionary count %d, dictionary size %d, "
+						"physical datum count %d, physical data size %d)",
+						DatumStreamVersion_String(datumStreamVersion),
+						dictionary->dictionary_count,
+						dictionary->dictionary_size,
+						physicalDatumCount,
+						physicalDataSize),
+				 errdetailCallback(errdetailArg),
+				 errcontextCallback(errcontextArg)));
+	}
+
+	/*
+	 * The dictionary values are laid out like a datum area without
+	 * dictionary encoding.  (The count returned does not include the last
+	 * item.)
+	 */
+	count = DatumStreamBlock_IntegrityCheckVarlena(
+							  physicalData + sizeof(DatumStreamBlock_Dictionary),
+												   dictionary->dictionary_size,
+												   datumStreamVersion,
+												   typeInfo,
+												   errdetailCallback,
+												   errdetailArg,
+												   errcontextCallback,
+												   errcontextArg);
+	if (count + 1 != dictionary->dictionary_count)
+	{
+		ereport(ERROR,
+				(errmsg("Datum stream %s block dictionary item count does not match (found %d, expected %d)",
+						DatumStreamVersion_String(datumStreamVersion),
+						count + 1,
+						dictionary->dictionary_count),
+				 errdetailCallback(errdetailArg),
+				 errcontextCallback(errcontextArg)));
+	}
+
+	codes = physicalData + sizeof(DatumStreamBlock_Dictionary) + dictionary->dictionary_size;
+	for (i = 0; i < physicalDatumCount; i++)
+	{
+		if (codes[i] >= dictionary->dictionary_count)
+		{
+			ereport(ERROR,
+					(errmsg("Datum stream %s block dictionary code %d of physical item index #%d is out of range (dictionary count %d)",
+							DatumStreamVersion_String(datumStreamVersion),
+							codes[i],
+							i,
+							dictionary->dictionary_count),
+					 errdetailCallback(errdetailArg),
+					 errcontextCallback(errcontextArg)));
+		}
+	}
+}
+
 static void
 DatumStreamBlock_IntegrityCheckDense(
 									 uint8 * buffer,
@@ -4919,6 +5281,7 @@ DatumStreamBlock_IntegrityCheckDense(
 	bool		hasNull;
 	bool		hasRleCompression;
 	bool		hasDeltaCompression;
+	bool		hasDictionaryEncoding;
 
 	int32		alignedHeaderSize;
 	int32		deltaOnCount;
@@ -4945,12 +5308,13 @@ DatumStreamBlock_IntegrityCheckDense(
 	p = buffer + headerSize;
 
 	if ((blockDense->orig_4_bytes.version != DatumStreamVersion_Dense) &&
-	 (blockDense->orig_4_bytes.version != DatumStreamVersion_Dense_Enhanced))
+	 (blockDense->orig_4_bytes.version != DatumStreamVersion_Dense_Enhanced) &&
+		(blockDense->orig_4_bytes.version != DatumStreamVersion_Dense_Dictionary))
 	{
 		ereport(ERROR,
 				(errmsg("Bad datum stream Dense block version.  Found %d and expected %d",
 						blockDense->orig_4_bytes.version,
-						DatumStreamVersion_Dense_Enhanced),
+						DatumStreamVersion_Dense_Dictionary),
 				 errdetailCallback(errdetailArg),
 				 errcontextCallback(errcontextArg)));
 	}
@@ -4965,6 +5329,21 @@ DatumStreamBlock_IntegrityCheckDense(
 	hasNull = ((blockDense->orig_4_bytes.flags & DSB_HAS_NULLBITMAP) != 0);
 	hasRleCompression = ((blockDense->orig_4_bytes.flags & DSB_HAS_RLE_COMPRESSION) != 0);
 	hasDeltaCompression = ((blockDense->orig_4_bytes.flags & DSB_HAS_DELTA_COMPRESSION) != 0);
+	hasDictionaryEncoding = ((blockDense->orig_4_bytes.flags & DSB_HAS_DICTIONARY_ENCODING) != 0);
+
+	/*
+	 * Only the Dense_Dictionary version has dictionary encoding.
+	 */
+	if (hasDictionaryEncoding &&
+		blockDense->orig_4_bytes.version != DatumStreamVersion_Dense_Dictionary)
+	{
+		ereport(ERROR,
+				(errmsg("Datum stream Dense block version %d is dictionary encoded, which only version %d can be",
+						blockDense->orig_4_bytes.version,
+						DatumStreamVersion_Dense_Dictionary),
+				 errdetailCallback(errdetailArg),
+				 errcontextCallback(errcontextArg)));
+	}
 
 	/*
 	 * Verify logical row count.
@@ -5453,7 +5832,20 @@ DatumStreamBlock_IntegrityCheckDense(
 												  errcontextArg);
 	}
 
-	if (typeInfo->datumlen == -1)
+	if (hasDictionaryEncoding)
+	{
+		DatumStreamBlock_IntegrityCheckDictionary(
+												  buffer + alignedHeaderSize,
+											  blockDense->physical_data_size,
+											blockDense->physical_datum_count,
+											blockDense->orig_4_bytes.version,
+												  typeInfo,
+												  errdetailCallback,
+												  errdetailArg,
+												  errcontextCallback,
+												  errcontextArg);
+	}
+	else if (typeInfo->datumlen == -1)
 	{
 		/*
 		 * Variable-length items.
@@ -5482,6 +5874,8 @@ DatumStreamVersion_String(DatumStreamVersion datumStreamVersion)
 			return "Dense";
 		case DatumStreamVersion_Dense_Enhanced:
 			return "Dense_Enhanced";
+		case DatumStreamVersion_Dense_Dictionary:
+			return "Dense_Dictionary";
 		default:
 			return "Unknown";
 	}
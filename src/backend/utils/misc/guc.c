@@ -3692,6 +3692,8 @@ static bool reporting_enabled;	/* TRUE to enable GUC_REPORT */
 
 static int	GUCNestLevel = 0;	/* 1 when in main transaction */
 
+static uint64 guc_version = 0;	/* bumped whenever a value may change */
+
 
 static int	guc_var_compare(const void *a, const void *b);
 static void InitializeGUCOptionsFromEnvironment(void);
@@ -4761,6 +4763,8 @@ ResetAllOptions(void)
 {
 	int			i;
 
+	guc_version++;
+
 	for (i = 0; i < num_guc_variables; i++)
 	{
 		struct config_generic *gconf = guc_variables[i];
@@ -4993,6 +4997,9 @@ AtEOXact_GUC(bool isCommit, int nestLevel)
 		return;
 	}
 
+	/* values SET in this transaction may be restored below */
+	guc_version++;
+
 	still_dirty = false;
 	for (i = 0; i < num_guc_variables; i++)
 	{
@@ -5922,6 +5929,9 @@ set_config_option(const char *name, const char *value,
 		return 0;
 	}
 
+	if (changeVal)
+		guc_version++;
+
 	/*
 	 * Check if option can be set by the user.
 	 */
@@ -8486,6 +8496,16 @@ GetNumConfigOptions(void)
 	return num_guc_variables;
 }
 
+/*
+ * Return a counter that changes whenever the value of any GUC variable may
+ * have changed, so that callers can cache values derived from the settings.
+ */
+uint64
+GetConfigOptionsVersion(void)
+{
+	return guc_version;
+}
+
 /*
  * show_config_by_name - equiv to SHOW X command but implemented as
  * a function.
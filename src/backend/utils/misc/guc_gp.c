@@ -23,6 +23,7 @@
 #include "access/transam.h"
 #include "access/url.h"
 #include "access/xlog_internal.h"
+#include "cdb/cdbaocsam.h"
 #include "cdb/cdbappendonlyam.h"
 #include "cdb/cdbendpoint.h"
 #include "cdb/cdbdisp.h"
@@ -41,6 +42,7 @@
 #include "postmaster/syslogger.h"
 #include "postmaster/fts.h"
 #include "replication/walsender.h"
+#include "storage/buffile.h"
 #include "storage/proc.h"
 #include "tcop/idle_resource_cleaner.h"
 #include "utils/builtins.h"
@@ -80,6 +82,8 @@ static bool check_verify_gpfdists_cert(bool *newval, void **extra, GucSource sou
 static bool check_dispatch_log_stats(bool *newval, void **extra, GucSource source);
 static bool check_gp_hashagg_default_nbatches(int *newval, void **extra, GucSource source);
 static bool check_gp_workfile_compression(bool *newval, void **extra, GucSource source);
+static bool check_gp_interconnect_compression(bool *newval, void **extra, GucSource source);
+static bool check_gp_workfile_compression_type(int *newval, void **extra, GucSource source);
 
 /* Helper function for guc setter */
 bool gpvars_check_gp_resqueue_priority_default_value(char **newval,
@@ -309,6 +313,7 @@ int			optimizer_minidump;
 int			optimizer_cost_model;
 bool		optimizer_metadata_caching;
 int			optimizer_mdcache_size;
+int			optimizer_fallback_cache_size;
 bool		optimizer_use_gpdb_allocators;
 bool		optimizer_enable_table_alias;
 
@@ -370,6 +375,8 @@ bool		optimizer_enable_hashagg;
 bool		optimizer_enable_groupagg;
 bool		optimizer_expand_fulljoin;
 bool		optimizer_enable_mergejoin;
+bool		optimizer_enable_full_hash_join;
+bool		optimizer_enable_semi_join_reduction;
 bool		optimizer_prune_unused_columns;
 bool		optimizer_enable_redistribute_nestloop_loj_inner_child;
 bool		optimizer_force_comprehensive_join_implementation;
@@ -398,12 +405,14 @@ int			optimizer_penalize_broadcast_threshold;
 double		optimizer_cost_threshold;
 double		optimizer_nestloop_factor;
 double		optimizer_sort_factor;
+double		optimizer_penalize_skew_mcv_threshold;
 
 /* Optimizer hints */
 int			optimizer_join_arity_for_associativity_commutativity;
 int         optimizer_array_expansion_threshold;
 int         optimizer_join_order_threshold;
 int			optimizer_join_order;
+int			optimizer_join_order_budget;
 int			optimizer_cte_inlining_bound;
 int			optimizer_push_group_by_below_setop_threshold;
 int			optimizer_xform_bind_threshold;
@@ -413,6 +422,7 @@ bool		optimizer_force_three_stage_scalar_dqa;
 bool		optimizer_force_expanded_distinct_aggs;
 bool		optimizer_force_agg_skew_avoidance;
 bool		optimizer_penalize_skew;
+bool		optimizer_penalize_skew_mcv;
 bool		optimizer_prune_computed_columns;
 bool		optimizer_push_requirements_from_consumer_to_producer;
 bool		optimizer_enforce_subplans;
@@ -428,6 +438,8 @@ bool		optimizer_enable_associativity;
 bool		optimizer_enable_eageragg;
 bool		optimizer_enable_range_predicate_dpe;
 bool		optimizer_enable_orderedagg;
+bool		optimizer_enable_window_topn_pushdown;
+bool		optimizer_enable_outer_join_elimination;
 
 /* Analyze related GUCs for Optimizer */
 bool		optimizer_analyze_root_partition;
@@ -470,6 +482,7 @@ bool		gp_external_enable_filter_pushdown = true;
 /* Executor */
 bool		gp_enable_mk_sort = true;
 bool		gp_enable_motion_mk_sort = true;
+bool		gp_enable_runtime_filter = false;
 
 /* Enable GDD */
 bool		gp_enable_global_deadlock_detector = false;
@@ -616,6 +629,13 @@ static const struct config_enum_entry optimizer_join_order_options[] = {
 	{"greedy", JOIN_ORDER_GREEDY_SEARCH},
 	{"exhaustive", JOIN_ORDER_EXHAUSTIVE_SEARCH},
 	{"exhaustive2", JOIN_ORDER_EXHAUSTIVE2_SEARCH},
+	{"adaptive", JOIN_ORDER_ADAPTIVE_SEARCH},
+	{NULL, 0}
+};
+
+static const struct config_enum_entry gp_workfile_compression_types[] = {
+	{"zstd", WORKFILE_COMPRESSION_ZSTD},
+	{"lz4", WORKFILE_COMPRESSION_LZ4},
 	{NULL, 0}
 };
 
@@ -925,6 +945,17 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_enable_runtime_filter", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Enable Bloom filtering of outer rows in hash joins."),
+			gettext_noop("Outer rows of inner, semi and right hash joins that cannot match "
+						 "any inner row are discarded before they are probed or spilled.")
+		},
+		&gp_enable_runtime_filter,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_gang_creation_retry_non_recovery", PGC_USERSET, QUERY_TUNING_METHOD,
 		 gettext_noop("Retry gang creation if non-recovery failures are encountered during dispatch."),
@@ -1092,6 +1123,46 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_appendonly_zone_maps", PGC_USERSET, APPENDONLY_TABLES,
+			gettext_noop("Maintain per-block zone maps of new append-optimized tables, and use them to skip blocks in sequential scans."),
+			NULL
+		},
+		&gp_appendonly_zone_maps,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"gp_aocs_late_materialization", PGC_USERSET, APPENDONLY_TABLES,
+			gettext_noop("Evaluate the filter of a column-oriented table scan before reading the columns it does not reference."),
+			NULL
+		},
+		&gp_aocs_late_materialization,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"gp_aocs_batch_scan", PGC_USERSET, APPENDONLY_TABLES,
+			gettext_noop("Decode the rows of column-oriented table scans in batches, column by column."),
+			NULL
+		},
+		&gp_aocs_batch_scan,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"gp_aocs_dictionary_encoding", PGC_USERSET, APPENDONLY_TABLES,
+			gettext_noop("Dictionary encode the blocks of low-cardinality variable-length columns of column-oriented tables, and evaluate scan quals on their dictionaries."),
+			gettext_noop("Applies to the columns with compresstype rle_type.")
+		},
+		&gp_aocs_dictionary_encoding,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_heap_require_relhasoids_match", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Issue an error on discovery of a mismatch between relhasoids and a tuple header."),
@@ -1221,6 +1292,26 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_interconnect_batch_syscalls", PGC_USERSET, GP_ARRAY_TUNING,
+			gettext_noop("Send and receive several UDP interconnect packets per system call."),
+			gettext_noop("Uses sendmmsg() and recvmmsg() where the platform has them.")
+		},
+		&gp_interconnect_batch_syscalls,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"gp_interconnect_compression", PGC_USERSET, GP_ARRAY_TUNING,
+			gettext_noop("Compress the data packets of the UDP interconnect with LZ4."),
+			gettext_noop("Packets that do not compress well are sent uncompressed.")
+		},
+		&gp_interconnect_compression,
+		false,
+		check_gp_interconnect_compression, NULL, NULL
+	},
+
 	{
 		{"gp_interconnect_log_stats", PGC_USERSET, QUERY_TUNING_OTHER,
 			gettext_noop("Emit statistics from the UDP-IC at the end of every statement."),
@@ -2598,6 +2689,17 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_penalize_skew_mcv", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Use most common value frequencies to detect skewed hash redistributes below hash joins."),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_penalize_skew_mcv,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"optimizer_multilevel_partitioning", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Enable optimization of queries on multilevel partitioned tables."),
@@ -2725,6 +2827,26 @@ struct config_bool ConfigureNamesBool_gp[] =
 		true,
 		NULL, NULL, NULL
 	},
+	{
+		{"optimizer_enable_full_hash_join", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Enables the optimizer's support of full outer hash joins."),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_enable_full_hash_join,
+		false,
+		NULL, NULL, NULL
+	},
+	{
+		{"optimizer_enable_semi_join_reduction", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Enables the optimizer to reduce the larger side of a join by a semi join with the distinct join keys of the smaller side."),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_enable_semi_join_reduction,
+		false,
+		NULL, NULL, NULL
+	},
 	{
 		{"optimizer_enable_streaming_material", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Enable plans with a streaming material node in the optimizer."),
@@ -3248,6 +3370,26 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_enable_window_topn_pushdown", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Enable per-segment pre-filtering of windows followed by a row_number() or rank() top-N filter."),
+			NULL
+		},
+		&optimizer_enable_window_topn_pushdown,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"optimizer_enable_outer_join_elimination", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Enable removal of left outer joins on a unique key of the inner side when none of its columns are used."),
+			NULL
+		},
+		&optimizer_enable_outer_join_elimination,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"optimizer_prune_unused_columns", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Prune unused table columns during query optimization."),
@@ -3596,6 +3738,16 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_appendonly_read_ahead", PGC_USERSET, APPENDONLY_TABLES,
+			gettext_noop("Number of large reads to read ahead asynchronously in scans of append-optimized tables."),
+			gettext_noop("Zero disables read-ahead.")
+		},
+		&gp_appendonly_read_ahead,
+		0, 0, 64,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_workfile_max_entries", PGC_POSTMASTER, RESOURCES,
 			gettext_noop("Sets the maximum number of entries that can be stored in the workfile directory"),
@@ -4600,6 +4752,17 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_join_order_budget", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Sets the number of join pairs after which adaptive join ordering completes a join order greedily."),
+			gettext_noop("Only used when optimizer_join_order is adaptive. A value of 0 turns off the limit."),
+			GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_join_order_budget,
+		100000, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"optimizer_join_arity_for_associativity_commutativity", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("Maximum number of children n-ary-join have without disabling commutativity and associativity transform"),
@@ -4633,6 +4796,17 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_fallback_cache_size", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Sets the number of statements remembered as falling back from GPORCA to the Postgres planner."),
+			gettext_noop("Repeats of such statements are planned by the Postgres planner without invoking GPORCA. A value of 0 disables."),
+			GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_fallback_cache_size,
+		0, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"memory_profiler_dataset_size", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Set the size in GB"),
@@ -4950,6 +5124,17 @@ struct config_real ConfigureNamesReal_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_penalize_skew_mcv_threshold", PGC_USERSET, QUERY_TUNING_OTHER,
+			gettext_noop("Set the smallest frequency of the most common value of a redistribute key that makes the optimizer penalize the hash join above it."),
+			gettext_noop("Only used with optimizer_penalize_skew_mcv."),
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_penalize_skew_mcv_threshold,
+		0.1, 0.0, 1.0,
+		NULL, NULL, NULL
+	},
+
 	/* End-of-list marker */
 	{
 		{NULL, 0, 0, NULL, NULL}, NULL, 0.0, 0.0, 0.0, NULL, NULL
@@ -5159,6 +5344,17 @@ struct config_enum ConfigureNamesEnum_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_workfile_compression_type", PGC_USERSET, RESOURCES_DISK,
+			gettext_noop("Sets the compression algorithm used for temporary files."),
+			gettext_noop("Valid values are \"zstd\" and \"lz4\". Only takes "
+						 "effect when gp_workfile_compression is enabled.")
+		},
+		&gp_workfile_compression_type,
+		WORKFILE_COMPRESSION_DEFAULT, gp_workfile_compression_types,
+		check_gp_workfile_compression_type, NULL, NULL
+	},
+
 	{
 		{"gp_sessionstate_loglevel", PGC_SUSET, DEVELOPER_OPTIONS,
 			gettext_noop("Sets the logging level for session state debugging messages"),
@@ -5388,7 +5584,7 @@ struct config_enum ConfigureNamesEnum_gp[] =
 	{
 		{"optimizer_join_order", PGC_USERSET, QUERY_TUNING_OTHER,
 			gettext_noop("Set optimizer join heuristic model."),
-			gettext_noop("Valid values are query, greedy, exhaustive and exhaustive2"),
+			gettext_noop("Valid values are query, greedy, exhaustive, exhaustive2 and adaptive"),
 			GUC_NOT_IN_SAMPLE
 		},
 		&optimizer_join_order,
@@ -5791,7 +5987,7 @@ lookup_autostats_mode_by_value(GpAutoStatsModeValue val)
 static bool
 check_gp_workfile_compression(bool *newval, void **extra, GucSource source)
 {
-#ifndef HAVE_LIBZSTD
+#if !defined(HAVE_LIBZSTD) && !defined(HAVE_LIBLZ4)
 	if (*newval)
 	{
 		GUC_check_errmsg("workfile compresssion is not supported by this build");
@@ -5801,6 +5997,43 @@ check_gp_workfile_compression(bool *newval, void **extra, GucSource source)
 	return true;
 }
 
+static bool
+check_gp_interconnect_compression(bool *newval, void **extra, GucSource source)
+{
+#ifndef HAVE_LIBLZ4
+	if (*newval)
+	{
+		GUC_check_errmsg("interconnect compression is not supported by this build");
+		return false;
+	}
+#endif
+	return true;
+}
+
+static bool
+check_gp_workfile_compression_type(int *newval, void **extra, GucSource source)
+{
+	/* The built-in default is accepted, it only matters once compression is on */
+	if (source == PGC_S_DEFAULT)
+		return true;
+
+#ifndef HAVE_LIBZSTD
+	if (*newval == WORKFILE_COMPRESSION_ZSTD)
+	{
+		GUC_check_errmsg("zstd workfile compression is not supported by this build");
+		return false;
+	}
+#endif
+#ifndef HAVE_LIBLZ4
+	if (*newval == WORKFILE_COMPRESSION_LZ4)
+	{
+		GUC_check_errmsg("lz4 workfile compression is not supported by this build");
+		return false;
+	}
+#endif
+	return true;
+}
+
 static void
 dispatch_sync_pg_variable_internal(struct config_generic * gconfig, bool is_explicit)
 {
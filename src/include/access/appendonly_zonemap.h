@@ -0,0 +1,123 @@
+/*------------------------------------------------------------------------------
+ *
+ * appendonly_zonemap.h
+ *   Per-block min/max summaries (zone maps) of append-optimized relations.
+ *
+ * A zone map records, for every block directory entry, the smallest and the
+ * largest value and whether there were NULLs in a few columns of the blocks
+ * covered by the entry. It is stored next to the minipage in the block
+ * directory relation, and lets a sequential scan skip the blocks that
+ * cannot contain a row satisfying the scan's quals.
+ *
+ * Copyright (c) 2020-Present VMware, Inc. or its affiliates
+ *
+ *
+ * IDENTIFICATION
+ *	    src/include/access/appendonly_zonemap.h
+ *
+ *------------------------------------------------------------------------------
+ */
+#ifndef APPENDONLY_ZONEMAP_H
+#define APPENDONLY_ZONEMAP_H
+
+#include "access/skey.h"
+#include "fmgr.h"
+#include "nodes/pg_list.h"
+#include "utils/relcache.h"
+
+/*
+ * Maximum number of columns tracked per column group. For row-oriented
+ * tables all columns share column group 0, and the zone map of a full
+ * minipage has to fit into the same block directory tuple as the minipage.
+ */
+#define AO_ZONEMAP_MAX_COLUMNS		4
+
+#define AO_ZONEMAP_VERSION			1
+
+/* Flags of a zone map entry */
+#define AOZM_VALID			0x01	/* summary covers all rows of the entry */
+#define AOZM_HAS_VALUES		0x02	/* minValue/maxValue are set */
+#define AOZM_HAS_NULLS		0x04	/* some rows are NULL */
+
+typedef struct AppendOnlyZoneMapEntry
+{
+	Datum		minValue;
+	Datum		maxValue;
+	int32		flags;
+} AppendOnlyZoneMapEntry;
+
+/*
+ * Define a varlena type for the zone map of a minipage. The entries are
+ * stored entry-major: entry[entryNo * nColumns + columnNo].
+ */
+typedef struct AppendOnlyZoneMap
+{
+	/* Total length. Must be the first. */
+	int32		_len;
+	int32		version;
+	uint32		nEntry;
+	int32		nColumns;
+	AttrNumber	attnums[AO_ZONEMAP_MAX_COLUMNS];
+	Oid			atttypids[AO_ZONEMAP_MAX_COLUMNS];
+
+	/* Varlena array */
+	AppendOnlyZoneMapEntry entry[1];
+} AppendOnlyZoneMap;
+
+/*
+ * Accumulates the zone map entry of the block being written.
+ */
+typedef struct AppendOnlyZoneMapBuilder
+{
+	int			nColumns;
+	AttrNumber	attnums[AO_ZONEMAP_MAX_COLUMNS];
+	Oid			atttypids[AO_ZONEMAP_MAX_COLUMNS];
+	FmgrInfo	cmpProcs[AO_ZONEMAP_MAX_COLUMNS];
+	AppendOnlyZoneMapEntry current[AO_ZONEMAP_MAX_COLUMNS];
+} AppendOnlyZoneMapBuilder;
+
+extern bool gp_appendonly_zone_maps;
+
+static inline uint32
+AppendOnlyZoneMap_Size(uint32 nEntry, int nColumns)
+{
+	return offsetof(AppendOnlyZoneMap, entry) +
+		sizeof(AppendOnlyZoneMapEntry) * nEntry * nColumns;
+}
+
+static inline AppendOnlyZoneMapEntry *
+AppendOnlyZoneMap_GetEntry(AppendOnlyZoneMap *zoneMap, int entryNo,
+						   int columnNo)
+{
+	return &zoneMap->entry[entryNo * zoneMap->nColumns + columnNo];
+}
+
+extern int AppendOnlyZoneMap_GetColumns(Relation aoRel, int columnGroupNo,
+										AttrNumber *attnums, Oid *atttypids);
+extern AppendOnlyZoneMap *AppendOnlyZoneMap_Create(Relation aoRel,
+												   int columnGroupNo,
+												   uint32 maxEntries);
+extern void AppendOnlyZoneMap_SetEntry(AppendOnlyZoneMap *zoneMap,
+									   int entryNo,
+									   AppendOnlyZoneMapBuilder *builder);
+extern void AppendOnlyZoneMap_MergeEntry(AppendOnlyZoneMap *zoneMap,
+										 int entryNo,
+										 AppendOnlyZoneMapBuilder *builder);
+extern void AppendOnlyZoneMap_Load(AppendOnlyZoneMap *zoneMap,
+								   AppendOnlyZoneMap *stored,
+								   uint32 nEntry);
+extern bool AppendOnlyZoneMap_EntryExcluded(AppendOnlyZoneMap *zoneMap,
+											int entryNo,
+											int nkeys, ScanKey keys);
+
+extern AppendOnlyZoneMapBuilder *AppendOnlyZoneMapBuilder_Create(Relation aoRel,
+																 int columnGroupNo);
+extern void AppendOnlyZoneMapBuilder_AddValue(AppendOnlyZoneMapBuilder *builder,
+											  int columnNo,
+											  Datum value, bool isnull);
+extern void AppendOnlyZoneMapBuilder_Reset(AppendOnlyZoneMapBuilder *builder);
+
+extern ScanKey AppendOnlyZoneMap_BuildScanKeys(Relation aoRel, List *quals,
+											   int *nkeys);
+
+#endif							/* APPENDONLY_ZONEMAP_H */
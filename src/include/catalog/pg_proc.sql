@@ -304,6 +304,10 @@
  CREATE FUNCTION enable_xform(text) RETURNS text LANGUAGE internal IMMUTABLE STRICT AS 'enable_xform' WITH (OID=6088, DESCRIPTION="enables transformations in the optimizer");
 
  CREATE FUNCTION gp_opt_version() RETURNS text LANGUAGE internal IMMUTABLE STRICT AS 'gp_opt_version' WITH (OID=6089, DESCRIPTION="Returns the optimizer and gpos library versions");
+
+ CREATE FUNCTION gp_opt_mdcache_stats() RETURNS text LANGUAGE internal VOLATILE STRICT AS 'gp_opt_mdcache_stats' WITH (OID=6090, DESCRIPTION="Returns hits, misses and evictions of the optimizer metadata cache");
+
+ CREATE FUNCTION gp_opt_fallback_cache_stats() RETURNS text LANGUAGE internal VOLATILE STRICT AS 'gp_opt_fallback_cache_stats' WITH (OID=6091, DESCRIPTION="Returns the counters of the cache of statements that fell back from the optimizer to the planner");
  
  
   -- functions for the complex data type
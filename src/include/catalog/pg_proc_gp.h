@@ -620,6 +620,14 @@ DESCR("enables transformations in the optimizer");
 DATA(insert OID = 6089 ( gp_opt_version  PGNSP PGUID 12 1 0 0 0 f f f f t f i 0 0 25 "" _null_ _null_ _null_ _null_ gp_opt_version _null_ _null_ _null_ n a ));
 DESCR("Returns the optimizer and gpos library versions");
 
+/* gp_opt_mdcache_stats() => text */
+DATA(insert OID = 6090 ( gp_opt_mdcache_stats  PGNSP PGUID 12 1 0 0 0 f f f f t f v 0 0 25 "" _null_ _null_ _null_ _null_ gp_opt_mdcache_stats _null_ _null_ _null_ n a ));
+DESCR("Returns hits, misses and evictions of the optimizer metadata cache");
+
+/* gp_opt_fallback_cache_stats() => text */
+DATA(insert OID = 6091 ( gp_opt_fallback_cache_stats  PGNSP PGUID 12 1 0 0 0 f f f f t f v 0 0 25 "" _null_ _null_ _null_ _null_ gp_opt_fallback_cache_stats _null_ _null_ _null_ n a ));
+DESCR("Returns the counters of the cache of statements that fell back from the optimizer to the planner");
+
 
   /* functions for the complex data type */
 /* complex_in(cstring) => complex */
@@ -71,6 +71,41 @@ typedef struct AOCSInsertDescData
 
 typedef AOCSInsertDescData *AOCSInsertDesc;
 
+/*
+ * Number of rows that a scan in batch mode decodes at a time, see
+ * aocs_set_batch_mode().
+ */
+#define AOCS_BATCH_SIZE		1024
+
+/*
+ * A batch of rows of a scan in batch mode, decoded column by column.
+ */
+typedef struct AOCSScanBatch
+{
+	int			nrows;			/* number of rows in the batch */
+	int			next;			/* next row to return */
+	int64		firstRowNum;	/* row number of the first row */
+
+	/* Column vectors, indexed by column number (starting from 0) */
+	Datum	  **values;
+	bool	  **isnull;
+
+	/* Rows that are visible and have not been filtered out */
+	bool	   *selected;
+} AOCSScanBatch;
+
+/*
+ * Row filter of a scan with late materialization, see aocs_set_filter().
+ * Returns true if the row in the slot qualifies.
+ */
+typedef bool (*AOCSScanFilter) (void *arg, TupleTableSlot *slot);
+
+/*
+ * Batch filter of a scan in batch mode, see aocs_set_filter(). Deselects the
+ * rows of the batch that do not qualify.
+ */
+typedef void (*AOCSBatchFilter) (void *arg, AOCSScanBatch *batch);
+
 /*
  * used for scan of append only relations using BufferedRead and VarBlocks
  */
@@ -124,6 +159,47 @@ typedef struct AOCSScanDescData
 	 */
 	AppendOnlyBlockDirectory *blockDirectory;
 
+	/*
+	 * Zone map scan keys, see aocs_set_zonemap_keys(), and the row ranges
+	 * of the current segment file they exclude, in row number order.
+	 */
+	int			num_zonemap_keys;
+	ScanKey		zonemap_keys;
+	AppendOnlyBlockDirectoryEntry *excluded_ranges;
+	int			num_excluded_ranges;
+	int			next_excluded_range;
+	int64		zonemap_skipped_rows;	/* # rows skipped by the zone maps */
+
+	/*
+	 * Dictionary scan keys of each column, see aocs_set_dictionary_quals().
+	 * NULL if no column has any.
+	 */
+	int		   *num_dict_keys;
+	DatumStreamDictionaryKey **dict_keys;
+
+	/*
+	 * Late materialization, see aocs_set_filter(). While late_materialize is
+	 * set for the current segment file, only the filter_atts columns are read
+	 * for every row, and the lazy_atts columns only for the rows that the
+	 * filter accepts.
+	 */
+	AOCSScanFilter filter;
+	AOCSBatchFilter batch_filter;
+	void	   *filter_arg;
+	int		   *filter_atts;
+	int			num_filter_atts;
+	int		   *lazy_atts;
+	int			num_lazy_atts;
+	bool		late_materialize;
+	int64		late_mat_skipped_blocks;	/* # lazy column blocks not read */
+
+	/* The current batch, if in batch mode, see aocs_set_batch_mode() */
+	AOCSScanBatch *batch;
+	int64		batch_rows;		/* # rows decoded in batch mode */
+
+	/* I/O statistics of the datum streams closed so far */
+	BufferedReadStats ioStats;
+
 	AppendOnlyVisimap visibilityMap;
 
 }	AOCSScanDescData;
@@ -196,6 +272,9 @@ typedef struct AOCSAddColumnDescData
 } AOCSAddColumnDescData;
 typedef AOCSAddColumnDescData *AOCSAddColumnDesc;
 
+extern bool gp_aocs_late_materialization;
+extern bool gp_aocs_batch_scan;
+
 /* ----------------
  *		function prototypes for appendonly access method
  * ----------------
@@ -211,8 +290,15 @@ extern AOCSScanDesc aocs_beginrangescan(Relation relation, Snapshot snapshot,
 extern void aocs_afterscan(AOCSScanDesc scan);
 extern void aocs_rescan(AOCSScanDesc scan);
 extern void aocs_endscan(AOCSScanDesc scan);
+extern void aocs_set_zonemap_keys(AOCSScanDesc scan, int nkeys, ScanKey keys);
+extern void aocs_set_dictionary_quals(AOCSScanDesc scan, List *quals);
+extern bool aocs_set_filter(AOCSScanDesc scan, bool *filter_proj,
+							AOCSScanFilter filter,
+							AOCSBatchFilter batch_filter, void *arg);
+extern bool aocs_set_batch_mode(AOCSScanDesc scan);
 
 extern bool aocs_getnext(AOCSScanDesc scan, ScanDirection direction, TupleTableSlot *slot);
+extern void aocs_get_io_stats(AOCSScanDesc scan, BufferedReadStats *stats);
 extern AOCSInsertDesc aocs_insert_init(Relation rel, int segno, bool update_mode);
 extern Oid aocs_insert_values(AOCSInsertDesc idesc, Datum *d, bool *null, AOTupleId *aoTupleId);
 static inline Oid aocs_insert(AOCSInsertDesc idesc, TupleTableSlot *slot)
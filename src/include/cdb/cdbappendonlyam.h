@@ -107,6 +107,12 @@ typedef struct AppendOnlyInsertDescData
 	/* The block directory for the appendonly relation. */
 	AppendOnlyBlockDirectory blockDirectory;
 
+	/*
+	 * Zone map summary of the block being written, if the block directory
+	 * maintains zone maps. Otherwise NULL.
+	 */
+	AppendOnlyZoneMapBuilder *zoneMapBuilder;
+
 	bool update_mode;
 } AppendOnlyInsertDescData;
 
@@ -199,6 +205,9 @@ typedef struct AppendOnlyScanDescData
 	AppendOnlyStorageAttributes	storageAttributes;
 	AppendOnlyStorageRead		storageRead;
 
+	/* I/O statistics of the storage read sessions finished so far */
+	BufferedReadStats			ioStats;
+
 	char						*title;
 				/*
 				 * A phrase that better describes the purpose of the this open.
@@ -215,6 +224,17 @@ typedef struct AppendOnlyScanDescData
 	 */
 	AppendOnlyBlockDirectory *blockDirectory;
 
+	/*
+	 * Zone map scan keys, see appendonly_set_zonemap_keys(), and the
+	 * ranges of the current segment file they exclude, in file order.
+	 */
+	int			aos_nzonemapkeys;
+	ScanKey		aos_zonemapkeys;
+	AppendOnlyBlockDirectoryEntry *aos_excludedRanges;
+	int			aos_nexcludedRanges;
+	int			aos_nextExcludedRange;
+	int64		aos_zonemapSkippedRows;	/* # rows of the blocks skipped unread */
+
 	/**
 	 * The visibility map is used during scans
 	 * to check tuple visibility using visi map.
@@ -338,9 +358,13 @@ extern AppendOnlyScanDesc appendonly_beginrangescan(Relation relation,
 extern void appendonly_afterscan(AppendOnlyScanDesc scan);
 extern void appendonly_rescan(AppendOnlyScanDesc scan, ScanKey key);
 extern void appendonly_endscan(AppendOnlyScanDesc scan);
+extern void appendonly_set_zonemap_keys(AppendOnlyScanDesc scan,
+							int nkeys, ScanKey keys);
 extern bool appendonly_getnext(AppendOnlyScanDesc scan,
 							   ScanDirection direction,
 							   TupleTableSlot *slot);
+extern void appendonly_get_io_stats(AppendOnlyScanDesc scan,
+									BufferedReadStats *stats);
 extern AppendOnlyFetchDesc appendonly_fetch_init(
 	Relation 	relation,
 	Snapshot    snapshot,
@@ -17,6 +17,7 @@
 #include "access/aosegfiles.h"
 #include "access/aocssegfiles.h"
 #include "access/appendonlytid.h"
+#include "access/appendonly_zonemap.h"
 #include "access/skey.h"
 
 extern int gp_blockdirectory_entry_min_range;
@@ -71,6 +72,13 @@ typedef struct MinipagePerColumnGroup
 	Minipage *minipage;
 	uint32 numMinipageEntries;
 	ItemPointerData tupleTid;
+
+	/*
+	 * Zone map of the minipage entries, only maintained on insert if the
+	 * block directory relation has the zonemap column and the column group
+	 * has columns to track. Otherwise NULL.
+	 */
+	AppendOnlyZoneMap *zonemap;
 } MinipagePerColumnGroup;
 
 /*
@@ -199,6 +207,25 @@ extern bool AppendOnlyBlockDirectory_InsertEntry(
 	int64 fileOffset,
 	int64 rowCount,
 	bool addColAction);
+extern bool AppendOnlyBlockDirectory_InsertEntryWithZoneMap(
+	AppendOnlyBlockDirectory *blockDirectory,
+	int columnGroupNo,
+	int64 firstRowNum,
+	int64 fileOffset,
+	int64 rowCount,
+	AppendOnlyZoneMapBuilder *zoneMapBuilder);
+extern bool AppendOnlyBlockDirectory_HasZoneMap(
+	AppendOnlyBlockDirectory *blockDirectory,
+	int columnGroupNo);
+extern AppendOnlyBlockDirectoryEntry *AppendOnlyBlockDirectory_GetExcludedRanges(
+	Relation aoRel,
+	Snapshot appendOnlyMetaDataSnapshot,
+	int segno,
+	int columnGroupNo,
+	int64 eof,
+	int nkeys,
+	ScanKey keys,
+	int *nranges);
 extern bool AppendOnlyBlockDirectory_addCol_InsertEntry(
 	AppendOnlyBlockDirectory *blockDirectory,
 	int columnGroupNo,
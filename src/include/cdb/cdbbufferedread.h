@@ -18,8 +18,19 @@
 #ifndef CDBBUFFEREDREAD_H
 #define CDBBUFFEREDREAD_H
 
+#include "portability/instr_time.h"
 #include "storage/fd.h"
 
+/*
+ * I/O statistics of a BufferedRead, kept across the files it reads.
+ */
+typedef struct BufferedReadStats
+{
+	int64				reads;		/* number of large reads */
+	int64				bytes;		/* bytes read */
+	instr_time			waitTime;	/* time spent waiting for the reads */
+} BufferedReadStats;
+
 typedef struct BufferedRead
 {
 	/*
@@ -76,8 +87,22 @@ typedef struct BufferedRead
 	bool				haveTemporaryLimitInEffect;
 	int64				temporaryLimitFileLen;
 
+	/*
+	 * Read-ahead support.
+	 */
+	int64				prefetchPosition;
+							/*
+							 * The position up to which the kernel has been asked to
+							 * read ahead past the current large read.
+							 */
+
+	BufferedReadStats	stats;
+
 } BufferedRead;
 
+/* GUC: number of large reads to read ahead asynchronously */
+extern int gp_appendonly_read_ahead;
+
 /*
  * Determines the amount of memory to supply for
  * BufferedRead given the desired buffer and
@@ -177,6 +202,13 @@ int64 BufferedReadCurrentPosition(
 extern void BufferedReadCompleteFile(
     BufferedRead       *bufferedRead);
 
+/*
+ * Add the I/O statistics of a BufferedRead to the given statistics.
+ */
+extern void BufferedReadAccumStats(
+    BufferedReadStats  *stats,
+    BufferedRead       *bufferedRead);
+
 /*
  * Finish with reading all together.
  */
@@ -30,6 +30,20 @@ typedef enum
 	REDUCE_JUMP_HASH
 } CdbHashReduce;
 
+/*
+ * Hash functions that cdbhash() computes inline, without a call through
+ * fmgr. Any other function is called through its FmgrInfo.
+ */
+typedef enum
+{
+	CDBHASH_FUNC_FMGR = 0,
+	CDBHASH_FUNC_INT2,			/* hashint2 */
+	CDBHASH_FUNC_INT4,			/* hashint4, also used for date */
+	CDBHASH_FUNC_INT8,			/* hashint8, and timestamp_hash */
+	CDBHASH_FUNC_OID,			/* hashoid */
+	CDBHASH_FUNC_TEXT			/* hashtext, also used for varchar */
+} CdbHashFuncKind;
+
 /*
  * Structure that holds Greenplum Database hashing information.
  */
@@ -43,6 +57,7 @@ typedef struct CdbHash
 
 	int			natts;
 	FmgrInfo   *hashfuncs;
+	CdbHashFuncKind *hashkinds; /* inline version of each hash function */
 } CdbHash;
 
 /*
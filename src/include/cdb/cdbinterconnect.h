@@ -206,6 +206,12 @@ struct MotionConn
 	/* seq already sent */
 	uint32 sentSeq;
 
+	/*
+	 * number of data packets to send uncompressed before compressing is
+	 * tried again, see gp_interconnect_compression.
+	 */
+	int compressSkip;
+
 	/* ack of this seq and packets with smaller seqs have been received */
 	uint32 receivedAckSeq;
 
@@ -458,6 +458,21 @@ extern bool gp_interconnect_aggressive_retry; /* fast-track app-level retry */
  */
 extern bool gp_interconnect_full_crc;
 
+/*
+ * Parameter gp_interconnect_batch_syscalls
+ *
+ * Send and receive several UDP packets per sendmmsg()/recvmmsg() call.
+ */
+extern bool gp_interconnect_batch_syscalls;
+
+/*
+ * Parameter gp_interconnect_compression
+ *
+ * Compress the data packets of the UDP interconnect with LZ4, as long as
+ * they compress well.
+ */
+extern bool gp_interconnect_compression;
+
 /*
  * Parameter gp_interconnect_log_stats
  *
@@ -766,6 +781,9 @@ extern bool gp_enable_sort_distinct;
 extern bool gp_enable_mk_sort;
 extern bool gp_enable_motion_mk_sort;
 
+/* Bloom filter on the hash values of the inner side of hash joins */
+extern bool gp_enable_runtime_filter;
+
 /* Alter table add column inherits storage setting from the table */
 extern bool gp_add_column_inherits_table_setting;
 
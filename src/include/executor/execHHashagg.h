@@ -46,7 +46,16 @@ typedef struct HashAggEntry
 	bool is_primodial; /* indicates if this entry is there before spilling. */
 } HashAggEntry;
 
-typedef HashAggEntry* HashAggBucket;
+/*
+ * A hash bucket: the head of the entry chain, and a bloom filter of the
+ * hash values in the chain. They are kept together, since probing a bucket
+ * reads both.
+ */
+typedef struct HashAggBucket
+{
+	HashAggEntry *entry;	/* First entry in chain. */
+	uint64		bloom;		/* Bloom filter of the chain's hash values. */
+} HashAggBucket;
 
 /* A SpillFile controls access to a temporary file used to hold  
  * transition tuples spilled from the hash table in order to free 
@@ -154,7 +163,6 @@ typedef struct HashAggTable
 
 	unsigned nbuckets;
 	HashAggBucket  *buckets;
-	uint64 *bloom;
 
 	/* hashkey bitshift amount to determine bucket - used when spilling */
 	unsigned pshift;
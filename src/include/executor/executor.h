@@ -355,6 +355,12 @@ extern TupleTableSlot *ExecProject(ProjectionInfo *projInfo,
 			ExprDoneCond *isDone);
 extern Datum ExecEvalFunctionArgToConst(FuncExpr *fexpr, int argno, bool *isnull);
 extern void GetNeededColumnsForScan(Node *expr, bool *mask, int n);
+
+typedef struct BatchQual BatchQual;
+extern BatchQual *ExecInitBatchQual(List *qual, List *qualstate,
+				  List **remaining);
+extern int	ExecBatchQual(BatchQual *batchqual, Datum **values, bool **isnull,
+			  int nrows, bool *selected);
 extern bool isJoinExprNull(List *joinExpr, ExprContext *econtext);
 
 /*
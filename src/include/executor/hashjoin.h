@@ -139,6 +139,21 @@ typedef struct HashJoinTableStats
 } HashJoinTableStats;
 
 
+/*
+ * Hash join Bloom filter: the low bits of the hash value select the word,
+ * the high bits the two bits set in it.  The filter has at most
+ * HJ_BLOOM_MAX_WORDS words, so the two sets of bits never overlap.
+ */
+#define HJ_BLOOM_MAX_WORDS (1 << 20)
+#define HJ_BLOOM_WORD(hashtable, hashvalue) \
+	((hashtable)->bloom[(hashvalue) & (hashtable)->bloomMask])
+#define HJ_BLOOM_BITS(hashvalue) \
+	((((uint64) 1) << (((hashvalue) >> 20) & 0x3f)) | \
+	 (((uint64) 1) << ((hashvalue) >> 26)))
+#define HJ_BLOOM_SIZE(hashtable) \
+	((hashtable)->bloom != NULL ? \
+	 ((Size) (hashtable)->bloomMask + 1) * sizeof(uint64) : 0)
+
 /*
  * HashJoinTableData
  */
@@ -169,6 +184,17 @@ typedef struct HashJoinTableData
 
 	uint64		totalTuples;	/* # tuples obtained from inner plan */
 
+	/*
+	 * CDB: Bloom filter over the hash values of all inner tuples, or NULL if
+	 * not used.  Each hash value selects one 64-bit word and sets two bits in
+	 * it.  Outer tuples whose hash value is not in the filter cannot match,
+	 * so joins that discard unmatched outer tuples can drop them before they
+	 * are probed or written to a batch file.
+	 */
+	uint64	   *bloom;
+	uint32		bloomMask;		/* # words in bloom filter - 1 */
+	uint64		bloomRejected;	/* # outer tuples rejected by the filter */
+
 	/*
 	 * These arrays are allocated for the life of the hash join, but only if
 	 * nbatch > 1.  A file is opened only when we first write a tuple into it
@@ -687,6 +687,10 @@ gpos::ULONG CountLeafPartTables(Oid oidRelation);
 // table has been changed or TransactionXmin changed from that we saved)?
 bool MDCacheNeedsReset(void);
 
+// return the relations that were invalidated since the last call and need
+// to be removed from the metadata cache
+List *MDCacheGetInvalidatedRelations(void);
+
 // Check that the index is usable in the current snapshot and if not, save the
 // xmin of the current snapshot. Returns true if the index is not usable and
 // should be skipped.
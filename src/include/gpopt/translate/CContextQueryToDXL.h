@@ -65,6 +65,9 @@ private:
 	// does the query have any volatile functions?
 	BOOL m_has_volatile_functions;
 
+	// relations scanned by the query
+	MdidHashSet *m_rel_mdids;
+
 public:
 	// ctor
 	CContextQueryToDXL(CMemoryPool *mp);
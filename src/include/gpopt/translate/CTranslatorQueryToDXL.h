@@ -448,6 +448,13 @@ public:
 		return m_context->m_distribution_hashops;
 	}
 
+	// relations scanned by the query
+	MdidHashSet *
+	GetScannedRelations() const
+	{
+		return m_context->m_rel_mdids;
+	}
+
 	// main translation routine for Query -> DXL tree
 	CDXLNode *TranslateSelectQueryToDXL();
 
@@ -1705,6 +1705,8 @@ typedef struct SeqScanState
 	/* extra state for AOCS scans */
 	bool	   *ss_aocs_proj;
 	int			ss_aocs_ncol;
+	List	   *ss_aocs_qual;	/* quals evaluated by the AOCS scan itself */
+	struct BatchQual *ss_aocs_batchqual;	/* same, over batches of rows */
 } SeqScanState;
 
 /*
@@ -18,15 +18,19 @@
 #define ORCA_H
 
 #include "pg_config.h"
+#include "nodes/params.h"
+#include "nodes/parsenodes.h"
+#include "nodes/plannodes.h"
 
 #ifdef USE_ORCA
 
 extern PlannedStmt * optimize_query(Query *parse, ParamListInfo boundParams);
+extern Datum OptimizerFallbackCacheStats(void);
 
 #else
 
 /* Keep compilers quiet in case the build used --disable-orca */
-static PlannedStmt *
+static inline PlannedStmt *
 optimize_query(Query *parse, ParamListInfo boundParams)
 {
 	Assert(false);
@@ -60,7 +60,21 @@ extern BufFile *BufFileCreateInSet(struct workfile_set *work_set, const char *fi
 extern void BufFileSuspend(BufFile *buffile);
 extern void BufFileResume(BufFile *buffile);
 
+/* Compression algorithms for gp_workfile_compression_type */
+typedef enum WorkfileCompressionType
+{
+	WORKFILE_COMPRESSION_ZSTD,
+	WORKFILE_COMPRESSION_LZ4
+} WorkfileCompressionType;
+
+#if !defined(HAVE_LIBZSTD) && defined(HAVE_LIBLZ4)
+#define WORKFILE_COMPRESSION_DEFAULT WORKFILE_COMPRESSION_LZ4
+#else
+#define WORKFILE_COMPRESSION_DEFAULT WORKFILE_COMPRESSION_ZSTD
+#endif
+
 extern bool gp_workfile_compression;
+extern int	gp_workfile_compression_type;
 extern void BufFilePledgeSequential(BufFile *buffile);
 extern void BufFileSetIsTempFile(BufFile *file, bool isTempFile);
 
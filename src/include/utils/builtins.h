@@ -1387,6 +1387,8 @@ extern Datum enable_xform(PG_FUNCTION_ARGS);
 
 /* Optimizer's version */
 extern Datum gp_opt_version(PG_FUNCTION_ARGS);
+extern Datum gp_opt_mdcache_stats(PG_FUNCTION_ARGS);
+extern Datum gp_opt_fallback_cache_stats(PG_FUNCTION_ARGS);
 
 /* query_metrics.c */
 extern Datum gp_instrument_shmem_summary(PG_FUNCTION_ARGS);
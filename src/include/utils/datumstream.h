@@ -15,6 +15,7 @@
 #ifndef DATUMSTREAM_H
 #define DATUMSTREAM_H
 
+#include "access/skey.h"
 #include "catalog/pg_attribute.h"
 #include "utils/datumstreamblock.h"
 
@@ -50,6 +51,7 @@ typedef struct DatumStreamWrite
 
 	bool		rle_want_compression;
 	bool		delta_want_compression;
+	bool		dict_want_encoding;
 
 	int32		maxAoBlockSize;
 	int32		maxAoHeaderSize;
@@ -65,6 +67,12 @@ typedef struct DatumStreamWrite
 
 	DatumStreamBlockWrite blockWrite;
 
+	/*
+	 * Zone map summary of the block being written, if the block directory
+	 * maintains a zone map for the column. Otherwise NULL.
+	 */
+	AppendOnlyZoneMapBuilder *zoneMapBuilder;
+
 	/*
 	 * EOFs of current segment file.
 	 */
@@ -72,6 +80,21 @@ typedef struct DatumStreamWrite
 	int64		eofUncompress;
 }	DatumStreamWrite;
 
+/*
+ * A scan key evaluated on the values of the dictionary of dictionary encoded
+ * blocks, see datumstreamread_set_dictionary_keys().  A value satisfies the
+ * key if it satisfies the btree strategy against any of the key's values,
+ * as compared by the btree comparison function of the column type.
+ */
+typedef struct DatumStreamDictionaryKey
+{
+	StrategyNumber strategy;
+	FmgrInfo	cmpProc;
+	Oid			collation;
+	int			nvalues;
+	Datum	   *values;
+}	DatumStreamDictionaryKey;
+
 typedef enum DatumStreamLargeObjectState
 {
 	DatumStreamLargeObjectState_None = 0,
@@ -166,6 +189,10 @@ typedef struct DatumStreamRead
 	/* AO Storage */
 	bool		need_close_file;
 
+	/* Dictionary scan keys, see datumstreamread_set_dictionary_keys() */
+	int			num_dict_keys;
+	DatumStreamDictionaryKey *dict_keys;
+
 }	DatumStreamRead;
 
 /*
@@ -242,6 +269,48 @@ datumstreamread_nth(DatumStreamRead * acc)
 	}
 }
 
+/*
+ * Number of rows of the current block that have not been advanced to yet.
+ * Unlike datumstreamread_nth(), this can be asked of a block of any kind at
+ * any time.
+ */
+inline static int
+datumstreamread_rows_left(DatumStreamRead * acc)
+{
+	int			left = acc->blockRowCount - 1 - acc->blockRead.nth;
+
+	return (left > 0) ? left : 0;
+}
+
+/*
+ * Do the dictionary scan keys prove that the current row does not satisfy
+ * them?  That is only known for the rows of dictionary encoded blocks.  The
+ * keys are strict, so a NULL never satisfies them.
+ */
+inline static bool
+datumstreamread_dictionary_excludes_row(DatumStreamRead * acc)
+{
+	DatumStreamBlockRead *dsr = &acc->blockRead;
+
+	if (!dsr->dict_filter)
+		return false;
+
+	if (dsr->has_null && DatumStreamBitMapRead_CurrentIsOn(&dsr->null_bitmap))
+		return true;
+
+	return !dsr->dict_match[dsr->dict_codesp[dsr->physical_datum_index]];
+}
+
+/*
+ * Do the dictionary scan keys prove that no row of the current block
+ * satisfies them?
+ */
+inline static bool
+datumstreamread_dictionary_excludes_block(DatumStreamRead * acc)
+{
+	return (acc->blockRead.dict_filter && acc->blockRead.dict_match_count == 0);
+}
+
 /* ------------------------------------------------------------------------------ */
 
 extern int datumstreamwrite_put(
@@ -311,12 +380,17 @@ extern int	datumstreamread_block(DatumStreamRead * ds,
 								  int colGroupNo);
 extern void datumstreamread_find(DatumStreamRead * datumStream,
 					 int32 rowNumInBlock);
+extern int	datumstreamread_skip_rows(DatumStreamRead * datumStream,
+									  int64 lastRowNum);
 extern void datumstreamread_rewind_block(DatumStreamRead * datumStream);
 extern bool datumstreamread_find_block(DatumStreamRead * datumStream,
 						   DatumStreamFetchDesc datumStreamFetchDesc,
 						   int64 rowNum);
 extern void *datumstreamread_get_upgrade_space(DatumStreamRead *datumStream,
 											   size_t len);
+extern void datumstreamread_set_dictionary_keys(DatumStreamRead *datumStream,
+												int nkeys,
+												DatumStreamDictionaryKey *keys);
 
 /*
  * MPP-17061: make sure datumstream_read_block_info was called first for the CO block
@@ -325,4 +399,6 @@ extern void *datumstreamread_get_upgrade_space(DatumStreamRead *datumStream,
 extern void datumstreamread_block_content(DatumStreamRead * acc);
 extern bool init_datumstream_checksum(char *compName, bool checksum);
 
+extern bool gp_aocs_dictionary_encoding;
+
 #endif   /* DATUMSTREAM_H */
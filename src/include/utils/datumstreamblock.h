@@ -33,6 +33,13 @@ typedef enum DatumStreamVersion
 												 * Delta Range done by this
 												 * module. */
 
+	DatumStreamVersion_Dense_Dictionary = 3,	/* Same as Dense_Enhanced, but
+												 * the block may be dictionary
+												 * encoded.  Used by variable-
+												 * length columns of any
+												 * compression type with
+												 * gp_aocs_dictionary_encoding. */
+
 	MaxDatumStreamVersion		/* must always be last */
 }	DatumStreamVersion;
 
@@ -64,6 +71,9 @@ typedef enum DatumStreamVersion
  * |                       |                   +-------------------+              |
  * |                       |                   | Datum + Alignment |              |
  * +-----------------------+-------------------+-------------------+--------------+
+ *
+ * The Datum area of a Dense block of a variable-length type may instead be
+ * dictionary encoded, see DatumStreamBlock_Dictionary.
  */
 
 /*
@@ -197,12 +207,39 @@ typedef struct DatumStreamBlock_Delta_Extension
 }	DatumStreamBlock_Delta_Extension;
 
 
+/*
+ * Datum Stream Block dictionary, at the beginning of the datum area of a
+ * Dense block of a variable-length type with the DSB_HAS_DICTIONARY_ENCODING
+ * flag.  8 bytes.
+ *
+ * It is followed by the dictionary_count distinct values of the block, laid
+ * out like the values of a datum area without dictionary encoding, and then
+ * by one byte per physical datum: the index of its value in the dictionary.
+ */
+typedef struct DatumStreamBlock_Dictionary
+{
+	int32		dictionary_count;
+	/*
+	 * Number of distinct values in the dictionary.
+	 */
+
+	int32		dictionary_size;
+	/*
+	 * Size of the dictionary values, including their alignment
+	 * padding.  The codes follow right after them.
+	 */
+}	DatumStreamBlock_Dictionary;
+
+/* A dictionary code is one byte */
+#define DATUMSTREAM_DICTIONARY_MAX_ENTRIES 256
+
 /* Flags */
 enum
 {
 	DSB_HAS_NULLBITMAP = 0x1,
 	DSB_HAS_RLE_COMPRESSION = 0x2,
 	DSB_HAS_DELTA_COMPRESSION = 0x4,
+	DSB_HAS_DICTIONARY_ENCODING = 0x8,
 };
 
 typedef struct DatumStreamBitMapWrite
@@ -1008,6 +1045,7 @@ typedef struct DatumStreamBlockWrite
 
 	bool		rle_want_compression;
 	bool		delta_want_compression;
+	bool		dict_want_encoding;
 
 	int32		initialMaxDatumPerBlock;
 	int32		maxDatumPerBlock;
@@ -1082,6 +1120,10 @@ typedef struct DatumStreamBlockWrite
 	bool	   *delta_sign;
 	int32		deltas_maxcount;
 
+	/* Dictionary encoding buffer */
+	uint8	   *dict_buffer;
+	int32		dict_buffer_size;
+
 	/* EOF of current file */
 	int64		savings;
 	int64		remember_savings;
@@ -1101,6 +1143,14 @@ typedef struct DatumStreamBlockRead
 	 */
 	DatumStreamVersion datumStreamVersion;
 
+	/*
+	 * Version of the blocks of the column that are not dictionary encoded.
+	 * datumStreamVersion is that of the current block, which is
+	 * DatumStreamVersion_Dense_Dictionary for the blocks written with
+	 * gp_aocs_dictionary_encoding.
+	 */
+	DatumStreamVersion columnDatumStreamVersion;
+
 	/* Common current pointer and null bit-map */
 	int32		nth;			/* CURRENT position of datum in the block,
 								 * including NULLs. */
@@ -1164,6 +1214,21 @@ typedef struct DatumStreamBlockRead
 	bool		delta_block_was_compressed;
 	DatumStreamBitMapRead delta_bitmap;
 
+	/* Dictionary variables */
+	bool		dict_block_was_encoded;
+	int32		dict_count;
+	uint8	  **dict_entries;	/* the dictionary values */
+	uint8	   *dict_codesp;	/* one code per physical datum */
+
+	/*
+	 * Which dictionary values satisfy the dictionary scan keys of the
+	 * reader, see datumstreamread_set_dictionary_keys().  Only valid if
+	 * dict_filter is set.
+	 */
+	bool		dict_filter;
+	bool	   *dict_match;
+	int32		dict_match_count;
+
 	/*
 	 * Keep less frequently accessed fields down here for possible better CPU data cache
 	 * performance.
@@ -1227,7 +1292,8 @@ DatumStreamBlockRead_Get(DatumStreamBlockRead * dsr, Datum *datum, bool *null)
 
 #ifdef USE_ASSERT_CHECKING
 	if ((dsr->datumStreamVersion == DatumStreamVersion_Dense) ||
-		(dsr->datumStreamVersion == DatumStreamVersion_Dense_Enhanced))
+		(dsr->datumStreamVersion == DatumStreamVersion_Dense_Enhanced) ||
+		(dsr->datumStreamVersion == DatumStreamVersion_Dense_Dictionary))
 	{
 		DatumStreamBlockRead_CheckDenseGetInvariant(dsr);
 	}
@@ -1962,7 +2028,13 @@ DatumStreamBlockRead_AdvanceDense(DatumStreamBlockRead * dsr)
 		/*
 		 * Advance the item pointer.
 		 */
-		if (dsr->typeInfo.datumlen == -1)
+		if (dsr->dict_block_was_encoded)
+		{
+			Assert(dsr->physical_datum_index < dsr->physical_datum_count);
+
+			dsr->datump = dsr->dict_entries[dsr->dict_codesp[dsr->physical_datum_index]];
+		}
+		else if (dsr->typeInfo.datumlen == -1)
 		{
 			struct varlena *s;
 
@@ -2051,7 +2123,8 @@ DatumStreamBlockRead_Advance(DatumStreamBlockRead * dsr)
 	else
 	{
 		Assert((dsr->datumStreamVersion == DatumStreamVersion_Dense) ||
-			 (dsr->datumStreamVersion == DatumStreamVersion_Dense_Enhanced));
+			 (dsr->datumStreamVersion == DatumStreamVersion_Dense_Enhanced) ||
+			 (dsr->datumStreamVersion == DatumStreamVersion_Dense_Dictionary));
 		return DatumStreamBlockRead_AdvanceDense(dsr);
 	}
 }
@@ -2089,6 +2162,17 @@ DatumStreamBlockRead_GetReady(
 							  bool *hadToAdjustRowCount,
 							  int32 * adjustedRowCount)
 {
+	/*
+	 * Each block starts with its version, in the Original and the Dense
+	 * formats alike.  Dictionary encoded blocks are Dense, whatever the
+	 * format of the other blocks of the column.
+	 */
+	if (bufferSize >= sizeof(int16) &&
+		*(int16 *) buffer == DatumStreamVersion_Dense_Dictionary)
+		dsr->datumStreamVersion = DatumStreamVersion_Dense_Dictionary;
+	else
+		dsr->datumStreamVersion = dsr->columnDatumStreamVersion;
+
 	if (dsr->datumStreamVersion == DatumStreamVersion_Original)
 	{
 		return DatumStreamBlockRead_GetReadyOrig(
@@ -2103,7 +2187,8 @@ DatumStreamBlockRead_GetReady(
 	else
 	{
 		Assert(dsr->datumStreamVersion == DatumStreamVersion_Dense ||
-			 (dsr->datumStreamVersion == DatumStreamVersion_Dense_Enhanced));
+			 (dsr->datumStreamVersion == DatumStreamVersion_Dense_Enhanced) ||
+			 (dsr->datumStreamVersion == DatumStreamVersion_Dense_Dictionary));
 		return DatumStreamBlockRead_GetReadyDense(
 												  dsr,
 												  buffer,
@@ -2128,7 +2213,8 @@ DatumStreamBlockRead_Reset(DatumStreamBlockRead * dsr)
 	else
 	{
 		Assert(dsr->datumStreamVersion == DatumStreamVersion_Dense ||
-			 (dsr->datumStreamVersion == DatumStreamVersion_Dense_Enhanced));
+			 (dsr->datumStreamVersion == DatumStreamVersion_Dense_Enhanced) ||
+			 (dsr->datumStreamVersion == DatumStreamVersion_Dense_Dictionary));
 		DatumStreamBlockRead_ResetDense(dsr);
 	}
 }
@@ -2152,6 +2238,7 @@ extern void DatumStreamBlockWrite_Init(
 						   DatumStreamVersion datumStreamVersion,
 						   bool rle_want_compression,
 						   bool delta_want_compression,
+						   bool dict_want_encoding,
 						   int32 initialMaxDatumPerBlock,
 						   int32 maxDatumPerBlock,
 						   int32 maxDataBlockSize,
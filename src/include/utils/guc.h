@@ -438,6 +438,7 @@ extern int optimizer_minidump;
 extern int  optimizer_cost_model;
 extern bool optimizer_metadata_caching;
 extern int	optimizer_mdcache_size;
+extern int	optimizer_fallback_cache_size;
 
 /* Optimizer debugging GUCs */
 extern bool optimizer_print_query;
@@ -494,10 +495,14 @@ extern bool optimizer_enable_indexonlyscan;
 extern bool optimizer_enable_tablescan;
 extern bool optimizer_enable_eageragg;
 extern bool optimizer_enable_orderedagg;
+extern bool optimizer_enable_window_topn_pushdown;
+extern bool optimizer_enable_outer_join_elimination;
 extern bool optimizer_expand_fulljoin;
 extern bool optimizer_enable_hashagg;
 extern bool optimizer_enable_groupagg;
 extern bool optimizer_enable_mergejoin;
+extern bool optimizer_enable_full_hash_join;
+extern bool optimizer_enable_semi_join_reduction;
 extern bool optimizer_prune_unused_columns;
 extern bool optimizer_enable_redistribute_nestloop_loj_inner_child;
 extern bool optimizer_force_comprehensive_join_implementation;
@@ -526,11 +531,13 @@ extern int optimizer_penalize_broadcast_threshold;
 extern double optimizer_cost_threshold;
 extern double optimizer_nestloop_factor;
 extern double optimizer_sort_factor;
+extern double optimizer_penalize_skew_mcv_threshold;
 
 /* Optimizer hints */
 extern int optimizer_array_expansion_threshold;
 extern int optimizer_join_order_threshold;
 extern int optimizer_join_order;
+extern int optimizer_join_order_budget;
 extern int optimizer_join_arity_for_associativity_commutativity;
 extern int optimizer_cte_inlining_bound;
 extern int optimizer_push_group_by_below_setop_threshold;
@@ -541,6 +548,7 @@ extern bool optimizer_force_three_stage_scalar_dqa;
 extern bool optimizer_force_expanded_distinct_aggs;
 extern bool optimizer_force_agg_skew_avoidance;
 extern bool optimizer_penalize_skew;
+extern bool optimizer_penalize_skew_mcv;
 extern bool optimizer_prune_computed_columns;
 extern bool optimizer_push_requirements_from_consumer_to_producer;
 extern bool optimizer_enforce_subplans;
@@ -580,6 +588,7 @@ extern bool	optimizer_partition_selection_log;
 #define JOIN_ORDER_GREEDY_SEARCH            1
 #define JOIN_ORDER_EXHAUSTIVE_SEARCH        2
 #define JOIN_ORDER_EXHAUSTIVE2_SEARCH       3
+#define JOIN_ORDER_ADAPTIVE_SEARCH          4
 
 /* Time based authentication GUC */
 extern char  *gp_auth_time_override_str;
@@ -722,6 +731,7 @@ extern void AlterSystemSetConfigFile(AlterSystemStmt *setstmt);
 extern char *GetConfigOptionByName(const char *name, const char **varname);
 extern void GetConfigOptionByNum(int varnum, const char **values, bool *noshow);
 extern int	GetNumConfigOptions(void);
+extern uint64 GetConfigOptionsVersion(void);
 
 extern void SetPGVariable(const char *name, List *args, bool is_local);
 extern void SetPGVariableOptDispatch(const char *name, List *args, bool is_local, bool gp_dispatch);
@@ -14,6 +14,11 @@
 		"explain_memory_verbosity",
 		"gin_fuzzy_search_limit",
 		"gp_allow_date_field_width_5digits",
+		"gp_aocs_batch_scan",
+		"gp_aocs_dictionary_encoding",
+		"gp_aocs_late_materialization",
+		"gp_appendonly_read_ahead",
+		"gp_appendonly_zone_maps",
 		"gp_blockdirectory_entry_min_range",
 		"gp_blockdirectory_minipage_size",
 		"gp_debug_linger",
@@ -22,6 +27,7 @@
 		"gp_disable_tuple_hints",
 		"gp_enable_mk_sort",
 		"gp_enable_motion_mk_sort",
+		"gp_enable_runtime_filter",
 		"gp_enable_segment_copy_checking",
 		"gp_external_enable_filter_pushdown",
 		"gp_gpperfmon_send_interval",
@@ -50,6 +56,8 @@
 		"gp_interconnect_transmit_timeout",
 		"gp_interconnect_type",
 		"gp_interconnect_address_type",
+		"gp_interconnect_batch_syscalls",
+		"gp_interconnect_compression",
 		"gp_log_endpoints",
 		"gp_log_interconnect",
 		"gp_log_resgroup_memory",
@@ -81,6 +89,7 @@
 		"gp_workfile_caching_loglevel",
 		"gp_workfile_compression",
 		"gp_workfile_compression_overhead_limit",
+		"gp_workfile_compression_type",
 		"gp_workfile_limit_files_per_query",
 		"gp_workfile_limit_per_query",
 		"IntervalStyle",
@@ -377,6 +377,8 @@
 		"optimizer_enable_dynamicbitmapscan",
 		"optimizer_enable_eageragg",
 		"optimizer_enable_orderedagg",
+		"optimizer_enable_outer_join_elimination",
+		"optimizer_enable_full_hash_join",
 		"optimizer_enable_gather_on_segment_for_dml",
 		"optimizer_enable_groupagg",
 		"optimizer_enable_hashagg",
@@ -401,6 +403,7 @@
 		"optimizer_enable_partition_propagation",
 		"optimizer_enable_partition_selection",
 		"optimizer_enable_range_predicate_dpe",
+		"optimizer_enable_semi_join_reduction",
 		"optimizer_enable_sort",
 		"optimizer_enable_space_pruning",
 		"optimizer_enable_streaming_material",
@@ -409,17 +412,20 @@
 		"optimizer_force_comprehensive_join_implementation",
 		"optimizer_enable_replicated_table",
 		"optimizer_enable_right_outer_join",
+		"optimizer_enable_window_topn_pushdown",
 		"optimizer_enforce_subplans",
 		"optimizer_enumerate_plans",
 		"optimizer_expand_fulljoin",
 		"optimizer_extract_dxl_stats",
 		"optimizer_extract_dxl_stats_all_nodes",
+		"optimizer_fallback_cache_size",
 		"optimizer_force_agg_skew_avoidance",
 		"optimizer_force_expanded_distinct_aggs",
 		"optimizer_force_multistage_agg",
 		"optimizer_force_three_stage_scalar_dqa",
 		"optimizer_join_arity_for_associativity_commutativity",
 		"optimizer_join_order",
+		"optimizer_join_order_budget",
 		"optimizer_join_order_threshold",
 		"optimizer_log",
 		"optimizer_log_failure",
@@ -430,6 +436,8 @@
 		"optimizer_parallel_union",
 		"optimizer_penalize_broadcast_threshold",
 		"optimizer_penalize_skew",
+		"optimizer_penalize_skew_mcv",
+		"optimizer_penalize_skew_mcv_threshold",
 		"optimizer_print_expression_properties",
 		"optimizer_print_group_properties",
 		"optimizer_print_job_scheduler",
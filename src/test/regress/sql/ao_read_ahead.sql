@@ -0,0 +1,41 @@
+--
+-- Read-ahead of append-optimized segment files
+--
+SET gp_appendonly_read_ahead = 4;
+-- Row-oriented table
+CREATE TABLE ra_ao (a int, c text)
+  WITH (appendonly=true, blocksize=8192) DISTRIBUTED BY (a);
+INSERT INTO ra_ao SELECT i, 'x' || i FROM generate_series(1, 100000) i;
+SELECT count(*), sum(a), sum(length(c)) FROM ra_ao;
+SELECT count(*), sum(a), sum(length(c)) FROM ra_ao WHERE a > 99000;
+-- Column-oriented table
+CREATE TABLE ra_aocs (a int, c text)
+  WITH (appendonly=true, orientation=column, blocksize=8192) DISTRIBUTED BY (a);
+INSERT INTO ra_aocs SELECT i, 'x' || i FROM generate_series(1, 100000) i;
+SELECT count(*), sum(a), sum(length(c)) FROM ra_aocs;
+-- EXPLAIN ANALYZE reports the reads of the scan
+SELECT DISTINCT regexp_replace(line, '^.*(Append-only storage:) \d+ reads, \d+K bytes, I/O wait [0-9.]+ ms, (read-ahead \d+)\.$', '\1 N reads, \2.') AS stats
+  FROM explain_analyze_text('SELECT count(*) FROM ra_aocs') line
+  WHERE line LIKE '%Append-only storage:%';
+-- Fetches through the block directory read a range of the file at a time
+CREATE INDEX ra_ao_a ON ra_ao (a);
+CREATE INDEX ra_aocs_a ON ra_aocs (a);
+SET enable_seqscan = off;
+SELECT c FROM ra_ao WHERE a = 77777;
+SELECT c FROM ra_aocs WHERE a = 77777;
+SELECT count(*) FROM ra_aocs WHERE a BETWEEN 5000 AND 5999;
+RESET enable_seqscan;
+-- Same results without read-ahead
+SET gp_appendonly_read_ahead = 0;
+SELECT count(*), sum(a), sum(length(c)) FROM ra_ao;
+SELECT count(*), sum(a), sum(length(c)) FROM ra_aocs;
+-- The reads are reported without read-ahead, too
+SELECT DISTINCT regexp_replace(line, '^.*(Append-only storage:) \d+ reads, \d+K bytes, I/O wait [0-9.]+ ms, (read-ahead \d+)\.$', '\1 N reads, \2.') AS stats
+  FROM explain_analyze_text('SELECT count(*) FROM ra_ao') line
+  WHERE line LIKE '%Append-only storage:%';
+SELECT DISTINCT regexp_replace(line, '^.*(Append-only storage:) \d+ reads, \d+K bytes, I/O wait [0-9.]+ ms, (read-ahead \d+)\.$', '\1 N reads, \2.') AS stats
+  FROM explain_analyze_text('SELECT count(*) FROM ra_aocs') line
+  WHERE line LIKE '%Append-only storage:%';
+DROP TABLE ra_ao;
+DROP TABLE ra_aocs;
+RESET gp_appendonly_read_ahead;
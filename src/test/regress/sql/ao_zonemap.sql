@@ -0,0 +1,67 @@
+--
+-- Zone maps of append-optimized tables: per-block min/max summaries that
+-- let sequential scans skip the blocks that cannot satisfy the quals.
+--
+SET gp_appendonly_zone_maps = on;
+-- Row-oriented table
+CREATE TABLE zm_ao (a int, b int, c text)
+  WITH (appendonly=true, blocksize=8192) DISTRIBUTED BY (a);
+-- The block directory is created along with the table, and has the
+-- zonemap column
+SELECT count(*) FROM pg_attribute
+  WHERE attrelid = (SELECT blkdirrelid FROM pg_appendonly WHERE relid = 'zm_ao'::regclass)
+  AND attnum > 0;
+INSERT INTO zm_ao SELECT i, i % 100, 'x' FROM generate_series(1, 100000) i;
+INSERT INTO zm_ao SELECT NULL, i, 'y' FROM generate_series(1, 10) i;
+SELECT count(*) FROM zm_ao WHERE a BETWEEN 1000 AND 1999;
+SELECT count(*) FROM zm_ao WHERE a < 10;
+SELECT count(*) FROM zm_ao WHERE 99990 < a;
+SELECT count(*) FROM zm_ao WHERE a = 50000;
+SELECT count(*) FROM zm_ao WHERE b = 5 AND a <= 500;
+SELECT count(*) FROM zm_ao WHERE a IS NULL;
+SELECT count(*) FROM zm_ao WHERE a IS NOT NULL;
+SELECT count(*) FROM zm_ao WHERE a > 100000;
+-- EXPLAIN ANALYZE shows how much the zone maps let the scan skip
+SELECT DISTINCT regexp_replace(line, '^.*(Zone maps skipped) \d+ rows\.$', '\1 N rows.') AS skipped
+  FROM explain_analyze_text('SELECT count(*) FROM zm_ao WHERE a BETWEEN 1000 AND 1999') line
+  WHERE line LIKE '%Zone maps skipped%';
+-- Deleted rows stay invisible
+DELETE FROM zm_ao WHERE a BETWEEN 1000 AND 1499;
+SELECT count(*) FROM zm_ao WHERE a BETWEEN 1000 AND 1999;
+-- Same results without zone maps
+SET gp_appendonly_zone_maps = off;
+SELECT count(*) FROM zm_ao WHERE a BETWEEN 1000 AND 1999;
+SELECT count(*) FROM explain_analyze_text('SELECT count(*) FROM zm_ao WHERE a BETWEEN 1000 AND 1999') line
+  WHERE line LIKE '%Zone maps skipped%';
+SELECT count(*) FROM zm_ao WHERE a IS NULL;
+-- Block directories created while zone maps are off have no zonemap column
+CREATE TABLE zm_ao_off (a int) WITH (appendonly=true) DISTRIBUTED BY (a);
+CREATE INDEX zm_ao_off_a ON zm_ao_off (a);
+SELECT count(*) FROM pg_attribute
+  WHERE attrelid = (SELECT blkdirrelid FROM pg_appendonly WHERE relid = 'zm_ao_off'::regclass)
+  AND attnum > 0;
+DROP TABLE zm_ao_off;
+SET gp_appendonly_zone_maps = on;
+-- Column-oriented table
+CREATE TABLE zm_aocs (a int, b date, c text)
+  WITH (appendonly=true, orientation=column, blocksize=8192) DISTRIBUTED BY (a);
+INSERT INTO zm_aocs SELECT i, date '2020-01-01' + i / 100, 'x' || i FROM generate_series(1, 100000) i;
+SELECT count(*), min(a), max(a) FROM zm_aocs WHERE b = date '2020-01-10';
+SELECT count(*) FROM zm_aocs WHERE a >= 50000 AND a < 50010;
+SELECT DISTINCT regexp_replace(line, '^.*(Zone maps skipped) \d+ rows\.$', '\1 N rows.') AS skipped
+  FROM explain_analyze_text('SELECT count(*) FROM zm_aocs WHERE a >= 50000 AND a < 50010') line
+  WHERE line LIKE '%Zone maps skipped%';
+SELECT sum(a) FROM zm_aocs WHERE a > 99995;
+SELECT c FROM zm_aocs WHERE a = 77777;
+-- A column added later has no zone map
+ALTER TABLE zm_aocs ADD COLUMN d int DEFAULT 7;
+SELECT count(*) FROM zm_aocs WHERE d = 7 AND a < 100;
+INSERT INTO zm_aocs SELECT i, date '2021-01-01', 'z', 8 FROM generate_series(100001, 100100) i;
+SELECT count(*) FROM zm_aocs WHERE d = 8;
+SELECT count(*) FROM zm_aocs WHERE b > date '2020-12-31';
+-- Indexes can be built on tables with zone maps
+CREATE INDEX zm_aocs_a ON zm_aocs (a);
+SELECT count(*) FROM zm_aocs WHERE a BETWEEN 10 AND 19;
+DROP TABLE zm_ao;
+DROP TABLE zm_aocs;
+RESET gp_appendonly_zone_maps;
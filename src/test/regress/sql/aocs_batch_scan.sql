@@ -0,0 +1,61 @@
+--
+-- Batch mode of column-oriented table scans: rows are decoded a batch at a
+-- time, column by column, and simple quals are evaluated over the batch.
+--
+SET gp_aocs_batch_scan = on;
+CREATE TABLE bs_aocs (a int, b int, c text, d numeric)
+  WITH (appendonly=true, orientation=column, blocksize=8192) DISTRIBUTED BY (a);
+INSERT INTO bs_aocs SELECT i, CASE WHEN i % 100 <> 0 THEN i % 1000 END,
+  repeat('x', i % 10) || i, i * 1.5 FROM generate_series(1, 100000) i;
+SELECT count(*) FROM bs_aocs;
+SELECT count(*), sum(a), sum(length(c)), sum(d) FROM bs_aocs WHERE b = 7;
+SELECT count(*), sum(a), sum(length(c)), sum(d) FROM bs_aocs WHERE 7 = b;
+SELECT count(*), sum(a), sum(length(c)), sum(d) FROM bs_aocs WHERE b < 3 AND a > 50000;
+SELECT count(*), sum(a), sum(length(c)), sum(d) FROM bs_aocs WHERE b IS NULL AND a <= 1000;
+SELECT count(*) FROM bs_aocs WHERE b IS NOT NULL;
+SELECT count(*), sum(a), sum(length(c)), sum(d) FROM bs_aocs WHERE c = 'xxxxx12345';
+-- Clauses that are not evaluated in batches
+SELECT count(*), sum(a), sum(length(c)), sum(d) FROM bs_aocs WHERE b + 1 = 8 AND a % 2 = 1;
+SELECT count(*), sum(a), sum(length(c)), sum(d) FROM bs_aocs WHERE b = 7 AND (a < 1000 OR a > 99000);
+-- No row passes the filter
+SELECT count(*), sum(a), sum(length(c)), sum(d) FROM bs_aocs WHERE b > 1000;
+-- Combined with late materialization
+SET gp_aocs_late_materialization = on;
+SELECT count(*), sum(a), sum(length(c)), sum(d) FROM bs_aocs WHERE b = 7;
+SELECT count(*), sum(a), sum(length(c)), sum(d) FROM bs_aocs WHERE b = 7 AND a % 2 = 1;
+SELECT a, c FROM bs_aocs WHERE a % 997 = 0 AND b > 990 ORDER BY a;
+RESET gp_aocs_late_materialization;
+-- Deleted rows stay invisible
+DELETE FROM bs_aocs WHERE b = 7 AND a < 50000;
+SELECT count(*), sum(a), sum(length(c)), sum(d) FROM bs_aocs WHERE b = 7;
+SELECT count(*) FROM bs_aocs;
+-- Values larger than a block
+INSERT INTO bs_aocs SELECT i, i % 1000, repeat('y', 20000 + i % 1000), i FROM generate_series(100001, 100005) i;
+SELECT a, length(c) FROM bs_aocs WHERE a > 100002 ORDER BY a;
+SELECT count(*), sum(length(c)) FROM bs_aocs WHERE b IN (2, 4, 6);
+-- Rescans
+SELECT g, (SELECT c FROM bs_aocs WHERE a = g * 10) FROM generate_series(1, 3) g ORDER BY g;
+-- EXPLAIN ANALYZE shows that the scan ran in batch mode
+SELECT DISTINCT regexp_replace(line, '^.*(Batch mode decoded) \d+ rows\.$', '\1 N rows.') AS batch
+  FROM explain_analyze_text('SELECT count(*) FROM bs_aocs WHERE b = 7') line
+  WHERE line LIKE '%Batch mode decoded%';
+-- Combined with zone maps
+SET gp_appendonly_zone_maps = on;
+CREATE TABLE bs_aocs_zm (a int, b int)
+  WITH (appendonly=true, orientation=column, blocksize=8192) DISTRIBUTED BY (a);
+INSERT INTO bs_aocs_zm SELECT i, i % 1000 FROM generate_series(1, 100000) i;
+SELECT count(*), sum(a) FROM bs_aocs_zm WHERE a BETWEEN 50000 AND 50999 AND b = 7;
+SELECT DISTINCT regexp_replace(line, '^.*(Zone maps skipped|Batch mode decoded) \d+ rows\.$', '\1 N rows.') AS reported
+  FROM explain_analyze_text('SELECT count(*), sum(a) FROM bs_aocs_zm WHERE a BETWEEN 50000 AND 50999 AND b = 7') line
+  WHERE line LIKE '%Zone maps skipped%' OR line LIKE '%Batch mode decoded%'
+  ORDER BY 1;
+DROP TABLE bs_aocs_zm;
+RESET gp_appendonly_zone_maps;
+-- Same results a row at a time
+SET gp_aocs_batch_scan = off;
+SELECT count(*) FROM explain_analyze_text('SELECT count(*) FROM bs_aocs WHERE b = 7') line
+  WHERE line LIKE '%Batch mode decoded%';
+SELECT count(*), sum(a), sum(length(c)), sum(d) FROM bs_aocs WHERE b = 7;
+SELECT count(*) FROM bs_aocs;
+DROP TABLE bs_aocs;
+RESET gp_aocs_batch_scan;
@@ -0,0 +1,86 @@
+--
+-- Dictionary encoding of the low-cardinality variable-length columns of
+-- column-oriented tables, and evaluation of scan quals on the dictionaries.
+--
+SET gp_aocs_dictionary_encoding = on;
+CREATE TABLE dict_aocs (a int, b text, c varchar(10), d text)
+  WITH (appendonly=true, orientation=column, compresstype=rle_type, blocksize=8192)
+  DISTRIBUTED BY (a);
+INSERT INTO dict_aocs SELECT i, 'v' || (i % 5),
+  CASE WHEN i % 7 = 0 THEN NULL ELSE 'c' || (i % 3) END, 'x' || i
+  FROM generate_series(1, 10000) i;
+SELECT count(*) FROM dict_aocs WHERE b = 'v3';
+SELECT count(*) FROM dict_aocs WHERE b IN ('v1', 'v4');
+SELECT count(*) FROM dict_aocs WHERE b > 'v2';
+SELECT count(*) FROM dict_aocs WHERE c = 'c1';
+SELECT count(*) FROM dict_aocs WHERE c IS NULL;
+SELECT count(*) FROM dict_aocs WHERE b = 'v3' AND c = 'c0';
+SELECT count(*) FROM dict_aocs WHERE b = 'none';
+SELECT a, b, c FROM dict_aocs WHERE d = 'x778';
+-- Same results without the dictionaries
+SET gp_aocs_dictionary_encoding = off;
+SELECT count(*) FROM dict_aocs WHERE b = 'v3';
+SELECT count(*) FROM dict_aocs WHERE b IN ('v1', 'v4');
+SELECT count(*) FROM dict_aocs WHERE b > 'v2';
+SELECT count(*) FROM dict_aocs WHERE c = 'c1';
+SELECT count(*) FROM dict_aocs WHERE c IS NULL;
+SELECT count(*) FROM dict_aocs WHERE b = 'v3' AND c = 'c0';
+-- Blocks written without the encoding are read along with encoded ones
+INSERT INTO dict_aocs SELECT i, 'v' || (i % 5), 'c9', 'y' || i
+  FROM generate_series(10001, 11000) i;
+SET gp_aocs_dictionary_encoding = on;
+SELECT count(*) FROM dict_aocs WHERE b = 'v3';
+SELECT count(*) FROM dict_aocs WHERE c IN ('c1', 'c9');
+-- Deleted rows stay invisible
+DELETE FROM dict_aocs WHERE a <= 5000;
+SELECT count(*) FROM dict_aocs WHERE b = 'v3';
+SELECT count(*) FROM dict_aocs WHERE c IN ('c1', 'c9');
+SELECT count(*) FROM dict_aocs WHERE b = 'v3' AND c = 'c0';
+SELECT count(*), sum(a), sum(length(d)) FROM dict_aocs WHERE b > 'v2';
+SELECT a, b, c, d FROM dict_aocs WHERE b = 'v2' AND a % 1000 = 2 ORDER BY a;
+-- Same results in batch mode, and with late materialization as well
+SET gp_aocs_batch_scan = on;
+SELECT count(*) FROM dict_aocs WHERE b = 'v3';
+SELECT count(*) FROM dict_aocs WHERE c IN ('c1', 'c9');
+SELECT count(*) FROM dict_aocs WHERE b = 'v3' AND c = 'c0';
+SELECT count(*), sum(a), sum(length(d)) FROM dict_aocs WHERE b > 'v2';
+SELECT a, b, c, d FROM dict_aocs WHERE b = 'v2' AND a % 1000 = 2 ORDER BY a;
+SET gp_aocs_late_materialization = on;
+SELECT count(*) FROM dict_aocs WHERE b = 'v3';
+SELECT count(*) FROM dict_aocs WHERE c IN ('c1', 'c9');
+SELECT count(*) FROM dict_aocs WHERE b = 'v3' AND c = 'c0';
+SELECT count(*), sum(a), sum(length(d)) FROM dict_aocs WHERE b > 'v2';
+SELECT a, b, c, d FROM dict_aocs WHERE b = 'v2' AND a % 1000 = 2 ORDER BY a;
+RESET gp_aocs_late_materialization;
+RESET gp_aocs_batch_scan;
+DROP TABLE dict_aocs;
+-- Columns with a generic compression type are encoded as well, and the
+-- blocks they already have are read along with the encoded ones
+CREATE TABLE dict_zlib (a int, b text)
+  WITH (appendonly=true, orientation=column, compresstype=zlib, blocksize=8192)
+  DISTRIBUTED BY (a);
+SET gp_aocs_dictionary_encoding = off;
+INSERT INTO dict_zlib SELECT i, 'v' || (i % 5) FROM generate_series(1, 5000) i;
+SET gp_aocs_dictionary_encoding = on;
+INSERT INTO dict_zlib SELECT i, 'v' || (i % 5) FROM generate_series(5001, 10000) i;
+SELECT count(*) FROM dict_zlib WHERE b = 'v3';
+SELECT count(*), sum(a) FROM dict_zlib WHERE b IN ('v1', 'v4');
+SET gp_aocs_dictionary_encoding = off;
+SELECT count(*) FROM dict_zlib WHERE b = 'v3';
+DROP TABLE dict_zlib;
+SET gp_aocs_dictionary_encoding = on;
+-- The encoded blocks are smaller than the plain ones
+CREATE TABLE dict_plain (a int, b text)
+  WITH (appendonly=true, orientation=column, compresstype=rle_type, blocksize=8192)
+  DISTRIBUTED BY (a);
+CREATE TABLE dict_encoded (a int, b text)
+  WITH (appendonly=true, orientation=column, compresstype=rle_type, blocksize=8192)
+  DISTRIBUTED BY (a);
+SET gp_aocs_dictionary_encoding = off;
+INSERT INTO dict_plain SELECT i, 'status value ' || (i % 5) FROM generate_series(1, 10000) i;
+SET gp_aocs_dictionary_encoding = on;
+INSERT INTO dict_encoded SELECT * FROM dict_plain;
+SELECT pg_relation_size('dict_encoded') * 2 < pg_relation_size('dict_plain') AS smaller;
+DROP TABLE dict_plain;
+DROP TABLE dict_encoded;
+RESET gp_aocs_dictionary_encoding;
@@ -0,0 +1,41 @@
+--
+-- Late materialization of column-oriented table scans: the filter is
+-- evaluated on the columns it references before the rest are read.
+--
+SET gp_aocs_late_materialization = on;
+CREATE TABLE lm_aocs (a int, b int, c text, d numeric)
+  WITH (appendonly=true, orientation=column, blocksize=8192) DISTRIBUTED BY (a);
+INSERT INTO lm_aocs SELECT i, i % 1000, repeat('x', i % 10) || i, i * 1.5
+  FROM generate_series(1, 100000) i;
+SELECT count(*), sum(a), sum(length(c)), sum(d) FROM lm_aocs WHERE b = 7;
+SELECT a, b, c, d FROM lm_aocs WHERE a IN (5, 50005, 99999) ORDER BY a;
+-- The blocks of c and d between the rows that pass are not read
+SELECT DISTINCT regexp_replace(line, '^.*(Late materialization skipped) \d+ (column blocks)\.$', '\1 N \2.') AS skipped
+  FROM explain_analyze_text('SELECT sum(length(c)), sum(d) FROM lm_aocs WHERE a IN (5, 50005, 99999)') line
+  WHERE line LIKE '%Late materialization skipped%';
+SELECT count(*), sum(d) FROM lm_aocs WHERE b < 10 AND a > 99000;
+SELECT a, c FROM lm_aocs WHERE a % 997 = 0 AND b > 990 ORDER BY a;
+-- The filter references all the columns the scan needs
+SELECT count(*) FROM lm_aocs WHERE b = 3;
+-- No row passes the filter
+SELECT count(*), sum(length(c)) FROM lm_aocs WHERE b > 1000;
+-- Deleted rows stay invisible
+DELETE FROM lm_aocs WHERE b = 7 AND a < 50000;
+SELECT count(*), sum(a), sum(length(c)), sum(d) FROM lm_aocs WHERE b = 7;
+-- Values larger than a block
+INSERT INTO lm_aocs SELECT i, i % 1000, repeat('y', 20000 + i % 1000), i FROM generate_series(100001, 100005) i;
+SELECT a, length(c) FROM lm_aocs WHERE a > 100002 ORDER BY a;
+SELECT count(*), sum(length(c)) FROM lm_aocs WHERE b IN (2, 4, 6);
+-- A column added later
+ALTER TABLE lm_aocs ADD COLUMN e int DEFAULT 3;
+SELECT count(*), sum(e) FROM lm_aocs WHERE b = 8;
+-- Rescans
+SELECT g, (SELECT c FROM lm_aocs WHERE a = g * 10) FROM generate_series(1, 3) g ORDER BY g;
+-- Same results without late materialization
+SET gp_aocs_late_materialization = off;
+SELECT count(*), sum(a), sum(length(c)), sum(d) FROM lm_aocs WHERE b = 7;
+SELECT count(*), sum(length(c)) FROM lm_aocs WHERE b IN (2, 4, 6);
+SELECT count(*) FROM explain_analyze_text('SELECT sum(length(c)), sum(d) FROM lm_aocs WHERE a IN (5, 50005, 99999)') line
+  WHERE line LIKE '%Late materialization skipped%';
+DROP TABLE lm_aocs;
+RESET gp_aocs_late_materialization;
@@ -0,0 +1,36 @@
+--
+-- HELPER FUNCTIONS FOR TESTS THAT CHECK EXPLAIN OUTPUT.
+--
+-- They return the EXPLAIN or EXPLAIN ANALYZE output of a query as a normal
+-- result set, so that a test can pick the lines it is interested in, and
+-- mask the numbers that vary from run to run.
+--
+
+-- start_ignore
+drop function if exists explain_text(text);
+drop function if exists explain_analyze_text(text);
+-- end_ignore
+
+create function explain_text(explain_query text) returns setof text as
+$$
+declare
+  explainrow text;
+begin
+  for explainrow in execute 'EXPLAIN ' || explain_query
+  loop
+    return next explainrow;
+  end loop;
+end;
+$$ language plpgsql;
+
+create function explain_analyze_text(explain_query text) returns setof text as
+$$
+declare
+  explainrow text;
+begin
+  for explainrow in execute 'EXPLAIN ANALYZE ' || explain_query
+  loop
+    return next explainrow;
+  end loop;
+end;
+$$ language plpgsql;
@@ -3733,6 +3733,142 @@ UPDATE d SET с2 = 2 WHERE с1 = 1;
 DROP TABLE d;
 DROP FUNCTION trig_proc();
 
+-- Windows followed by a row_number()/rank() top-N filter are pre-filtered on
+-- each segment
+create table orca.topn_window (k int, t int) distributed by (t);
+insert into orca.topn_window select i % 10, i from generate_series(1, 1000) i;
+analyze orca.topn_window;
+
+set optimizer_enable_window_topn_pushdown = on;
+select k, t, rn from (select k, t, row_number() over (partition by k order by t desc) rn from orca.topn_window) s where rn <= 2 order by k, t;
+select k, count(*) from (select k, rank() over (partition by k order by t / 100) r from orca.topn_window) s where r < 2 group by k order by k;
+select t from (select t, row_number() over (order by t) rn from orca.topn_window) s where rn <= 3 order by t;
+-- The local filter is a second window below the redistribution
+select count(*) from explain_text($$select k, t, rn from (select k, t, row_number() over (partition by k order by t desc) rn from orca.topn_window) s where rn <= 2$$) et where et like '%WindowAgg%';
+-- Other window functions must see all rows of the window, so the rewrite
+-- does not apply when they are computed along with row_number() or rank()
+select k, t, rn, total from (select k, t, row_number() over w rn, sum(t) over w total from orca.topn_window window w as (partition by k order by t desc)) s where rn <= 2 order by k, t;
+select count(*) from explain_text($$select k, t, rn, total from (select k, t, row_number() over w rn, sum(t) over w total from orca.topn_window window w as (partition by k order by t desc)) s where rn <= 2$$) et where et like '%WindowAgg%';
+select k, t, r, c from (select k, t, rank() over (partition by k order by t desc) r, count(*) over (partition by k) c from orca.topn_window) s where r <= 1 order by k;
+reset optimizer_enable_window_topn_pushdown;
+
+-- Left outer joins on a unique key of the inner side are removed when none of
+-- the inner side's columns are used
+create table orca.lje_fact (id int, dim_id int, v int) distributed by (id);
+create table orca.lje_dim (dim_id int primary key, name text) distributed by (dim_id);
+insert into orca.lje_dim select i, 'd' || i from generate_series(1, 10) i;
+insert into orca.lje_fact select i, i % 12, i from generate_series(1, 100) i;
+analyze orca.lje_fact;
+analyze orca.lje_dim;
+
+set optimizer_enable_outer_join_elimination = on;
+select count(*), sum(v) from orca.lje_fact f left join orca.lje_dim d on f.dim_id = d.dim_id;
+select count(d.name) from orca.lje_fact f left join orca.lje_dim d on f.dim_id = d.dim_id;
+select count(*) from orca.lje_fact f left join orca.lje_fact f2 on f.dim_id = f2.dim_id;
+-- The inner side is not scanned when the join is removed
+select count(*) from explain_text($$select count(*), sum(v) from orca.lje_fact f left join orca.lje_dim d on f.dim_id = d.dim_id$$) et where et like '%Scan on lje_dim%';
+-- The join stays when an inner column is used, or the inner side is not
+-- unique on the join key
+select count(*) from explain_text($$select count(d.name) from orca.lje_fact f left join orca.lje_dim d on f.dim_id = d.dim_id$$) et where et like '%Scan on lje_dim%';
+select count(*) from explain_text($$select count(*) from orca.lje_fact f left join orca.lje_fact f2 on f.dim_id = f2.dim_id$$) et where et like '%Scan on lje_fact%';
+reset optimizer_enable_outer_join_elimination;
+
+-- Full outer joins can be implemented as a hash join when both sides are
+-- co-located on the join keys
+create table orca.fhj_a (a int, b int) distributed by (a);
+create table orca.fhj_b (c int, d int) distributed by (d);
+create table orca.fhj_r (c int, d int) distributed replicated;
+insert into orca.fhj_a select i, i % 7 from generate_series(1, 20) i;
+insert into orca.fhj_a values (null, null);
+insert into orca.fhj_b select i + 10, i from generate_series(1, 15) i;
+insert into orca.fhj_b values (null, 1);
+insert into orca.fhj_r select * from orca.fhj_b;
+analyze orca.fhj_a;
+analyze orca.fhj_b;
+analyze orca.fhj_r;
+
+set optimizer_enable_full_hash_join = on;
+set optimizer_enable_mergejoin = off;
+select count(*), count(a), count(c) from orca.fhj_a full join orca.fhj_b on a = c;
+select count(*), count(a), count(c) from orca.fhj_a full join orca.fhj_b on a = c and b < 3;
+select count(*), count(a), count(c) from orca.fhj_a full join orca.fhj_r on a = c;
+select a, c from orca.fhj_a full join orca.fhj_b on a = c where a > 18 or c > 23 order by a, c;
+-- Show the hash full join
+select count(*) from explain_text($$select count(*) from orca.fhj_a full join orca.fhj_b on a = c$$) et where et like '%Hash Full Join%';
+-- A join clause that is not hashable cannot use a hash full join
+select count(*), count(a), count(c) from orca.fhj_a full join orca.fhj_b on a::text::tsvector = c::text::tsvector;
+select count(*) from explain_text($$select count(*) from orca.fhj_a full join orca.fhj_b on a::text::tsvector = c::text::tsvector$$) et where et like '%Hash Full Join%';
+reset optimizer_enable_mergejoin;
+reset optimizer_enable_full_hash_join;
+
+-- Statements that fell back are planned by the Postgres planner right away
+-- when they come again, unless the optimizer settings have changed
+create table orca.fbc (a int, b int) distributed by (a);
+insert into orca.fbc select i, i % 3 from generate_series(1, 10) i;
+analyze orca.fbc;
+
+set optimizer_fallback_cache_size = 100;
+select sum(distinct a), count(distinct b) from orca.fbc;
+select sum(distinct a), count(distinct b) from orca.fbc;
+select gp_opt_fallback_cache_stats();
+set optimizer_enable_multiple_distinct_aggs = on;
+select sum(distinct a), count(distinct b) from orca.fbc;
+select gp_opt_fallback_cache_stats();
+reset optimizer_enable_multiple_distinct_aggs;
+select sum(distinct a), count(distinct b) from orca.fbc;
+select gp_opt_fallback_cache_stats();
+reset optimizer_fallback_cache_size;
+
+-- The larger side of a join can be reduced by a semi join with the distinct
+-- join keys of the smaller side
+create table orca.sjr_big (a int, b int) distributed by (b);
+create table orca.sjr_small (c int, d int) distributed by (d);
+insert into orca.sjr_big select i % 100, i from generate_series(1, 1000) i;
+insert into orca.sjr_small select i * 3, i from generate_series(1, 10) i;
+analyze orca.sjr_big;
+analyze orca.sjr_small;
+
+set optimizer_enable_semi_join_reduction = on;
+select count(*), sum(a), sum(c) from orca.sjr_big join orca.sjr_small on a = c;
+select count(*) from orca.sjr_small join orca.sjr_big on c = a and b % 10 < d;
+select b, c, d from orca.sjr_big, orca.sjr_small where a = c and b > 900 order by b;
+-- When only a handful of rows may be broadcast, the distinct join keys of
+-- the smaller side are broadcast to reduce the larger side instead; the
+-- reduced side is joined with the smaller side, which is read from a
+-- shared scan
+create table orca.sjr_large (a int, b int) distributed by (b);
+create table orca.sjr_few (c int, d int) distributed by (d);
+insert into orca.sjr_large select i % 1000, i from generate_series(1, 50000) i;
+insert into orca.sjr_few select (i % 5) * 7, i from generate_series(1, 200) i;
+analyze orca.sjr_large;
+analyze orca.sjr_few;
+set optimizer_penalize_broadcast_threshold = 50;
+select count(*) from orca.sjr_large join orca.sjr_few on a = c;
+select count(*) > 0 as reduced from explain_text($$select count(*) from orca.sjr_large join orca.sjr_few on a = c$$) et where et like '%Shared Scan%';
+-- Both sides have the same size, nothing to reduce
+select count(*) > 0 as reduced from explain_text($$select count(*) from orca.sjr_small s1 join orca.sjr_small s2 on s1.c = s2.d$$) et where et like '%Shared Scan%';
+reset optimizer_penalize_broadcast_threshold;
+reset optimizer_enable_semi_join_reduction;
+
+-- Adaptive join ordering picks the join order enumeration from the shape
+-- of the join graph; a low threshold forces the linearized search
+set optimizer_join_order = adaptive;
+select count(*), sum(b1.b), sum(b2.b) from orca.sjr_small s1, orca.sjr_big b1, orca.sjr_small s2, orca.sjr_big b2
+  where s1.c = b1.a and b1.a = s2.c and s2.c = b2.a;
+set optimizer_join_order_threshold = 2;
+select count(*), sum(b1.b), sum(b2.b) from orca.sjr_small s1, orca.sjr_big b1, orca.sjr_small s2, orca.sjr_big b2
+  where s1.c = b1.a and b1.a = s2.c and s2.c = b2.a;
+reset optimizer_join_order_threshold;
+-- A join graph whose only edge is a predicate on three tables needs a
+-- cross product of two of them, which the search must not skip
+select count(*) from orca.sjr_small s1, orca.sjr_small s2, orca.sjr_big b where s1.c + s2.c = b.a;
+select count(*) from explain_text($$select count(*) from orca.sjr_small s1, orca.sjr_small s2, orca.sjr_big b where s1.c + s2.c = b.a$$) et where et like '%Pivotal Optimizer%';
+reset optimizer_join_order;
+
+-- The metadata cache statistics count the relations GPORCA looked up while
+-- planning the queries above
+select substring(gp_opt_mdcache_stats() from '^relation: hits=\d+, misses=(\d+)')::bigint > 0 as relation_misses;
+
 reset optimizer_trace_fallback;
 
 -- start_ignore
@@ -0,0 +1,29 @@
+-- 
+-- @description Interconnect test case: several packets per sendmmsg()/recvmmsg() call
+-- @created 2026-10-19
+-- @modified 2026-10-19
+-- @tags executor
+-- @gpdb_version [6.0.0,main]
+
+-- Create a table
+CREATE TEMP TABLE batch_table(dkey INT, jkey INT, tval TEXT) DISTRIBUTED BY (dkey);
+-- Generate enough data for the motions to send many packets per connection
+INSERT INTO batch_table SELECT i, i % 1000, repeat('x', 100) || i FROM generate_series(1, 50000) i;
+
+-- One system call per packet
+SET gp_interconnect_batch_syscalls = off;
+SHOW gp_interconnect_batch_syscalls;
+-- Redistribute or broadcast motion
+SELECT COUNT(*), SUM(length(a.tval)) FROM batch_table a JOIN batch_table b ON a.jkey = b.dkey;
+-- Gather motion
+SELECT COUNT(*), SUM(length(tval)) FROM (SELECT tval FROM batch_table OFFSET 0) foo;
+
+-- Several packets per system call
+SET gp_interconnect_batch_syscalls = on;
+SHOW gp_interconnect_batch_syscalls;
+-- Redistribute or broadcast motion
+SELECT COUNT(*), SUM(length(a.tval)) FROM batch_table a JOIN batch_table b ON a.jkey = b.dkey;
+-- Gather motion
+SELECT COUNT(*), SUM(length(tval)) FROM (SELECT tval FROM batch_table OFFSET 0) foo;
+
+RESET gp_interconnect_batch_syscalls;
@@ -0,0 +1,35 @@
+-- 
+-- @description Interconnect test case: LZ4 compression of data packets
+-- @created 2026-10-19
+-- @modified 2026-10-19
+-- @tags executor
+-- @gpdb_version [6.0.0,main]
+
+-- If the server is built without LZ4 (configure --without-lz4), enabling
+-- compression fails with an error. The packets are then sent uncompressed,
+-- and the queries still give the same results, so ignore that error.
+--
+-- start_matchignore
+-- m/ERROR:  interconnect compression is not supported by this build/
+-- end_matchignore
+
+SET gp_interconnect_compression = on;
+
+-- Compressible rows: the packets are sent compressed
+CREATE TEMP TABLE comp_table(dkey INT, jkey INT, tval TEXT) DISTRIBUTED BY (dkey);
+INSERT INTO comp_table SELECT i, i % 1000, repeat('abcdefgh', 20) || i FROM generate_series(1, 50000) i;
+-- Redistribute or broadcast motion
+SELECT COUNT(*), SUM(length(a.tval)) FROM comp_table a JOIN comp_table b ON a.jkey = b.dkey;
+-- Gather motion, and the rows arrive intact
+SELECT COUNT(*), SUM(length(tval)) FROM (SELECT tval FROM comp_table OFFSET 0) foo;
+SELECT COUNT(*) FROM (SELECT dkey, tval FROM comp_table OFFSET 0) foo
+  WHERE tval <> repeat('abcdefgh', 20) || dkey;
+-- Rows that hardly compress: most packets are sent as they are
+CREATE TEMP TABLE rand_table(dkey INT, jkey INT, tval TEXT) DISTRIBUTED BY (dkey);
+INSERT INTO rand_table SELECT i, i % 1000,
+  md5(i::text) || md5((i * 7)::text) || md5((i * 13)::text) || md5((i * 31)::text)
+  FROM generate_series(1, 50000) i;
+SELECT COUNT(*), SUM(length(a.tval)) FROM rand_table a JOIN rand_table b ON a.jkey = b.dkey;
+SELECT COUNT(*) FROM (SELECT dkey, tval FROM rand_table OFFSET 0) foo
+  WHERE tval <> md5(dkey::text) || md5((dkey * 7)::text) || md5((dkey * 13)::text) || md5((dkey * 31)::text);
+RESET gp_interconnect_compression;
@@ -883,3 +883,25 @@ select * from tbl1 join tbl2 using (b);
 
 drop table tbl1;
 drop table tbl2;
+
+-- Check that the hash join Bloom filter only discards outer rows that
+-- cannot find a match
+create table rf_fact (a int, b int) distributed by (a);
+create table rf_dim (a int, b int) distributed by (a);
+insert into rf_fact select i, i % 100 from generate_series(1, 10000) i;
+insert into rf_dim select i, i from generate_series(1, 10) i;
+analyze rf_fact;
+analyze rf_dim;
+set gp_enable_runtime_filter = on;
+select count(*) from rf_fact join rf_dim on rf_fact.b = rf_dim.b;
+select count(*) from rf_fact where b in (select b from rf_dim);
+select count(*) from rf_fact left join rf_dim on rf_fact.b = rf_dim.b;
+-- EXPLAIN ANALYZE reports the outer rows that the filter rejected
+select distinct regexp_replace(et, '^.*(Bloom filter rejected) \d+ (outer rows\.)$', '\1 N \2') as bloom
+  from explain_analyze_text('select count(*) from rf_fact join rf_dim on rf_fact.b = rf_dim.b') et
+  where et like '%Bloom filter rejected%';
+select count(*) from explain_analyze_text('select count(*) from rf_fact left join rf_dim on rf_fact.b = rf_dim.b') et
+  where et like '%Bloom filter rejected%';
+reset gp_enable_runtime_filter;
+drop table rf_fact;
+drop table rf_dim;
@@ -238,6 +238,63 @@ EXPLAIN SELECT
 
 reset optimizer_skew_factor;
 
+-- A few hot keys holding a large share of the rows, with plenty of NDVs
+-- overall, are only caught by looking at the most common values
+CREATE TABLE skew_mcv_fact (user_id integer, v integer) DISTRIBUTED RANDOMLY;
+CREATE TABLE skew_mcv_dim (user_id integer, name text) DISTRIBUTED RANDOMLY;
+
+INSERT INTO skew_mcv_fact
+  SELECT CASE WHEN i % 10 < 9 THEN 1 ELSE i END, i
+  FROM generate_series(1, 10000) i;
+INSERT INTO skew_mcv_dim SELECT i, 'u' || i FROM generate_series(1, 5000) i;
+
+ANALYZE skew_mcv_fact;
+ANALYZE skew_mcv_dim;
+
+-- Redistributing both sides on user_id looks cheapest until the hot key
+-- is taken into account, then the smaller side is broadcast instead
+SELECT substring(et from '(Redistribute|Broadcast) Motion') AS motion, count(*)
+  FROM explain_text('SELECT count(*) FROM skew_mcv_fact f JOIN skew_mcv_dim d ON f.user_id = d.user_id') et
+  WHERE et ~ '(Redistribute|Broadcast) Motion' GROUP BY 1 ORDER BY 1;
+set optimizer_penalize_skew_mcv = on;
+SELECT substring(et from '(Redistribute|Broadcast) Motion') AS motion, count(*)
+  FROM explain_text('SELECT count(*) FROM skew_mcv_fact f JOIN skew_mcv_dim d ON f.user_id = d.user_id') et
+  WHERE et ~ '(Redistribute|Broadcast) Motion' GROUP BY 1 ORDER BY 1;
+SELECT count(*) FROM skew_mcv_fact f JOIN skew_mcv_dim d ON f.user_id = d.user_id;
+
+reset optimizer_penalize_skew_mcv;
+
+-- Near the threshold: the hot key holds 31% of the rows of skew_mcv_above,
+-- and 29% of those of skew_mcv_below. Only the first one is penalized,
+-- which shows in a higher cost of the plan.
+CREATE TABLE skew_mcv_above (user_id integer, v integer) DISTRIBUTED RANDOMLY;
+CREATE TABLE skew_mcv_below (user_id integer, v integer) DISTRIBUTED RANDOMLY;
+
+INSERT INTO skew_mcv_above
+  SELECT CASE WHEN i % 100 < 31 THEN 1 ELSE i END, i
+  FROM generate_series(1, 10000) i;
+INSERT INTO skew_mcv_below
+  SELECT CASE WHEN i % 100 < 29 THEN 1 ELSE i END, i
+  FROM generate_series(1, 10000) i;
+
+ANALYZE skew_mcv_above;
+ANALYZE skew_mcv_below;
+
+SELECT substring(et from 'cost=[0-9.]+\.\.([0-9.]+)') AS above_cost
+  FROM explain_text('SELECT count(*) FROM skew_mcv_above f JOIN skew_mcv_dim d ON f.user_id = d.user_id') et LIMIT 1 \gset
+SELECT substring(et from 'cost=[0-9.]+\.\.([0-9.]+)') AS below_cost
+  FROM explain_text('SELECT count(*) FROM skew_mcv_below f JOIN skew_mcv_dim d ON f.user_id = d.user_id') et LIMIT 1 \gset
+
+set optimizer_penalize_skew_mcv = on;
+set optimizer_penalize_skew_mcv_threshold = 0.3;
+SELECT substring(et from 'cost=[0-9.]+\.\.([0-9.]+)')::float8 > :above_cost AS penalized
+  FROM explain_text('SELECT count(*) FROM skew_mcv_above f JOIN skew_mcv_dim d ON f.user_id = d.user_id') et LIMIT 1;
+SELECT substring(et from 'cost=[0-9.]+\.\.([0-9.]+)')::float8 > :below_cost AS penalized
+  FROM explain_text('SELECT count(*) FROM skew_mcv_below f JOIN skew_mcv_dim d ON f.user_id = d.user_id') et LIMIT 1;
+
+reset optimizer_penalize_skew_mcv_threshold;
+reset optimizer_penalize_skew_mcv;
+
 -- start_ignore
 DROP SCHEMA orca_skew CASCADE;
 -- end_ignore
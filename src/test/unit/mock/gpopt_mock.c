@@ -25,6 +25,13 @@ LibraryVersion(void)
 	return NULL;
 }
 
+Datum
+MDCacheStats(void)
+{
+	elog(ERROR, "mock implementation of MDCacheStats called");
+	return (Datum) 0;
+}
+
 Datum
 EnableXform(PG_FUNCTION_ARGS)
 {